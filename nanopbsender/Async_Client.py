@@ -0,0 +1,196 @@
+import asyncio
+import concurrent.futures
+import threading
+import message_pb2
+import serial
+from Frame_Codec import *
+from Wire_Templates import *
+
+# Requests waiting for their reply at once. More than the firmware frame queue
+# (PROTOBUFF_FRAME_QUEUE_DEPTH) is fine, the rest waits in its Rx queue and the link stays busy.
+ASYNC_REQUEST_WINDOW = 16
+ASYNC_REQUEST_TIMEOUT = 1.0
+# Bytes queued for the writer before a sender waits for it
+ASYNC_TX_HIGH_WATER = 4096
+# Longest a read blocks the reader thread, bounds the time close() takes
+ASYNC_READ_TIMEOUT = 0.05
+ASYNC_SEQ_MASK = 0xFFFF
+
+class Async_Client:
+    # Pipelined client for asyncio. Requests are sequenced frames, a reader task hands each reply to
+    # the future of the request with the same sequence number, and a writer task sends everything
+    # queued since its last write in one write() call. The port is only touched from one thread per
+    # direction, so any event loop and any pyserial port type work.
+    #
+    #     async with Async_Client('COM9') as board:
+    #         await board.set_pin(GPIOA, PIN0)
+    #         values = await board.read_pins([(GPIOB, Pin) for Pin in range(8)])
+    def __init__(self, port, baudrate=SERIAL_BAUD_RATE, cobs=True, crc=True,
+                 window=ASYNC_REQUEST_WINDOW, timeout=ASYNC_REQUEST_TIMEOUT):
+        self.port = port
+        self.baudrate = baudrate
+        self.cobs = cobs
+        self.crc = cobs and crc
+        self.window_size = window
+        self.timeout = timeout
+        self.parser = Frame_Parser(self.cobs, self.crc)
+        self.next_seq = 0
+        self.pending = {}
+        self.tx = bytearray()
+        # Statistics: write() calls, replies nobody waited for (late or unknown sequence number)
+        self.writes = 0
+        self.stale = 0
+
+    async def open(self):
+        self.ser = serial.Serial(self.port, self.baudrate, timeout=ASYNC_READ_TIMEOUT)
+        self.ser.reset_input_buffer()
+        self.rx_thread = concurrent.futures.ThreadPoolExecutor(1, "serial-rx")
+        self.tx_thread = concurrent.futures.ThreadPoolExecutor(1, "serial-tx")
+        self.window = asyncio.Semaphore(self.window_size)
+        self.tx_ready = asyncio.Event()
+        self.tx_space = asyncio.Event()
+        self.closing = False
+        self.reader = asyncio.create_task(self._read_loop())
+        self.writer = asyncio.create_task(self._write_loop())
+        return self
+
+    async def close(self):
+        # Sends what is queued, stops both tasks and fails the requests still waiting
+        self.closing = True
+        self.tx_ready.set()
+        await self.writer
+        await self.reader
+        for future in self.pending.values():
+            if not future.done():
+                future.set_exception(ConnectionError("client closed"))
+        self.rx_thread.shutdown()
+        self.tx_thread.shutdown()
+        self.ser.close()
+
+    async def __aenter__(self):
+        return await self.open()
+
+    async def __aexit__(self, *exc):
+        await self.close()
+
+    def _read_chunk(self):
+        # Waits up to ASYNC_READ_TIMEOUT for a byte, then takes everything already received
+        data = self.ser.read(1)
+        if data and self.ser.in_waiting:
+            data += self.ser.read(self.ser.in_waiting)
+        return data
+
+    async def _read_loop(self):
+        loop = asyncio.get_running_loop()
+        while not self.closing:
+            data = await loop.run_in_executor(self.rx_thread, self._read_chunk)
+            for msg_id, seq, body in self.parser.feed(data):
+                future = self.pending.pop(seq, None)
+                if future is None or future.done():
+                    self.stale += 1
+                else:
+                    future.set_result((msg_id, body))
+
+    async def _write_loop(self):
+        loop = asyncio.get_running_loop()
+        while not (self.closing and not self.tx):
+            await self.tx_ready.wait()
+            self.tx_ready.clear()
+            if self.tx:
+                # Frames queued while the previous write was in progress go out together
+                data = bytes(self.tx)
+                self.tx.clear()
+                self.tx_space.set()
+                await loop.run_in_executor(self.tx_thread, self.ser.write, data)
+                self.writes += 1
+
+    async def send(self, msg_id, serialized_body, seq=0):
+        # Queues a frame for the writer, returns once it is queued
+        while len(self.tx) >= ASYNC_TX_HIGH_WATER:
+            self.tx_space.clear()
+            await self.tx_space.wait()
+        if seq == 0:
+            self.tx += build_frame_cached(msg_id, serialized_body, seq, FRAMING_SEQUENCED, self.cobs, self.crc)
+        else:
+            self.tx += build_frame(msg_id, serialized_body, seq, FRAMING_SEQUENCED, self.cobs, self.crc)
+        self.tx_ready.set()
+
+    async def request(self, msg_id, serialized_body):
+        # Sends a request once the window has room, returns (msg_id, serialized_body) of its reply.
+        # Raises asyncio.TimeoutError without a reply after the timeout
+        async with self.window:
+            seq = self.next_seq
+            self.next_seq = (seq + 1) & ASYNC_SEQ_MASK
+            future = asyncio.get_running_loop().create_future()
+            self.pending[seq] = future
+            try:
+                await self.send(msg_id, serialized_body, seq)
+                return await asyncio.wait_for(future, self.timeout)
+            finally:
+                self.pending.pop(seq, None)
+
+    async def set_pin(self, Port, PinNum):
+        await self.send(Service_Set_Pin, encode_Msg_SetPin(Port, PinNum))
+
+    async def reset_pin(self, Port, PinNum):
+        await self.send(Service_Reset_Pin, encode_Msg_ResetPin(Port, PinNum))
+
+    async def toggle_pin(self, Port, PinNum):
+        await self.send(Service_Toggle_Pin, encode_Msg_TogglePin(Port, PinNum))
+
+    async def read_pin(self, Port, PinNum):
+        msg_id, PinValueBuffer = await self.request(
+            Service_Read_Pin, encode_Msg_ReadPin(Port, PinNum))
+        PinValueMsg = message_pb2.Msg_PinValue()
+        PinValueMsg.ParseFromString(PinValueBuffer)
+        return PinValueMsg.Pin_Read
+
+    async def read_pins(self, Pins):
+        # Pins is a list of (Port, PinNum), all read concurrently, values returned in the same order
+        return await asyncio.gather(*(self.read_pin(Port, PinNum) for Port, PinNum in Pins))
+
+    async def write_port(self, Port, SetMask, ResetMask):
+        await self.send(Service_Write_Port, encode_Msg_WritePort(Port, SetMask, ResetMask))
+
+    async def read_port(self, Port):
+        msg_id, PortValueBuffer = await self.request(Service_Read_Port, encode_Msg_ReadPort(Port))
+        PortValueMsg = message_pb2.Msg_PortValue()
+        PortValueMsg.ParseFromString(PortValueBuffer)
+        return PortValueMsg.Value
+
+    async def batch(self, Ops):
+        # Ops is a list of (Service, Port, PinNum) run in order in one frame, returns the Read_Pin
+        # results as a list of (Port, PinNum, Value). Same size limits as Request_Batch.
+        Batch_Msg = message_pb2.Msg_Batch()
+        for Service, Port, PinNum in Ops:
+            Pin_Msg = getattr(Batch_Msg.Ops.add(), Batch_Op_Fields[Service])
+            Pin_Msg.Pin_Port = Port
+            Pin_Msg.Pin_Num = PinNum
+        msg_id, BatchResultBuffer = await self.request(Service_Batch, Batch_Msg.SerializeToString())
+        BatchResultMsg = message_pb2.Msg_BatchResult()
+        BatchResultMsg.ParseFromString(BatchResultBuffer)
+        return [(Read.Pin_Port, Read.Pin_Num, Read.Pin_Read) for Read in BatchResultMsg.Reads]
+
+class Sync_Client:
+    # Blocking front end of Async_Client for scripts, same methods without await. The event loop
+    # runs in a background thread, so requests from several threads still share one pipeline.
+    def __init__(self, port, **kwargs):
+        self.loop = asyncio.new_event_loop()
+        self.thread = threading.Thread(target=self.loop.run_forever, name="serial-loop", daemon=True)
+        self.thread.start()
+        self.client = self._run(Async_Client(port, **kwargs).open())
+
+    def _run(self, coroutine):
+        return asyncio.run_coroutine_threadsafe(coroutine, self.loop).result()
+
+    def __getattr__(self, name):
+        method = getattr(self.client, name)
+        if not asyncio.iscoroutinefunction(method):
+            return method
+        return lambda *args: self._run(method(*args))
+
+    def close(self):
+        self._run(self.client.close())
+        self.loop.call_soon_threadsafe(self.loop.stop)
+        self.thread.join()
+        self.loop.close()
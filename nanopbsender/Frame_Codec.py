@@ -0,0 +1,244 @@
+import functools
+import message_pb2
+import zlib
+
+# Rate of both ends after reset and after a failed link speed switch
+SERIAL_BAUD_RATE = 9600
+
+# Ports, pins and pin states, the Gpio_Port, Gpio_Pin and Gpio_PinState enums of message.proto.
+# Pin messages only take these values, anything else raises ValueError
+GPIOA = message_pb2.PORT_A
+GPIOB = message_pb2.PORT_B
+GPIOC = message_pb2.PORT_C
+GPIOD = message_pb2.PORT_D
+GPIOE = message_pb2.PORT_E
+GPIOH = message_pb2.PORT_H
+
+PIN0 = message_pb2.PIN_0
+PIN1 = message_pb2.PIN_1
+PIN2 = message_pb2.PIN_2
+PIN3 = message_pb2.PIN_3
+PIN4 = message_pb2.PIN_4
+PIN5 = message_pb2.PIN_5
+PIN6 = message_pb2.PIN_6
+PIN7 = message_pb2.PIN_7
+PIN8 = message_pb2.PIN_8
+PIN9 = message_pb2.PIN_9
+PIN10 = message_pb2.PIN_10
+PIN11 = message_pb2.PIN_11
+PIN12 = message_pb2.PIN_12
+PIN13 = message_pb2.PIN_13
+PIN14 = message_pb2.PIN_14
+PIN15 = message_pb2.PIN_15
+
+STATE_HIGH = message_pb2.STATE_HIGH
+STATE_LOW  = message_pb2.STATE_LOW
+
+# Service_* message IDs and the Services table, generated from src/proto/message.services
+from Message_Services import *
+
+# Msg_BatchOp oneof member for each pin service
+Batch_Op_Fields = {
+    Service_Set_Pin: "Set_Pin",
+    Service_Reset_Pin: "Reset_Pin",
+    Service_Toggle_Pin: "Toggle_Pin",
+    Service_Read_Pin: "Read_Pin",
+}
+
+# Frame header formats
+# FRAMING_LEGACY   : Msg_Header with two fixed32 fields (10 bytes), understood by every firmware
+# FRAMING_COMPACT  : varint tag ((ID + 1) << 3 | 2) then varint body length (2 bytes for small messages)
+# FRAMING_SEQUENCED: varint tag ((ID + 1) << 3 | 0), varint sequence number, varint body length
+# The firmware detects the format of each request and replies in the same one, a sequenced reply
+# carries the sequence number of its request.
+FRAMING_LEGACY = 0
+FRAMING_COMPACT = 1
+FRAMING_SEQUENCED = 2
+
+WIRE_TYPE_VARINT = 0
+WIRE_TYPE_LEN = 2
+
+# COBS link: every frame is COBS encoded between two 0x00 delimiters, a lost or corrupted byte
+# costs one frame and both ends are back in step at the next delimiter. The firmware detects it
+# from the leading delimiter and replies the same way.
+COBS_DELIMITER = 0x00
+
+# CRC trailer of COBS frames: CRC-32/MPEG-2 (the STM32 CRC unit) of header and body, 4 bytes
+# least significant first. The firmware drops a frame that fails the check and replies with a
+# trailer when the request had one.
+CRC32_POLYNOMIAL = 0x04C11DB7
+CRC32_INITIAL = 0xFFFFFFFF
+CRC_LEN = 4
+
+# Bit order reversal of every byte value
+BIT_REVERSE = bytes(int(f"{value:08b}"[::-1], 2) for value in range(256))
+
+def bit_reverse32(value):
+    return int.from_bytes(value.to_bytes(4, 'big').translate(BIT_REVERSE), 'little')
+
+def crc32(data, crc=CRC32_INITIAL):
+    # Same result as the CRC unit and as Crc32_Bitwise in LIB/Crc32.h. CRC-32/MPEG-2 is the
+    # reflected CRC-32 of zlib seen in a mirror: reversing the bits of every input byte and of the
+    # state in and out turns one into the other, so the byte loop runs in C
+    state = zlib.crc32(bytes(data).translate(BIT_REVERSE), bit_reverse32(crc) ^ 0xFFFFFFFF) ^ 0xFFFFFFFF
+    return bit_reverse32(state)
+
+def encode_varint(value):
+    # One and two byte varints (sequence numbers, lengths, pins and masks) skip the loop
+    if 0 <= value < 0x80:
+        return bytes((value,))
+    if 0 <= value < 0x4000:
+        return bytes(((value & 0x7F) | 0x80, value >> 7))
+    out = bytearray()
+    while True:
+        byte = value & 0x7F
+        value >>= 7
+        if value:
+            out.append(byte | 0x80)
+        else:
+            out.append(byte)
+            return bytes(out)
+
+def read_varint(next_byte):
+    value = 0
+    shift = 0
+    while True:
+        byte = next_byte()
+        value |= (byte & 0x7F) << shift
+        shift += 7
+        if not byte & 0x80:
+            return value
+
+def read_header(next_byte):
+    # Returns (msg_id, seq, msg_len), seq is None for the unsequenced framings. Like the firmware,
+    # the framing is told by the wire type of the first byte
+    first = next_byte()
+    wire_type = first & 0x07
+    if wire_type in (WIRE_TYPE_LEN, WIRE_TYPE_VARINT):
+        pending = [first]
+        rest = lambda: pending.pop() if pending else next_byte()
+        msg_id = (read_varint(rest) >> 3) - 1
+        seq = read_varint(rest) if wire_type == WIRE_TYPE_VARINT else None
+        msg_len = read_varint(rest)
+    else:
+        HeaderMsg = message_pb2.Msg_Header()
+        HeaderMsg.ParseFromString(bytes([first] + [next_byte() for _ in range(9)]))
+        msg_id = HeaderMsg.msg_ID
+        seq = None
+        msg_len = HeaderMsg.msg_len
+    return msg_id, seq, msg_len
+
+def parse_header(buffer):
+    # Returns (msg_id, seq, msg_len, header_len) of the header at the start of buffer, None if
+    # the buffer ends inside it
+    pos = 0
+    def next_byte():
+        nonlocal pos
+        if pos >= len(buffer):
+            raise IndexError("header incomplete")
+        pos += 1
+        return buffer[pos - 1]
+    try:
+        msg_id, seq, msg_len = read_header(next_byte)
+    except IndexError:
+        return None
+    return msg_id, seq, msg_len, pos
+
+def cobs_encode(data):
+    # Encodes data without the delimiters, each code byte gives the distance to the next zero.
+    # Splitting at the zeros keeps the byte loop in C, a run of 254 non-zero bytes is a full block
+    out = bytearray()
+    for run in bytes(data).split(b'\x00'):
+        while len(run) >= 0xFE:
+            out.append(0xFF)
+            out += run[:0xFE]
+            run = run[0xFE:]
+        out.append(len(run) + 1)
+        out += run
+    return bytes(out)
+
+def cobs_decode(data):
+    # Decodes a frame read between two delimiters, None if it is malformed
+    out = bytearray()
+    pos = 0
+    while pos < len(data):
+        code = data[pos]
+        if code == 0 or pos + code > len(data):
+            return None
+        out += data[pos + 1:pos + code]
+        pos += code
+        if code != 0xFF and pos < len(data):
+            out.append(0)
+    return bytes(out)
+
+def decode_cobs_frame(encoded, crc):
+    # Decodes a frame read between two delimiters and, with crc, checks and removes its trailer.
+    # None if it is malformed or fails the check
+    frame = cobs_decode(encoded)
+    if frame is not None and crc:
+        if len(frame) > CRC_LEN and crc32(frame[:-CRC_LEN]) == int.from_bytes(frame[-CRC_LEN:], 'little'):
+            return frame[:-CRC_LEN]
+        return None
+    return frame
+
+def build_frame(msg_id, serialized_body, seq, framing, cobs, crc):
+    # Whole frame ready for a single write, crc needs cobs
+    if framing == FRAMING_SEQUENCED:
+        header = (encode_varint(((msg_id + 1) << 3) | WIRE_TYPE_VARINT) + encode_varint(seq) +
+                  encode_varint(len(serialized_body)))
+    elif framing == FRAMING_COMPACT:
+        header = encode_varint(((msg_id + 1) << 3) | WIRE_TYPE_LEN) + encode_varint(len(serialized_body))
+    else:
+        Header_Msg = message_pb2.Msg_Header()
+        Header_Msg.msg_ID = msg_id
+        Header_Msg.msg_len = len(serialized_body)
+        header = Header_Msg.SerializeToString()
+    if cobs:
+        frame = header + serialized_body
+        if crc:
+            frame += crc32(frame).to_bytes(CRC_LEN, 'little')
+        return bytes([COBS_DELIMITER]) + cobs_encode(frame) + bytes([COBS_DELIMITER])
+    return header + serialized_body
+
+# Fire-and-forget commands go out with sequence number 0, the same few frames over and over
+build_frame_cached = functools.lru_cache(maxsize=1024)(build_frame)
+
+class Frame_Parser:
+    # Incremental reply parser for readers that get the stream in arbitrary chunks. feed() returns
+    # the frames completed by a chunk as (msg_id, seq, serialized_body), seq None if unsequenced.
+    def __init__(self, cobs, crc):
+        self.cobs = cobs
+        self.crc = crc
+        self.buffer = bytearray()
+        self.dropped = 0
+
+    def feed(self, data):
+        self.buffer += data
+        frames = []
+        if self.cobs:
+            while True:
+                end = self.buffer.find(COBS_DELIMITER)
+                if end < 0:
+                    break
+                encoded = bytes(self.buffer[:end])
+                del self.buffer[:end + 1]
+                if not encoded:
+                    continue
+                frame = decode_cobs_frame(encoded, self.crc)
+                header = parse_header(frame) if frame is not None else None
+                if header is None or header[3] + header[2] != len(frame):
+                    self.dropped += 1
+                    continue
+                msg_id, seq, msg_len, header_len = header
+                frames.append((msg_id, seq, frame[header_len:]))
+        else:
+            while self.buffer:
+                header = parse_header(self.buffer)
+                if header is None:
+                    break
+                msg_id, seq, msg_len, header_len = header
+                if len(self.buffer) < header_len + msg_len:
+                    break
+                frames.append((msg_id, seq, bytes(self.buffer[header_len:header_len + msg_len])))
+                del self.buffer[:header_len + msg_len]
+        return frames
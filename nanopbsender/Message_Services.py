@@ -0,0 +1,40 @@
+# Automatically generated by services_generator.py from message.services, do not edit
+import collections
+import message_pb2
+
+# Message of the link: ID of the frame header, name without Msg_, message_pb2 class, True for
+# a request run by the firmware, largest encoded body
+Message_Service = collections.namedtuple('Message_Service', 'Id Name Msg_Type Is_Request Max_Size')
+
+Service_Reset_Pin = 0x0
+Service_Read_Pin = 0x1
+Service_Set_Pin = 0x2
+Service_Toggle_Pin = 0x3
+Service_Pin_Value = 0x4
+Service_Batch = 0x5
+Service_Batch_Result = 0x6
+Service_Write_Port = 0x7
+Service_Read_Port = 0x8
+Service_Port_Value = 0x9
+Service_Get_Profile = 0xA
+Service_Profile_Report = 0xB
+Service_Set_Link_Speed = 0xC
+Service_Link_Speed_Ack = 0xD
+
+# Every message of the link by ID, in ID order
+Services = {
+    Service_Reset_Pin: Message_Service(Service_Reset_Pin, "ResetPin", message_pb2.Msg_ResetPin, True, 4),
+    Service_Read_Pin: Message_Service(Service_Read_Pin, "ReadPin", message_pb2.Msg_ReadPin, True, 4),
+    Service_Set_Pin: Message_Service(Service_Set_Pin, "SetPin", message_pb2.Msg_SetPin, True, 4),
+    Service_Toggle_Pin: Message_Service(Service_Toggle_Pin, "TogglePin", message_pb2.Msg_TogglePin, True, 4),
+    Service_Pin_Value: Message_Service(Service_Pin_Value, "PinValue", message_pb2.Msg_PinValue, False, 6),
+    Service_Batch: Message_Service(Service_Batch, "Batch", message_pb2.Msg_Batch, True, 256),
+    Service_Batch_Result: Message_Service(Service_Batch_Result, "BatchResult", message_pb2.Msg_BatchResult, False, 131),
+    Service_Write_Port: Message_Service(Service_Write_Port, "WritePort", message_pb2.Msg_WritePort, True, 10),
+    Service_Read_Port: Message_Service(Service_Read_Port, "ReadPort", message_pb2.Msg_ReadPort, True, 2),
+    Service_Port_Value: Message_Service(Service_Port_Value, "PortValue", message_pb2.Msg_PortValue, False, 6),
+    Service_Get_Profile: Message_Service(Service_Get_Profile, "GetProfile", message_pb2.Msg_GetProfile, True, 2),
+    Service_Profile_Report: Message_Service(Service_Profile_Report, "ProfileReport", message_pb2.Msg_ProfileReport, False, 774),
+    Service_Set_Link_Speed: Message_Service(Service_Set_Link_Speed, "SetLinkSpeed", message_pb2.Msg_SetLinkSpeed, True, 6),
+    Service_Link_Speed_Ack: Message_Service(Service_Link_Speed_Ack, "LinkSpeedAck", message_pb2.Msg_LinkSpeedAck, False, 14),
+}
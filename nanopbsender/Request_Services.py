@@ -1,51 +1,89 @@
+import itertools
 import message_pb2
 import serial
 import time
+from Frame_Codec import *
+from Wire_Templates import *
 
 # Define COM number of serial port
 COM_NUM = 'COM9'
-SERIAL_BAUD_RATE = 9600
 
-GPIOA = 0x0
-GPIOB = 0x1
+# Prints every frame and message field, turn off for high request rates
+VERBOSE = False
 
-PIN0 = 0x0
-PIN1 = 0x1
-PIN2 = 0x2
-PIN3 = 0x3
-PIN4 = 0x4
-PIN5 = 0x5
-PIN6 = 0x6
-PIN7 = 0x7
+# Away from SERIAL_BAUD_RATE, the firmware returns to it after LINK_SPEED_TIMEOUT seconds without
+# a valid frame (LINK_IDLE_TIMEOUT_MS in main.c). The host follows the same rule, counting from the
+# end of its last write, and waits LINK_SPEED_GUARD past the timeout when it can't tell which side
+# of it the firmware is on.
+LINK_SPEED_TIMEOUT = 2.0
+LINK_SPEED_GUARD = 0.1
+# Time the firmware needs to notice its ack has been sent and switch, before the host talks at the new rate
+LINK_SPEED_SWITCH_DELAY = 0.005
 
-STATE_HIGH = 0x1
-STATE_LOW  = 0x0
+# Profiler probe names, in the order of Profile_Probe_t in HAL/Profile/Profile.h
+Profile_Probe_Names = ["USART1_IRQHandler", "Proto_Receive", "pb_decode", "pb_encode", "CRC_Calculate"]
+Profile_Probe_Names += [f"handler {Services[Id].Name if Id in Services else Id}" for Id in range(max(Services) + 1)]
 
-Service_Set_Pin = 0x2
-Service_Reset_Pin = 0x0
-Service_Read_Pin = 0x1
-Service_Toggle_Pin = 0x3
-Service_Pin_Value = 0x4
+# Header format of the requests, see FRAMING_LEGACY in Frame_Codec
+FRAMING = FRAMING_SEQUENCED
+
+# Pipelining: up to REQUEST_WINDOW requests wait for their reply at once, replies are matched to
+# requests by sequence number (in order for the unsequenced framings). The firmware holds pending
+# frames in its frame queue (PROTOBUFF_FRAME_QUEUE_DEPTH) and Rx queue (HUART_RX_QUEUE_SIZE bytes).
+# A request without a reply after REQUEST_TIMEOUT seconds is given up, its reply is None.
+REQUEST_WINDOW = 4
+REQUEST_TIMEOUT = 1.0
+SEQ_MASK = 0xFFFF
+
+# COBS link, see COBS_DELIMITER in Frame_Codec
+LINK_COBS = True
+
+# CRC trailer of COBS frames, see CRC32_POLYNOMIAL in Frame_Codec. Needs LINK_COBS.
+LINK_CRC = True
 
 ser = serial.Serial(COM_NUM, SERIAL_BAUD_RATE)  # Adjust port and baudrate as needed
-ser.set_buffer_size(50)
+# Buffer sizes can only be set on Windows, POSIX ports (and the native simulator pty) keep the defaults
+if hasattr(ser, 'set_buffer_size'):
+    ser.set_buffer_size(50)
 # clear serial buffer
 ser.reset_input_buffer()
 ser.reset_output_buffer()
+# End of the last write, for the link speed idle timeout
+Link_Last_Traffic = time.monotonic()
+# COBS frames dropped as malformed or failing the CRC check, like Frame_Parser.dropped
+Dropped_Frames = 0
+
+def link_fallback():
+    # Waits until the firmware has certainly returned to SERIAL_BAUD_RATE and follows it
+    global Link_Last_Traffic
+    Remaining = Link_Last_Traffic + LINK_SPEED_TIMEOUT + LINK_SPEED_GUARD - time.monotonic()
+    if Remaining > 0:
+        time.sleep(Remaining)
+    ser.baudrate = SERIAL_BAUD_RATE
+    ser.reset_input_buffer()
+    if VERBOSE:
+        print(f"link speed back to {SERIAL_BAUD_RATE}")
+
+def link_check_idle():
+    # Called before every write, the firmware may have dropped a negotiated rate in the meantime
+    if ser.baudrate != SERIAL_BAUD_RATE:
+        if time.monotonic() - Link_Last_Traffic > LINK_SPEED_TIMEOUT - LINK_SPEED_GUARD:
+            link_fallback()
 
 # Function to send serialized data over UART (pseudo-code)
 def send_over_uart(data):
 
-    print("befoer pass")
-
     #check if UART is already sending
     while ser.out_waiting > 0:
         pass
-    print("after pass")
-    # Initialize serial connection
-    print(f"data length {data.__len__()}")
+    if VERBOSE:
+        print(f"data length {data.__len__()}")
     # Write data to UART
+    link_check_idle()
     ser.write(data)
+    ser.flush()
+    global Link_Last_Traffic
+    Link_Last_Traffic = time.monotonic()
     # Close serial connection
     #ser.close()
 
@@ -60,120 +98,342 @@ def receive_over_uart(size):
     #ser.close()
     return received_data
 
-def Request_Set_Pin(Port, PinNum):
-    # Create an instance of the Example message and set its value
-    Header_Msg = message_pb2.Msg_Header()
-    SetPin_Msg = message_pb2.Msg_SetPin()
-
-    SetPin_Msg.Pin_Port = Port
-    SetPin_Msg.Pin_Num = PinNum
-    serialized_SetPin = SetPin_Msg.SerializeToString()
+def uart_next_byte():
+    # Raises IndexError when nothing arrives before the serial timeout
+    return receive_over_uart(1)[0]
+
+def receive_cobs_frame():
+    # Reads up to the next delimiter until a frame decodes, skipping empty and malformed ones and
+    # counting the malformed ones in Dropped_Frames. With LINK_CRC the trailer is checked and removed
+    global Dropped_Frames
+    while True:
+        encoded = bytearray()
+        while True:
+            byte = receive_over_uart(1)[0]
+            if byte == COBS_DELIMITER:
+                break
+            encoded.append(byte)
+        if encoded:
+            frame = decode_cobs_frame(encoded, LINK_CRC)
+            if frame is not None:
+                return frame
+            Dropped_Frames += 1
+            if VERBOSE:
+                print("frame dropped, malformed or CRC mismatch")
+
+def encode_frame(msg_id, serialized_body, seq=0):
+    # Header and body go out in a single write so they are never split by the OS
+    if seq == 0:
+        return build_frame_cached(msg_id, serialized_body, seq, FRAMING, LINK_COBS, LINK_CRC)
+    return build_frame(msg_id, serialized_body, seq, FRAMING, LINK_COBS, LINK_CRC)
+
+def send_frame(msg_id, serialized_body, seq=0):
+    if VERBOSE:
+        print(f"msg_ID:{msg_id}")
+        print(f"msg_len:{len(serialized_body)}")
+    send_over_uart(encode_frame(msg_id, serialized_body, seq))
+
+def receive_frame_seq():
+    # Returns (msg_id, seq, serialized_body) of the next reply, seq is None unless it is sequenced
+    if LINK_COBS:
+        frame = iter(receive_cobs_frame())
+        # A frame cut short is read as a lost reply, like a timeout
+        try:
+            msg_id, seq, msg_len = read_header(frame.__next__)
+        except StopIteration:
+            raise IndexError("truncated frame")
+        body = bytes(itertools.islice(frame, msg_len))
+    else:
+        msg_id, seq, msg_len = read_header(uart_next_byte)
+        body = receive_over_uart(msg_len)
+    if VERBOSE:
+        print(f"HeaderMsg.ID:{msg_id}")
+        print(f"HeaderMsg.Seq:{seq}")
+        print(f"HeaderMsg.len:{msg_len}")
+    return msg_id, seq, body
+
+def receive_frame():
+    # Returns (msg_id, serialized_body) of the next reply
+    msg_id, seq, body = receive_frame_seq()
+    return msg_id, body
+
+Next_Seq = 0
+# seq -> deadline of the requests waiting for their reply, in the order they were sent
+In_Flight = {}
+# seq -> (msg_id, serialized_body) of the replies not collected yet, None for a request given up
+Replies = {}
+
+def submit_request(msg_id, serialized_body, timeout=REQUEST_TIMEOUT):
+    # Sends a request expecting a reply once the window has room, returns its sequence number
+    global Next_Seq
+    while len(In_Flight) >= REQUEST_WINDOW:
+        poll_reply()
+    if not In_Flight:
+        # Nothing can be on its way, whatever is in the buffer is stale
+        clear_uart_buffer()
+    seq = Next_Seq
+    Next_Seq = (Next_Seq + 1) & SEQ_MASK
+    send_frame(msg_id, serialized_body, seq)
+    In_Flight[seq] = time.monotonic() + timeout
+    return seq
+
+def poll_reply():
+    # Waits for the next reply, up to the earliest deadline, and files it under its request
+    if not In_Flight:
+        return
+    Timeout = ser.timeout
+    ser.timeout = max(0.0, min(In_Flight.values()) - time.monotonic())
+    try:
+        msg_id, seq, body = receive_frame_seq()
+        if seq is None:
+            # Unsequenced replies come back in request order
+            seq = next(iter(In_Flight))
+        if seq in In_Flight:
+            del In_Flight[seq]
+            Replies[seq] = (msg_id, body)
+        else:
+            if VERBOSE:
+                print(f"stale reply seq {seq} dropped")
+    except IndexError:
+        pass
+    finally:
+        ser.timeout = Timeout
+    Now = time.monotonic()
+    for seq, deadline in list(In_Flight.items()):
+        if deadline <= Now:
+            if VERBOSE:
+                print(f"request seq {seq} timed out")
+            del In_Flight[seq]
+            Replies[seq] = None
+
+def wait_reply(seq):
+    # Returns (msg_id, serialized_body) of the reply to request seq, None if it never came
+    while seq not in Replies:
+        if seq not in In_Flight:
+            raise KeyError(f"no request with seq {seq}")
+        poll_reply()
+    return Replies.pop(seq)
+
+def drain_requests():
+    # Waits until every request in flight got its reply or timed out
+    while In_Flight:
+        poll_reply()
 
-    Header_Msg.msg_ID = Service_Set_Pin
-    Header_Msg.msg_len = serialized_SetPin.__len__()
-    serialized_header = Header_Msg.SerializeToString()
+def Request_Set_Pin(Port, PinNum):
+    serialized_SetPin = encode_Msg_SetPin(Port, PinNum)
 
-    print(f"Header_Msg.msg_ID:{Header_Msg.msg_ID}")
-    print(f"Header_Msg.msg_len:{Header_Msg.msg_len}")
-    print(f"SetPin_Msg.Pin_Port:{SetPin_Msg.Pin_Port}")
-    print(f"SetPin_Msg.Pin_Num:{SetPin_Msg.Pin_Num}")
+    if VERBOSE:
+        print(f"SetPin_Msg.Pin_Port:{Port}")
+        print(f"SetPin_Msg.Pin_Num:{PinNum}")
 
-    send_over_uart(serialized_header)
-    time.sleep(0.001)
-    send_over_uart(serialized_SetPin)
-    time.sleep(0.001)
+    send_frame(Service_Set_Pin, serialized_SetPin)
 
 def Request_Reset_Pin(Port, PinNum):
-    # Create an instance of the Example message and set its value
-    Header_Msg = message_pb2.Msg_Header()
-    ResetPin_Msg = message_pb2.Msg_ResetPin()
-
-    ResetPin_Msg.Pin_Port = Port
-    ResetPin_Msg.Pin_Num = PinNum
-    serialized_ResetPin = ResetPin_Msg.SerializeToString()
+    serialized_ResetPin = encode_Msg_ResetPin(Port, PinNum)
 
-    Header_Msg.msg_ID = Service_Reset_Pin
-    Header_Msg.msg_len = serialized_ResetPin.__len__()
-    serialized_header = Header_Msg.SerializeToString()
+    if VERBOSE:
+        print(f"ResetPin_Msg.Pin_Port:{Port}")
+        print(f"ResetPin_Msg.Pin_Num:{PinNum}")
 
-    print(f"Header_Msg.msg_ID:{Header_Msg.msg_ID}")
-    print(f"Header_Msg.msg_len:{Header_Msg.msg_len}")
-    print(f"ResetPin_Msg.Pin_Port:{ResetPin_Msg.Pin_Port}")
-    print(f"ResetPin_Msg.Pin_Num:{ResetPin_Msg.Pin_Num}")
-
-    send_over_uart(serialized_header)
-    send_over_uart(serialized_ResetPin)
+    send_frame(Service_Reset_Pin, serialized_ResetPin)
 
 def Request_Toggle_Pin(Port, PinNum):
-    # Create an instance of the Example message and set its value
-    Header_Msg = message_pb2.Msg_Header()
-    Toggle_Msg = message_pb2.Msg_TogglePin()
+    serialized_TogglePin = encode_Msg_TogglePin(Port, PinNum)
+
+    if VERBOSE:
+        print(f"Toggle_Msg.Pin_Port:{Port}")
+        print(f"Toggle_Msg.Pin_Num:{PinNum}")
 
-    Toggle_Msg.Pin_Port = Port
-    Toggle_Msg.Pin_Num = PinNum
-    serialized_TogglePin = Toggle_Msg.SerializeToString()
+    send_frame(Service_Toggle_Pin, serialized_TogglePin)
 
-    Header_Msg.msg_ID = Service_Toggle_Pin
-    Header_Msg.msg_len = serialized_TogglePin.__len__()
-    serialized_header = Header_Msg.SerializeToString()
+def Submit_Read_Pin(Port, PinNum):
+    # Sends Msg_ReadPin without waiting, returns the sequence number of the request
+    serialized_ReadPin = encode_Msg_ReadPin(Port, PinNum)
 
-    print(f"Header_Msg.msg_ID:{Header_Msg.msg_ID}")
-    print(f"Header_Msg.msg_len:{Header_Msg.msg_len}")
-    print(f"Toggle_Msg.Pin_Port:{Toggle_Msg.Pin_Port}")
-    print(f"Toggle_Msg.Pin_Num:{Toggle_Msg.Pin_Num}")
+    if VERBOSE:
+        print(f"ReadPin_Msg.Pin_Port:{Port}")
+        print(f"ReadPin_Msg.Pin_Num:{PinNum}")
 
-    send_over_uart(serialized_header)
-    send_over_uart(serialized_TogglePin)
+    return submit_request(Service_Read_Pin, serialized_ReadPin)
 
 def Request_Read_Pin(Port, PinNum):
-    # Create an instance of the Example message and set its value
-    Header_Msg = message_pb2.Msg_Header()
-    ReadPin_Msg = message_pb2.Msg_ReadPin()
+    return Request_PinValue_Receive(Submit_Read_Pin(Port, PinNum))
 
-    ReadPin_Msg.Pin_Port = Port
-    ReadPin_Msg.Pin_Num = PinNum
-    serialized_ReadPin = ReadPin_Msg.SerializeToString()
+def Request_Read_Pins(Pins):
+    # Pins is a list of (Port, PinNum), read with up to REQUEST_WINDOW requests on the link at once.
+    # Returns the values in the same order, None for a pin whose reply was lost.
+    Seqs = [Submit_Read_Pin(Port, PinNum) for Port, PinNum in Pins]
 
-    Header_Msg.msg_ID = Service_Read_Pin
-    Header_Msg.msg_len = serialized_ReadPin.__len__()
-    serialized_header = Header_Msg.SerializeToString()
+    return [Request_PinValue_Receive(seq) for seq in Seqs]
 
-    print(f"Header_Msg.msg_ID:{Header_Msg.msg_ID}")
-    print(f"Header_Msg.msg_len:{Header_Msg.msg_len}")
-    print(f"ReadPin_Msg.Pin_Port:{ReadPin_Msg.Pin_Port}")
-    print(f"ReadPin_Msg.Pin_Num:{ReadPin_Msg.Pin_Num}")
-    clear_uart_buffer()
-    send_over_uart(serialized_header)
-    send_over_uart(serialized_ReadPin)
+def Request_PinValue_Receive(seq):
+    # Returns the pin value of the reply to request seq, None if it never came
+    Reply = wait_reply(seq)
+    if Reply is None:
+        return None
+    msg_id, PinValueBuffer = Reply
 
-    return Request_PinValue_Receive()
+    PinValueMsg = message_pb2.Msg_PinValue()
 
-def Request_PinValue_Receive():
+    PinValueMsg.ParseFromString(PinValueBuffer)
 
-    headerBuffer = receive_over_uart(10)
-    print(headerBuffer.__len__())
-    print(headerBuffer)
-    print("3dena el uart")
+    if VERBOSE:
+        print(PinValueBuffer.__len__())
+        print(PinValueBuffer)
+        print(f"PinValueMsg.Port:{PinValueMsg.Pin_Port}")
+        print(f"PinValueMsg.PinNum:{PinValueMsg.Pin_Num}")
+        print(f"PinValueMsg.Value:{PinValueMsg.Pin_Read}")
 
-    HeaderMsg = message_pb2.Msg_Header()
-    HeaderMsg.ParseFromString(headerBuffer)
+    return PinValueMsg.Pin_Read
 
-    print(f"HeaderMsg.ID:{HeaderMsg.msg_ID}")
-    print(f"HeaderMsg.len:{HeaderMsg.msg_len}")
+def Request_Write_Port(Port, SetMask, ResetMask):
+    # Bit n of a mask selects pin n, all the selected pins change at the same moment
+    serialized_WritePort = encode_Msg_WritePort(Port, SetMask, ResetMask)
+
+    if VERBOSE:
+        print(f"WritePort_Msg.Port:{Port}")
+        print(f"WritePort_Msg.Set_Mask:{SetMask:#06x}")
+        print(f"WritePort_Msg.Reset_Mask:{ResetMask:#06x}")
+
+    send_frame(Service_Write_Port, serialized_WritePort)
+
+def Request_Read_Port(Port):
+    # Returns the input state of the whole port, bit n holds pin n
+    serialized_ReadPort = encode_Msg_ReadPort(Port)
+
+    if VERBOSE:
+        print(f"ReadPort_Msg.Port:{Port}")
+    Reply = wait_reply(submit_request(Service_Read_Port, serialized_ReadPort))
+    if Reply is None:
+        return None
+    msg_id, PortValueBuffer = Reply
+
+    PortValueMsg = message_pb2.Msg_PortValue()
+    PortValueMsg.ParseFromString(PortValueBuffer)
+
+    if VERBOSE:
+        print(f"PortValueMsg.Port:{PortValueMsg.Port}")
+        print(f"PortValueMsg.Value:{PortValueMsg.Value:#06x}")
+
+    return PortValueMsg.Value
+
+def Request_Batch(Ops):
+    # Ops is a list of (Service, Port, PinNum), executed in order by the firmware in one frame.
+    # Keep a batch to about 30 operations and 16 reads, the firmware buffers are sized for that.
+    Batch_Msg = message_pb2.Msg_Batch()
+
+    for Service, Port, PinNum in Ops:
+        Pin_Msg = getattr(Batch_Msg.Ops.add(), Batch_Op_Fields[Service])
+        Pin_Msg.Pin_Port = Port
+        Pin_Msg.Pin_Num = PinNum
+    serialized_Batch = Batch_Msg.SerializeToString()
+
+    if VERBOSE:
+        print(f"Batch_Msg.Ops:{len(Batch_Msg.Ops)}")
+
+    return Request_BatchResult_Receive(submit_request(Service_Batch, serialized_Batch))
+
+def Request_BatchResult_Receive(seq):
+    # Returns the Read_Pin results of the batch as a list of (Port, PinNum, Value), None without a reply
+    Reply = wait_reply(seq)
+    if Reply is None:
+        return None
+    msg_id, BatchResultBuffer = Reply
+
+    BatchResultMsg = message_pb2.Msg_BatchResult()
+    BatchResultMsg.ParseFromString(BatchResultBuffer)
+
+    if VERBOSE:
+        print(f"BatchResultMsg.Ops_Done:{BatchResultMsg.Ops_Done}")
+        print(f"BatchResultMsg.Reads:{len(BatchResultMsg.Reads)}")
+
+    return [(Read.Pin_Port, Read.Pin_Num, Read.Pin_Read) for Read in BatchResultMsg.Reads]
+
+def Request_Get_Profile(Reset=False):
+    # Returns {probe name: (Count, Min, Max, Mean)} in core clock cycles, empty unless the
+    # firmware was built with PROFILE_ENABLE. Reset clears the probes after they are reported.
+    GetProfile_Msg = message_pb2.Msg_GetProfile()
+
+    GetProfile_Msg.Reset = Reset
+    serialized_GetProfile = GetProfile_Msg.SerializeToString()
+
+    Reply = wait_reply(submit_request(Service_Get_Profile, serialized_GetProfile))
+    if Reply is None:
+        return None
+    msg_id, ProfileReportBuffer = Reply
+
+    ProfileReportMsg = message_pb2.Msg_ProfileReport()
+    ProfileReportMsg.ParseFromString(ProfileReportBuffer)
+
+    Cycles_Per_us = ProfileReportMsg.Core_Clock / 1e6
+    Probes = {}
+    if VERBOSE:
+        print(f"ProfileReportMsg.Core_Clock:{ProfileReportMsg.Core_Clock}")
+        print(f"{'probe':<24}{'count':>8}{'min':>10}{'max':>10}{'mean':>10}{'mean us':>10}")
+    for Probe in ProfileReportMsg.Probes:
+        if Probe.Probe < len(Profile_Probe_Names):
+            Name = Profile_Probe_Names[Probe.Probe]
+        else:
+            Name = f"probe {Probe.Probe}"
+        Probes[Name] = (Probe.Count, Probe.Min, Probe.Max, Probe.Mean)
+        if VERBOSE:
+            print(f"{Name:<24}{Probe.Count:>8}{Probe.Min:>10}{Probe.Max:>10}{Probe.Mean:>10}"
+                  f"{Probe.Mean / Cycles_Per_us:>10.2f}")
+
+    return Probes
+    
 
-    PinValueMsg = message_pb2.Msg_PinValue()
-    PinValueBuffer = receive_over_uart(HeaderMsg.msg_len)
+def Request_Link_Speed_Ack(Baud_Rate):
+    # Sends Msg_SetLinkSpeed at the current rate, returns the Msg_LinkSpeedAck or None without a reply
+    SetLinkSpeed_Msg = message_pb2.Msg_SetLinkSpeed()
+
+    SetLinkSpeed_Msg.Baud_Rate = Baud_Rate
+    serialized_SetLinkSpeed = SetLinkSpeed_Msg.SerializeToString()
+
+    # The rate changes under every request in flight, let them finish first
+    drain_requests()
+    Reply = wait_reply(submit_request(Service_Set_Link_Speed, serialized_SetLinkSpeed,
+                                      LINK_SPEED_TIMEOUT - LINK_SPEED_GUARD))
+    if Reply is None:
+        # Nothing arrived before the timeout
+        return None
+    msg_id, LinkSpeedAckBuffer = Reply
+    if msg_id != Service_Link_Speed_Ack:
+        return None
+
+    LinkSpeedAckMsg = message_pb2.Msg_LinkSpeedAck()
+    LinkSpeedAckMsg.ParseFromString(LinkSpeedAckBuffer)
+
+    if VERBOSE:
+        print(f"LinkSpeedAckMsg.Accepted:{LinkSpeedAckMsg.Accepted}")
+        print(f"LinkSpeedAckMsg.Baud_Rate:{LinkSpeedAckMsg.Baud_Rate}")
+        print(f"LinkSpeedAckMsg.Error_PPM:{LinkSpeedAckMsg.Error_PPM}")
+
+    return LinkSpeedAckMsg
+
+def Request_Set_Link_Speed(Baud_Rate):
+    # Moves both ends of the link to Baud_Rate. Returns (Baud_Rate, Error_PPM) as produced by the
+    # board, or None if the board refused the rate or the link did not come up at it, in which case
+    # both ends are back at their previous rate (SERIAL_BAUD_RATE after a failed switch).
+    Ack = Request_Link_Speed_Ack(Baud_Rate)
+    if Ack is None or not Ack.Accepted:
+        return None
+    if Baud_Rate == ser.baudrate:
+        return (Ack.Baud_Rate, Ack.Error_PPM)
+
+    # The firmware switches once the ack has left its shift register
+    time.sleep(LINK_SPEED_SWITCH_DELAY)
+    ser.baudrate = Baud_Rate
+    ser.reset_input_buffer()
 
-    print(PinValueBuffer.__len__())
-    print(PinValueBuffer)
-    PinValueMsg.ParseFromString(PinValueBuffer)
+    # The same request at the new rate confirms the link, the firmware acks it without switching
+    Ack = Request_Link_Speed_Ack(Baud_Rate)
+    if Ack is None or not Ack.Accepted:
+        link_fallback()
+        return None
 
-    print(f"PinValueMsg.Port:{PinValueMsg.Pin_Port}")
-    print(f"PinValueMsg.PinNum:{PinValueMsg.Pin_Num}")
-    print(f"PinValueMsg.Value:{PinValueMsg.Pin_Read}")
+    return (Ack.Baud_Rate, Ack.Error_PPM)
 
-    return PinValueMsg.Pin_Read
-    
 
 # Send the serialized data over UART
 #send_over_uart(serialized_data)
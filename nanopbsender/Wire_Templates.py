@@ -0,0 +1,195 @@
+import message_pb2
+from google.protobuf.descriptor import FieldDescriptor as Field_Type
+from Frame_Codec import encode_varint
+
+# Fixed-shape messages (only required scalar fields, as in message.proto) always encode to the same
+# tags in the same order, only the values change. compile_template turns the descriptor of such a
+# message into a function taking the field values in field number order and returning the same
+# bytes as SerializeToString, without building a message object:
+#
+#     encode_Msg_SetPin(GPIOA, PIN0) == b'\x08\x00\x10\x00'
+#
+# When every value fits in one byte, the common case for pins and ports, the frame is a single
+# bytes() of a tuple.
+
+WIRE_TYPE_VARINT = 0
+WIRE_TYPE_FIXED32 = 5
+
+# Source of the value written for a field, from the name of its argument
+Field_Value_Source = {
+    Field_Type.TYPE_UINT32: "{0}",
+    Field_Type.TYPE_BOOL: "(1 if {0} else 0)",
+    Field_Type.TYPE_SINT32: "zigzag({0})",
+    # Checked against the enum values first, see compile_template
+    Field_Type.TYPE_ENUM: "{0}",
+}
+
+VARINT_SMALL = [bytes([value]) for value in range(0x80)]
+
+def varint(value):
+    # Varint of a 32-bit field value, ValueError out of range like SerializeToString
+    if 0 <= value < 0x80:
+        return VARINT_SMALL[value]
+    if 0 <= value < 0x4000:
+        return bytes(((value & 0x7F) | 0x80, value >> 7))
+    if not 0 <= value <= 0xFFFFFFFF:
+        raise ValueError(f"value {value} out of range")
+    return encode_varint(value)
+
+def zigzag(value):
+    # sint32 field value, ValueError out of range like SerializeToString
+    if not -0x80000000 <= value <= 0x7FFFFFFF:
+        raise ValueError(f"value {value} out of range")
+    return ((value << 1) ^ (value >> 31)) & 0xFFFFFFFF
+
+def is_required(Field):
+    # Optional and repeated fields change the shape, FieldDescriptor.label is gone in newer protobuf
+    if hasattr(Field, 'is_required'):
+        return Field.is_required
+    return Field.label == Field.LABEL_REQUIRED
+
+def compile_template(Msg_Type):
+    # Returns the encoder of a fixed-shape message, TypeError for any other message
+    Fields = sorted(Msg_Type.DESCRIPTOR.fields, key=lambda Field: Field.number)
+    if not Fields:
+        raise TypeError(f"{Msg_Type.DESCRIPTOR.name} has no fields")
+    Names = []
+    Fast_Parts = []
+    Parts = []
+    Checks = []
+    Namespace = {"varint": varint, "zigzag": zigzag}
+    for Field in Fields:
+        Name = f"v_{Field.name}"
+        if not is_required(Field) or Field.number >= 16:
+            raise TypeError(f"{Msg_Type.DESCRIPTOR.name}.{Field.name} has no fixed shape")
+        if Field.type == Field_Type.TYPE_FIXED32:
+            Tag = (Field.number << 3) | WIRE_TYPE_FIXED32
+            Parts.append(f"b'\\x{Tag:02x}', {Name}.to_bytes(4, 'little')")
+            Fast_Parts = None
+        elif Field.type in Field_Value_Source:
+            Tag = (Field.number << 3) | WIRE_TYPE_VARINT
+            Value = Field_Value_Source[Field.type].format(Name)
+            Parts.append(f"b'\\x{Tag:02x}', varint({Value})")
+            if Fast_Parts is not None:
+                Fast_Parts.append((Tag, Value))
+            if Field.type == Field_Type.TYPE_ENUM:
+                # Closed enum, any other value raises ValueError like SerializeToString
+                Namespace[f"values_{Field.name}"] = frozenset(Field.enum_type.values_by_number)
+                Checks.append(f"    if {Name} not in values_{Field.name}:\n"
+                              f"        raise ValueError(f\"invalid enumerator {{{Name}}}\")\n")
+        else:
+            raise TypeError(f"{Msg_Type.DESCRIPTOR.name}.{Field.name} has no fixed shape")
+        Names.append(Name)
+
+    Encoder_Name = f"encode_{Msg_Type.DESCRIPTOR.name}"
+    Source = f"def {Encoder_Name}({', '.join(Names)}):\n" + "".join(Checks)
+    if Fast_Parts is not None:
+        Values = [Value for Tag, Value in Fast_Parts]
+        Tuple = ", ".join(f"0x{Tag:02x}, {Value}" for Tag, Value in Fast_Parts)
+        Source += f"    if not (({' | '.join(Values)}) >> 7):\n"
+        Source += f"        return bytes(({Tuple},))\n"
+    Source += f"    return b''.join(({', '.join(Parts)},))\n"
+    exec(compile(Source, f"<{Encoder_Name}>", "exec"), Namespace)
+    return Namespace[Encoder_Name]
+
+def compile_templates():
+    # Encoders of every fixed-shape message of message.proto, by message name
+    Encoders = {}
+    for Name in message_pb2.DESCRIPTOR.message_types_by_name:
+        try:
+            Encoders[Name] = compile_template(getattr(message_pb2, Name))
+        except TypeError:
+            pass
+    return Encoders
+
+Encoders = compile_templates()
+globals().update({f"encode_{Name}": Encoder for Name, Encoder in Encoders.items()})
+__all__ = ["Encoders", "compile_template"] + [f"encode_{Name}" for Name in Encoders]
+
+def reference_encode(Name, Values):
+    # Same bytes through message_pb2
+    Msg = getattr(message_pb2, Name)()
+    for Field, Value in zip(sorted(Msg.DESCRIPTOR.fields, key=lambda Field: Field.number), Values):
+        setattr(Msg, Field.name, Value)
+    return Msg.SerializeToString()
+
+def verify_templates(Count=20000, Seed=1):
+    # Compares every template with message_pb2 on edge and random values, the outcome (bytes or
+    # exception type) must match. Returns the number of checked encodings
+    import random
+    Rng = random.Random(Seed)
+    Edges = {
+        Field_Type.TYPE_UINT32: [0, 1, 0x7F, 0x80, 0x3FFF, 0x4000, 0xFFFFFFFF, -1, 0x100000000],
+        Field_Type.TYPE_FIXED32: [0, 1, 0x80, 0xFFFFFFFF],
+        Field_Type.TYPE_BOOL: [False, True],
+        Field_Type.TYPE_SINT32: [0, -1, 1, -64, 63, -65, 64, -0x80000000, 0x7FFFFFFF, 0x80000000],
+    }
+    Random_Value = {
+        Field_Type.TYPE_UINT32: lambda Field: Rng.choice([Rng.randrange(0x80), Rng.randrange(0x100000000)]),
+        Field_Type.TYPE_FIXED32: lambda Field: Rng.randrange(0x100000000),
+        Field_Type.TYPE_BOOL: lambda Field: Rng.random() < 0.5,
+        Field_Type.TYPE_SINT32: lambda Field: Rng.choice([Rng.randrange(-64, 64), Rng.randrange(-0x80000000, 0x80000000)]),
+        # Mostly valid values, sometimes one past the last or out of range
+        Field_Type.TYPE_ENUM: lambda Field: Rng.choice(list(Field.enum_type.values_by_number) * 4 +
+                                                       [max(Field.enum_type.values_by_number) + 1, Rng.randrange(0x100)]),
+    }
+    def field_edges(Field):
+        if Field.type == Field_Type.TYPE_ENUM:
+            Values = sorted(Field.enum_type.values_by_number)
+            return Values[:1] + Values[-1:] + [Values[-1] + 1, -1, 0x80, 0x100000000]
+        return Edges[Field.type]
+    def outcome(Encode):
+        try:
+            return Encode()
+        except (ValueError, TypeError) as Error:
+            return type(Error)
+    Checked = 0
+    for Name, Encoder in Encoders.items():
+        Fields = sorted(getattr(message_pb2, Name).DESCRIPTOR.fields, key=lambda Field: Field.number)
+        Base = [field_edges(Field)[0] for Field in Fields]
+        Cases = [Base[:Index] + [Edge] + Base[Index + 1:] for Index, Field in enumerate(Fields) for Edge in field_edges(Field)]
+        Cases += [[Rng.choice(field_edges(Field)) for Field in Fields] for _ in range(Count // 10)]
+        Cases += [[Random_Value[Field.type](Field) for Field in Fields] for _ in range(Count)]
+        for Values in Cases:
+            Expected = outcome(lambda: reference_encode(Name, Values))
+            Got = outcome(lambda: Encoder(*Values))
+            if Got != Expected:
+                raise AssertionError(f"{Name}{tuple(Values)}: template {Got!r}, message_pb2 {Expected!r}")
+            Checked += 1
+    return Checked
+
+def benchmark_templates(Number=200000):
+    # Per message cost of message_pb2 and of the template, in microseconds
+    import timeit
+    from Frame_Codec import build_frame, build_frame_cached, FRAMING_SEQUENCED, Service_Set_Pin, Service_Read_Pin
+    def pb_set_pin():
+        SetPin_Msg = message_pb2.Msg_SetPin()
+        SetPin_Msg.Pin_Port = 1
+        SetPin_Msg.Pin_Num = 5
+        return SetPin_Msg.SerializeToString()
+    def pb_write_port():
+        WritePort_Msg = message_pb2.Msg_WritePort()
+        WritePort_Msg.Port = 1
+        WritePort_Msg.Set_Mask = 0x00F0
+        WritePort_Msg.Reset_Mask = 0x000F
+        return WritePort_Msg.SerializeToString()
+    Cases = [
+        ("Msg_SetPin", pb_set_pin, lambda: encode_Msg_SetPin(1, 5)),
+        ("Msg_WritePort", pb_write_port, lambda: encode_Msg_WritePort(1, 0x00F0, 0x000F)),
+        # Sequenced request, the frame is built every time
+        ("Read_Pin frame", lambda: build_frame(Service_Read_Pin, pb_set_pin(), 7, FRAMING_SEQUENCED, True, True),
+         lambda: build_frame(Service_Read_Pin, encode_Msg_ReadPin(1, 5), 7, FRAMING_SEQUENCED, True, True)),
+        # Fire-and-forget command, sequence number 0, the frame comes from the cache
+        ("Set_Pin frame", lambda: build_frame(Service_Set_Pin, pb_set_pin(), 0, FRAMING_SEQUENCED, True, True),
+         lambda: build_frame_cached(Service_Set_Pin, encode_Msg_SetPin(1, 5), 0, FRAMING_SEQUENCED, True, True)),
+    ]
+    print(f"{'encode':<16}{'message_pb2 us':>16}{'template us':>14}{'speedup':>10}")
+    for Name, Reference, Template in Cases:
+        Reference_us = timeit.timeit(Reference, number=Number) / Number * 1e6
+        Template_us = timeit.timeit(Template, number=Number) / Number * 1e6
+        print(f"{Name:<16}{Reference_us:>16.3f}{Template_us:>14.3f}{Reference_us / Template_us:>9.1f}x")
+
+if __name__ == '__main__':
+    print(f"templates: {', '.join(Encoders)}")
+    print(f"{verify_templates()} encodings identical to message_pb2")
+    benchmark_templates()
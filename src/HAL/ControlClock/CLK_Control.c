@@ -10,8 +10,9 @@
 /*******************************************************************************
  *                                Includes	                                  *
  *******************************************************************************/
-#include "HAL\ControlClock\CLK_Control.h"
-#include "MCAL\RCC\RCC.h"
+#include "HAL/ControlClock/CLK_Control.h"
+#include "MCAL/RCC/RCC.h"
+#include "MCAL/FLASH/FLASH.h"
 /*******************************************************************************
  *                             Implementation   				                *
  *******************************************************************************/
@@ -44,3 +45,52 @@ Error_enumStatus_t Set_Clock_ON(uint32_t Copy_PortName)
     }
     return Loc_enumReturnStatus;
 }
+
+/*
+ * @brief    : Initialize System Clock.
+ * @return   : Error_enumStatus_t Error status indicating the success or failure of the clock switch.
+ * @details  : Runs SYSCLK from the PLL fed by HSI at 84 MHz: AHB 84 MHz, APB1 42 MHz, APB2 84 MHz,
+ *             with the flash wait states raised first. On failure the core keeps running from HSI.
+ *             The resulting frequencies are read with RCC_Get_AHB_Frequency and friends, drivers
+ *             depending on a bus clock must be initialized after this call.
+ */
+Error_enumStatus_t Init_System_Clock(void)
+{
+    Error_enumStatus_t Loc_enumReturnStatus = Status_enumOk;
+
+    /* The PLL can only be configured while it is off, run from HSI meanwhile */
+    RCC_SET_Clock_ON(CLOCK_HSI);
+    Loc_enumReturnStatus = RCC_READ_ClockReadyState(READY_HSI);
+    if (Loc_enumReturnStatus == Status_enumOk)
+    {
+        Loc_enumReturnStatus = RCC_Select_Sysclk(SysClk_HSI_MASK);
+    }
+    if (Loc_enumReturnStatus == Status_enumOk)
+    {
+        RCC_SET_Clock_OFF(CLOCK_PLL);
+        Loc_enumReturnStatus = RCC_Config_PLLParamters(CLK_PLL_M, CLK_PLL_N, CLK_PLL_P, CLK_PLL_Q);
+    }
+    if (Loc_enumReturnStatus == Status_enumOk)
+    {
+        Loc_enumReturnStatus = RCC_Config_PLLSrc(PLL_SRC_HSI);
+    }
+    if (Loc_enumReturnStatus == Status_enumOk)
+    {
+        RCC_SET_Clock_ON(CLOCK_PLL);
+        Loc_enumReturnStatus = RCC_READ_ClockReadyState(READY_PLL);
+    }
+    /* Flash and APB1 (42 MHz max) must be ready for the new clock before the switch */
+    if (Loc_enumReturnStatus == Status_enumOk)
+    {
+        Loc_enumReturnStatus = FLASH_Config_Latency(CLK_FLASH_LATENCY);
+    }
+    if (Loc_enumReturnStatus == Status_enumOk)
+    {
+        FLASH_Enable_Acceleration();
+        RCC_Config_AHB_BusPrescaler(AHB_1);
+        RCC_Config_APBL_BusPrescaler(APB_L_2);
+        RCC_Config_APBH_BusPrescaler(APB_H_1);
+        Loc_enumReturnStatus = RCC_Select_Sysclk(SysClk_PLL_MASK);
+    }
+    return Loc_enumReturnStatus;
+}
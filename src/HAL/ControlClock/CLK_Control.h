@@ -54,6 +54,14 @@
 #define TIM9 0x60010000
 #define TIM10 0x60020000
 #define TIM11 0x60040000
+/************Boot_Clock_Configuration ************/
+/* SYSCLK = HSI / M * N / P = 16 MHz / 16 * 336 / 4 = 84 MHz, USB clock = 336 MHz / Q = 48 MHz */
+#define CLK_PLL_M 16
+#define CLK_PLL_N 336
+#define CLK_PLL_P 4
+#define CLK_PLL_Q 7
+/* Flash wait states for 84 MHz HCLK at 2.7 V to 3.6 V */
+#define CLK_FLASH_LATENCY 2
 /*******************************************************************************
  *                  	    Functions Prototypes                               *
  *******************************************************************************/
@@ -65,5 +73,15 @@
  */
 Error_enumStatus_t Set_Clock_ON (uint32_t Copy_PortName);
 
+/*
+ * @brief    : Initialize System Clock.
+ * @return   : Error_enumStatus_t Error status indicating the success or failure of the clock switch.
+ * @details  : Runs SYSCLK from the PLL fed by HSI at 84 MHz: AHB 84 MHz, APB1 42 MHz, APB2 84 MHz,
+ *             with the flash wait states raised first. On failure the core keeps running from HSI.
+ *             The resulting frequencies are read with RCC_Get_AHB_Frequency and friends, drivers
+ *             depending on a bus clock must be initialized after this call.
+ */
+Error_enumStatus_t Init_System_Clock(void);
+
 
 #endif
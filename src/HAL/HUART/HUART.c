@@ -12,6 +12,7 @@
 #include "HAL/HUART/HUART.h"
 #include "MCAL/GPIO/GPIO.h"
 #include "MCAL/NVIC/NVIC.h"
+#include "LIB/RingBuffer.h"
 /*******************************************************************************
  *                                Definitions                                  *
  *******************************************************************************/
@@ -30,6 +31,24 @@ typedef struct
 {
     USART_UserReq_t BuffReqInfo;
 } HUSART_GetReq_t;
+typedef struct
+{
+    RingBuffer_t Ring;
+    uint8_t Buffer[HUART_TX_QUEUE_SIZE];
+    /* Set while a chunk of the queue is owned by the transmitter */
+    uint32_t Active;
+    /* Size of the chunk owned by the transmitter */
+    uint32_t InFlight;
+    Cb Drain_cb;
+} HUSART_TxQueue_t;
+typedef struct
+{
+    RingBuffer_t Ring;
+    uint8_t Buffer[HUART_RX_QUEUE_SIZE];
+    /* Circular buffer written by the receiver */
+    uint8_t Stream[HUART_RX_STREAM_SIZE];
+    uint32_t Overflow;
+} HUSART_RxQueue_t;
 /*******************************************************************************
  *                              Variables                                       *
  *******************************************************************************/
@@ -41,9 +60,21 @@ extern uint8_t g_UART2_idx;
 extern uint8_t g_UART6_idx;
 static uint8_t g_Index_Of_Sending;
 static uint8_t g_Index_Of_Receiving;
+static HUSART_TxQueue_t TxQueue[_USART_Num];
+static HUSART_RxQueue_t RxQueue[_USART_Num];
 /*******************************************************************************
  *                         Static Function Prototypes		                   *
  *******************************************************************************/
+static Error_enumStatus_t HUART_GetIndex(uint8_t USART_ID, uint8_t *Ptr_idx);
+static void HUART_TxPump(uint8_t Loc_idx);
+static void HUART_TxDone(uint8_t Loc_idx);
+static void HUART_USART1TxDone(void);
+static void HUART_USART2TxDone(void);
+static void HUART_USART6TxDone(void);
+static void HUART_RxQueueRun(uint8_t Loc_idx, const uint8_t *Ptr_Data, uint32_t Len);
+static void HUART_USART1RxRun(const uint8_t *Ptr_Data, uint32_t Len);
+static void HUART_USART2RxRun(const uint8_t *Ptr_Data, uint32_t Len);
+static void HUART_USART6RxRun(const uint8_t *Ptr_Data, uint32_t Len);
 
 /*******************************************************************************
  *                             Implementation   				                *
@@ -78,23 +109,33 @@ Error_enumStatus_t HUART_Init(void)
         UART_PINS[RX_ID].Port = HUARTS[Loc_idx].RX_PORT;
         UART_PINS[RX_ID].PinNumber = HUARTS[Loc_idx].RX_PIN;
 
+        /* Start with empty Tx and Rx queues */
+        RingBuffer_Init(&TxQueue[Loc_idx].Ring, TxQueue[Loc_idx].Buffer, HUART_TX_QUEUE_SIZE);
+        RingBuffer_Init(&RxQueue[Loc_idx].Ring, RxQueue[Loc_idx].Buffer, HUART_RX_QUEUE_SIZE);
+
         GPIO_initPin(&UART_PINS[TX_ID]);
         GPIO_initPin(&UART_PINS[RX_ID]);
 
         /* Configure GPIO alternate function for UART TX and RX */
         GPIO_setPinAF(UART_PINS[TX_ID].Port, UART_PINS[TX_ID].PinNumber, HUARTS[Loc_idx].TX_AF_ID);
         GPIO_setPinAF(UART_PINS[RX_ID].Port, UART_PINS[RX_ID].PinNumber, HUARTS[Loc_idx].TX_AF_ID);
-        /* Enable NVIC interrupts for UART communication */
+        /* Enable NVIC interrupts for UART communication and its Tx/Rx DMA streams */
         switch (HUARTS[Loc_idx].USART_ID)
         {
         case HUSART1_ID:
             Enable_NVIC_IRQ(USART1_IRQ);
+            Enable_NVIC_IRQ(DMA2_Stream7_IRQ);
+            Enable_NVIC_IRQ(DMA2_Stream5_IRQ);
             break;
         case HUSART2_ID:
             Enable_NVIC_IRQ(USART2_IRQ);
+            Enable_NVIC_IRQ(DMA1_Stream6_IRQ);
+            Enable_NVIC_IRQ(DMA1_Stream5_IRQ);
             break;
         case HUSART6_ID:
             Enable_NVIC_IRQ(USART6_IRQ);
+            Enable_NVIC_IRQ(DMA2_Stream6_IRQ);
+            Enable_NVIC_IRQ(DMA2_Stream1_IRQ);
             break;
         default:
             Loc_enumReturnStatus = Status_enumNotOk;
@@ -110,15 +151,15 @@ Error_enumStatus_t HUART_Init(void)
 }
 
 /**
- * @brief    : Initiates an asynchronous send operation for UART communication.
- * @details  : This function initiates an asynchronous send operation for UART communication.
+ * @brief    : Queues a buffer for asynchronous transmission.
+ * @details  : This function never blocks and never overwrites a request that is still being sent.
  *             - Checks if the pointer to the UART send request structure is valid.
  *             - Determines the index of the UART channel based on the provided USART ID.
- *             - Checks if the UART send request state is ready to send data.
- *             - Updates the send request structure with the provided buffer information.
- *             - Sets the UART type to send mode.
+ *             - Copies the whole buffer into the port Tx queue, the buffer can be reused on return.
+ *             - Starts the transmitter if it is idle, queued bytes are sent back to back.
  * @param[in]: Ptr_HUARTSendReq Pointer to the UART send request structure.
- * @return   : Error_enumStatus_t Error status indicating the success or failure of the send operation initiation.
+ * @return   : Error_enumStatus_t Status_enumBusyState if the queue has no room for the whole buffer,
+ *             in which case nothing is queued.
  **/
 Error_enumStatus_t HUART_SendBuffAsync(HUSART_UserReq_t *Ptr_HUARTSendReq)
 {
@@ -126,39 +167,23 @@ Error_enumStatus_t HUART_SendBuffAsync(HUSART_UserReq_t *Ptr_HUARTSendReq)
     Error_enumStatus_t Loc_enumReturnStatus = Status_enumOk;
 
     /* Check if the pointer to the UART send request structure is valid */
-    if (Ptr_HUARTSendReq == NULL)
+    if ((Ptr_HUARTSendReq == NULL) || (Ptr_HUARTSendReq->Ptr_buffer == NULL))
     {
         Loc_enumReturnStatus = Status_enumNULLPointer;
     }
     else
     {
-        switch (Ptr_HUARTSendReq->USART_ID)
-        {
-        case HUSART1_ID:
-            g_Index_Of_Sending = g_UART1_idx;
-            break;
-        case HUSART2_ID:
-            g_Index_Of_Sending = g_UART2_idx;
-            break;
-        case HUSART6_ID:
-            g_Index_Of_Sending = g_UART6_idx;
-            break;
-        default:
-            Loc_enumReturnStatus = Status_enumNotOk;
-            break;
-        }
-        /* Check if the UART send request state is ready to send data */
+        Loc_enumReturnStatus = HUART_GetIndex(Ptr_HUARTSendReq->USART_ID, &g_Index_Of_Sending);
+        /* Queue the whole buffer or nothing, a full queue is reported to the caller */
         if (Loc_enumReturnStatus == Status_enumOk)
         {
-            SendReq[g_Index_Of_Sending].BuffReqInfo.Ptr_buffer = Ptr_HUARTSendReq->Ptr_buffer;
-            SendReq[g_Index_Of_Sending].BuffReqInfo.Buff_Len = Ptr_HUARTSendReq->Buff_Len;
-            SendReq[g_Index_Of_Sending].BuffReqInfo.Buff_cb = Ptr_HUARTSendReq->Buff_cb;
-            SendReq[g_Index_Of_Sending].BuffReqInfo.USART_ID = Ptr_HUARTSendReq->USART_ID;
-            USART_TxBufferAsyncZeroCopy(&(SendReq[g_Index_Of_Sending].BuffReqInfo));
+            Loc_enumReturnStatus = RingBuffer_Write(&TxQueue[g_Index_Of_Sending].Ring,
+                                                    Ptr_HUARTSendReq->Ptr_buffer, Ptr_HUARTSendReq->Buff_Len);
         }
-        else
+        if (Loc_enumReturnStatus == Status_enumOk)
         {
-            Loc_enumReturnStatus = Status_enumNotOk;
+            TxQueue[g_Index_Of_Sending].Drain_cb = Ptr_HUARTSendReq->Buff_cb;
+            HUART_TxPump(g_Index_Of_Sending);
         }
     }
 
@@ -221,4 +246,415 @@ Error_enumStatus_t HUART_ReceiveBuffAsync(HUSART_UserReq_t *Ptr_HUARTGetReq)
         
     }
     return Loc_enumReturnStatus;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief    : Starts continuous reception for UART communication.
+ * @details  : This function starts a receive operation that never stops by itself.
+ *             - Checks if the pointer to the UART stream request structure is valid.
+ *             - Hands the circular buffer and the run callback to the USART driver.
+ * @param[in]: Ptr_HUARTStreamReq Pointer to the UART stream request structure.
+ * @return   : Error_enumStatus_t Error status indicating the success or failure of the receive operation start.
+ **/
+Error_enumStatus_t HUART_ReceiveStreamAsync(HUSART_StreamReq_t *Ptr_HUARTStreamReq)
+{
+    /* Local Variable to store error status */
+    Error_enumStatus_t Loc_enumReturnStatus = Status_enumOk;
+
+    /* Check if the pointer to the UART stream request structure is valid */
+    if (Ptr_HUARTStreamReq == NULL)
+    {
+        Loc_enumReturnStatus = Status_enumNULLPointer;
+    }
+    else
+    {
+        USART_RxStreamReq_t Loc_StreamReq =
+        {
+            .USART_ID = Ptr_HUARTStreamReq->USART_ID,
+            .Ptr_buffer = Ptr_HUARTStreamReq->Ptr_buffer,
+            .Buff_Len = Ptr_HUARTStreamReq->Buff_Len,
+            .Run_cb = Ptr_HUARTStreamReq->Run_cb,
+        };
+        Loc_enumReturnStatus = USART_RxStreamStart(&Loc_StreamReq);
+    }
+
+    /* Return the status of the UART receive operation start */
+    return Loc_enumReturnStatus;
+}
+
+/**
+ * @brief    : Stops continuous reception for UART communication.
+ * @param[in]: USART_ID USART ID.
+ * @return   : Error_enumStatus_t Error status indicating the success or failure of the operation.
+ **/
+Error_enumStatus_t HUART_StopReceiveStream(uint8_t USART_ID)
+{
+    return USART_RxStreamStop(USART_ID);
+}
+
+/**
+ * @brief    : Starts continuous reception into the port Rx queue.
+ * @details  : Received runs are copied into the port Rx queue from interrupt context and read
+ *             back with HUART_ReadRxQueue, typically from the main loop.
+ * @param[in]: USART_ID USART ID.
+ * @return   : Error_enumStatus_t Error status indicating the success or failure of the receive operation start.
+ **/
+Error_enumStatus_t HUART_StartRxQueue(uint8_t USART_ID)
+{
+    /* Local Variable to store error status */
+    Error_enumStatus_t Loc_enumReturnStatus = Status_enumOk;
+    uint8_t Loc_idx = 0;
+    USART_RxStreamReq_t Loc_StreamReq =
+    {
+        .USART_ID = USART_ID,
+        .Buff_Len = HUART_RX_STREAM_SIZE,
+    };
+
+    Loc_enumReturnStatus = HUART_GetIndex(USART_ID, &Loc_idx);
+    if (Loc_enumReturnStatus == Status_enumOk)
+    {
+        Loc_StreamReq.Ptr_buffer = RxQueue[Loc_idx].Stream;
+        switch (USART_ID)
+        {
+        case HUSART1_ID:
+            Loc_StreamReq.Run_cb = HUART_USART1RxRun;
+            break;
+        case HUSART2_ID:
+            Loc_StreamReq.Run_cb = HUART_USART2RxRun;
+            break;
+        default:
+            Loc_StreamReq.Run_cb = HUART_USART6RxRun;
+            break;
+        }
+        Loc_enumReturnStatus = USART_RxStreamStart(&Loc_StreamReq);
+    }
+
+    /* Return the status of the UART receive operation start */
+    return Loc_enumReturnStatus;
+}
+
+/**
+ * @brief    : Reads received bytes out of the port Rx queue.
+ * @param[in]: USART_ID    USART ID.
+ * @param[out]: Ptr_Data   Destination buffer.
+ * @param[in]: MaxLen      Size of the destination buffer.
+ * @param[out]: Ptr_ReadLen Number of bytes read.
+ * @return   : Error_enumStatus_t Error status indicating the success or failure of the operation.
+ **/
+Error_enumStatus_t HUART_ReadRxQueue(uint8_t USART_ID, uint8_t *Ptr_Data, uint32_t MaxLen, uint32_t *Ptr_ReadLen)
+{
+    /* Local Variable to store error status */
+    Error_enumStatus_t Loc_enumReturnStatus = Status_enumOk;
+    uint8_t Loc_idx = 0;
+
+    if ((Ptr_Data == NULL) || (Ptr_ReadLen == NULL))
+    {
+        Loc_enumReturnStatus = Status_enumNULLPointer;
+    }
+    else
+    {
+        *Ptr_ReadLen = 0;
+        Loc_enumReturnStatus = HUART_GetIndex(USART_ID, &Loc_idx);
+        if (Loc_enumReturnStatus == Status_enumOk)
+        {
+            *Ptr_ReadLen = RingBuffer_Read(&RxQueue[Loc_idx].Ring, Ptr_Data, MaxLen);
+        }
+    }
+
+    /* Return the status of the operation */
+    return Loc_enumReturnStatus;
+}
+
+/**
+ * @brief    : Gives the received bytes at the front of the port Rx queue without copying them.
+ * @details  : Never blocks. The bytes stay in the queue until HUART_ConsumeRxQueue, the run stops at
+ *             the end of the queue storage, the rest comes with the next call. Must be called from
+ *             the context that reads the queue.
+ * @param[in]: USART_ID    USART ID.
+ * @param[out]: Ptr_Data   Set to the first received byte.
+ * @param[out]: Ptr_Len    Number of contiguous received bytes.
+ * @return   : Error_enumStatus_t Error status indicating the success or failure of the operation.
+ **/
+Error_enumStatus_t HUART_PeekRxQueue(uint8_t USART_ID, uint8_t **Ptr_Data, uint32_t *Ptr_Len)
+{
+    /* Local Variable to store error status */
+    Error_enumStatus_t Loc_enumReturnStatus = Status_enumOk;
+    uint8_t Loc_idx = 0;
+
+    if ((Ptr_Data == NULL) || (Ptr_Len == NULL))
+    {
+        Loc_enumReturnStatus = Status_enumNULLPointer;
+    }
+    else
+    {
+        *Ptr_Len = 0;
+        Loc_enumReturnStatus = HUART_GetIndex(USART_ID, &Loc_idx);
+        if (Loc_enumReturnStatus == Status_enumOk)
+        {
+            *Ptr_Len = RingBuffer_Peek(&RxQueue[Loc_idx].Ring, Ptr_Data);
+        }
+    }
+
+    /* Return the status of the operation */
+    return Loc_enumReturnStatus;
+}
+
+/**
+ * @brief    : Releases bytes returned by HUART_PeekRxQueue.
+ * @param[in]: USART_ID    USART ID.
+ * @param[in]: Len         Number of bytes to release, at most the length returned by the peek.
+ * @return   : Error_enumStatus_t Error status indicating the success or failure of the operation.
+ **/
+Error_enumStatus_t HUART_ConsumeRxQueue(uint8_t USART_ID, uint32_t Len)
+{
+    /* Local Variable to store error status */
+    Error_enumStatus_t Loc_enumReturnStatus = Status_enumOk;
+    uint8_t Loc_idx = 0;
+
+    Loc_enumReturnStatus = HUART_GetIndex(USART_ID, &Loc_idx);
+    if (Loc_enumReturnStatus == Status_enumOk)
+    {
+        if (Len > RingBuffer_GetUsed(&RxQueue[Loc_idx].Ring))
+        {
+            Loc_enumReturnStatus = Status_enumWrongInput;
+        }
+        else
+        {
+            RingBuffer_Consume(&RxQueue[Loc_idx].Ring, Len);
+        }
+    }
+
+    /* Return the status of the operation */
+    return Loc_enumReturnStatus;
+}
+
+/**
+ * @brief    : Reads the room left in the port Tx queue.
+ * @details  : A send of at most this many bytes is accepted. Only the sender fills the queue,
+ *             so the room can only grow until its next send.
+ * @param[in]: USART_ID    USART ID.
+ * @param[out]: Ptr_Free   Number of free bytes.
+ * @return   : Error_enumStatus_t Error status indicating the success or failure of the operation.
+ **/
+Error_enumStatus_t HUART_GetTxFree(uint8_t USART_ID, uint32_t *Ptr_Free)
+{
+    /* Local Variable to store error status */
+    Error_enumStatus_t Loc_enumReturnStatus = Status_enumOk;
+    uint8_t Loc_idx = 0;
+
+    if (Ptr_Free == NULL)
+    {
+        Loc_enumReturnStatus = Status_enumNULLPointer;
+    }
+    else
+    {
+        Loc_enumReturnStatus = HUART_GetIndex(USART_ID, &Loc_idx);
+        if (Loc_enumReturnStatus == Status_enumOk)
+        {
+            *Ptr_Free = RingBuffer_GetFree(&TxQueue[Loc_idx].Ring);
+        }
+    }
+
+    /* Return the status of the operation */
+    return Loc_enumReturnStatus;
+}
+
+/**
+ * @brief    : Reads the number of received bytes that did not fit in the port Rx queue.
+ * @param[in]: USART_ID    USART ID.
+ * @param[out]: Ptr_Count  Number of bytes lost since start up.
+ * @return   : Error_enumStatus_t Error status indicating the success or failure of the operation.
+ **/
+Error_enumStatus_t HUART_GetRxOverflow(uint8_t USART_ID, uint32_t *Ptr_Count)
+{
+    /* Local Variable to store error status */
+    Error_enumStatus_t Loc_enumReturnStatus = Status_enumOk;
+    uint8_t Loc_idx = 0;
+
+    if (Ptr_Count == NULL)
+    {
+        Loc_enumReturnStatus = Status_enumNULLPointer;
+    }
+    else
+    {
+        Loc_enumReturnStatus = HUART_GetIndex(USART_ID, &Loc_idx);
+        if (Loc_enumReturnStatus == Status_enumOk)
+        {
+            *Ptr_Count = RxQueue[Loc_idx].Overflow;
+        }
+    }
+
+    /* Return the status of the operation */
+    return Loc_enumReturnStatus;
+}
+
+/**
+ * @brief    : Changes the baud rate of a port once everything queued for it has been sent.
+ * @details  : Never blocks, the caller retries while Status_enumBusyState is returned.
+ *             - Busy while the Tx queue holds bytes or a chunk is being transmitted.
+ *             - Busy until the last frame has left the shift register (TC set).
+ *             - The Rx queue is kept, bytes received before the change stay readable.
+ * @param[in]: USART_ID USART ID.
+ * @param[in]: BaudRate New baud rate.
+ * @return   : Error_enumStatus_t Status_enumBusyState while the port is still transmitting,
+ *             Status_enumWrongInput if the rate can't be reached.
+ **/
+Error_enumStatus_t HUART_SetBaudRate(uint8_t USART_ID, uint32_t BaudRate)
+{
+    /* Local Variable to store error status */
+    Error_enumStatus_t Loc_enumReturnStatus = Status_enumOk;
+    uint8_t Loc_idx = 0;
+
+    Loc_enumReturnStatus = HUART_GetIndex(USART_ID, &Loc_idx);
+    if (Loc_enumReturnStatus == Status_enumOk)
+    {
+        if ((RingBuffer_GetUsed(&TxQueue[Loc_idx].Ring) != 0) ||
+            (__atomic_load_n(&TxQueue[Loc_idx].Active, __ATOMIC_ACQUIRE) != 0))
+        {
+            Loc_enumReturnStatus = Status_enumBusyState;
+        }
+        else
+        {
+            Loc_enumReturnStatus = USART_SetBaudRate(USART_ID, BaudRate);
+        }
+    }
+
+    /* Return the status of the operation */
+    return Loc_enumReturnStatus;
+}
+
+/**
+ * @brief    : Maps a USART ID to its index in the configuration arrays.
+ * @param[in]: USART_ID USART ID.
+ * @param[out]: Ptr_idx Index of the USART.
+ * @return   : Error_enumStatus_t Status_enumNotOk for an unknown USART.
+ **/
+static Error_enumStatus_t HUART_GetIndex(uint8_t USART_ID, uint8_t *Ptr_idx)
+{
+    Error_enumStatus_t Loc_enumReturnStatus = Status_enumOk;
+
+    switch (USART_ID)
+    {
+    case HUSART1_ID:
+        *Ptr_idx = g_UART1_idx;
+        break;
+    case HUSART2_ID:
+        *Ptr_idx = g_UART2_idx;
+        break;
+    case HUSART6_ID:
+        *Ptr_idx = g_UART6_idx;
+        break;
+    default:
+        Loc_enumReturnStatus = Status_enumNotOk;
+        break;
+    }
+
+    return Loc_enumReturnStatus;
+}
+
+/**
+ * @brief    : Hands the next contiguous chunk of the Tx queue to the transmitter.
+ * @param[in]: Loc_idx Index of the USART.
+ * @details  : Called by the sender and by the Tx completion interrupt. Whoever takes the Active flag
+ *             owns the transmitter, so the queue keeps a single consumer and the chunk is sent
+ *             straight out of the queue storage.
+ **/
+static void HUART_TxPump(uint8_t Loc_idx)
+{
+    HUSART_TxQueue_t *const Loc_Queue = &TxQueue[Loc_idx];
+    uint8_t *Loc_Data = NULL;
+
+    if ((RingBuffer_GetUsed(&Loc_Queue->Ring) != 0) &&
+        (__atomic_exchange_n(&Loc_Queue->Active, 1, __ATOMIC_ACQUIRE) == 0))
+    {
+        Loc_Queue->InFlight = RingBuffer_Peek(&Loc_Queue->Ring, &Loc_Data);
+        SendReq[Loc_idx].BuffReqInfo.USART_ID = HUARTS[Loc_idx].USART_ID;
+        SendReq[Loc_idx].BuffReqInfo.Ptr_buffer = Loc_Data;
+        SendReq[Loc_idx].BuffReqInfo.Buff_Len = Loc_Queue->InFlight;
+        switch (HUARTS[Loc_idx].USART_ID)
+        {
+        case HUSART1_ID:
+            SendReq[Loc_idx].BuffReqInfo.Buff_cb = HUART_USART1TxDone;
+            break;
+        case HUSART2_ID:
+            SendReq[Loc_idx].BuffReqInfo.Buff_cb = HUART_USART2TxDone;
+            break;
+        default:
+            SendReq[Loc_idx].BuffReqInfo.Buff_cb = HUART_USART6TxDone;
+            break;
+        }
+        if (USART_TxBufferAsyncZeroCopy(&(SendReq[Loc_idx].BuffReqInfo)) != Status_enumOk)
+        {
+            /* Transmitter taken by a direct USART user, the queue is retried on the next send */
+            __atomic_store_n(&Loc_Queue->Active, 0, __ATOMIC_RELEASE);
+        }
+    }
+}
+
+/**
+ * @brief    : Tx completion, releases the sent chunk and starts the next one.
+ * @param[in]: Loc_idx Index of the USART.
+ **/
+static void HUART_TxDone(uint8_t Loc_idx)
+{
+    HUSART_TxQueue_t *const Loc_Queue = &TxQueue[Loc_idx];
+
+    RingBuffer_Consume(&Loc_Queue->Ring, Loc_Queue->InFlight);
+    __atomic_store_n(&Loc_Queue->Active, 0, __ATOMIC_RELEASE);
+    HUART_TxPump(Loc_idx);
+    /* Call callback function once everything queued has been sent */
+    if ((RingBuffer_GetUsed(&Loc_Queue->Ring) == 0) && (Loc_Queue->Drain_cb))
+    {
+        Loc_Queue->Drain_cb();
+    }
+}
+
+static void HUART_USART1TxDone(void)
+{
+    HUART_TxDone(g_UART1_idx);
+}
+
+static void HUART_USART2TxDone(void)
+{
+    HUART_TxDone(g_UART2_idx);
+}
+
+static void HUART_USART6TxDone(void)
+{
+    HUART_TxDone(g_UART6_idx);
+}
+
+/**
+ * @brief    : Receiver run callback, queues the run for the reader.
+ * @param[in]: Loc_idx  Index of the USART.
+ * @param[in]: Ptr_Data Received bytes.
+ * @param[in]: Len      Number of received bytes.
+ * @details  : Runs in interrupt context and never waits for the reader. Bytes that do not fit
+ *             are counted in the overflow counter.
+ **/
+static void HUART_RxQueueRun(uint8_t Loc_idx, const uint8_t *Ptr_Data, uint32_t Len)
+{
+    uint32_t Loc_Free = RingBuffer_GetFree(&RxQueue[Loc_idx].Ring);
+
+    if (Len > Loc_Free)
+    {
+        RxQueue[Loc_idx].Overflow += Len - Loc_Free;
+        Len = Loc_Free;
+    }
+    RingBuffer_Write(&RxQueue[Loc_idx].Ring, Ptr_Data, Len);
+}
+
+static void HUART_USART1RxRun(const uint8_t *Ptr_Data, uint32_t Len)
+{
+    HUART_RxQueueRun(g_UART1_idx, Ptr_Data, Len);
+}
+
+static void HUART_USART2RxRun(const uint8_t *Ptr_Data, uint32_t Len)
+{
+    HUART_RxQueueRun(g_UART2_idx, Ptr_Data, Len);
+}
+
+static void HUART_USART6RxRun(const uint8_t *Ptr_Data, uint32_t Len)
+{
+    HUART_RxQueueRun(g_UART6_idx, Ptr_Data, Len);
+}
@@ -22,6 +22,11 @@
 #define HUSART1_ID 				0
 #define HUSART2_ID 				1
 #define HUSART6_ID 				2
+/* Per port queue sizes, must be powers of two */
+#define HUART_TX_QUEUE_SIZE		1024
+#define HUART_RX_QUEUE_SIZE		256
+/* Circular buffer the receiver writes into before bytes are queued */
+#define HUART_RX_STREAM_SIZE	64
 /*******************************************************************************
  *                         Types Declaration                                   *
  *******************************************************************************/
@@ -36,6 +41,14 @@ typedef struct
 }
 HUSART_UserReq_t;
 typedef struct
+{
+	uint8_t USART_ID;
+	uint8_t *Ptr_buffer ;
+	uint32_t Buff_Len ;
+	USART_RxRunCb_t Run_cb ;
+}
+HUSART_StreamReq_t;
+typedef struct
 {
 	uint8_t USART_ID;
 	uint8_t TX_PORT;
@@ -63,15 +76,17 @@ HUSART_PINConfig_t;
 Error_enumStatus_t HUART_Init (void);
 
 /**
- * @brief    : Initiates an asynchronous send operation for UART communication.
- * @details  : This function initiates an asynchronous send operation for UART communication.
+ * @brief    : Queues a buffer for asynchronous transmission.
+ * @details  : This function never blocks and never overwrites a request that is still being sent.
  *             - Checks if the pointer to the UART send request structure is valid.
  *             - Determines the index of the UART channel based on the provided USART ID.
- *             - Checks if the UART send request state is ready to send data.
- *             - Updates the send request structure with the provided buffer information.
- *             - Sets the UART type to send mode.
+ *             - Copies the whole buffer into the port Tx queue, the buffer can be reused on return.
+ *             - Starts the transmitter if it is idle, queued bytes are sent back to back.
+ *             - Buff_cb, if set, is called from interrupt context once the Tx queue has drained.
+ *             The Tx queue is single-producer: all sends on one port must come from the same context.
  * @param[in]: Ptr_HUARTSendReq Pointer to the UART send request structure.
- * @return   : Error_enumStatus_t Error status indicating the success or failure of the send operation initiation.
+ * @return   : Error_enumStatus_t Status_enumBusyState if the queue has no room for the whole buffer,
+ *             in which case nothing is queued.
  **/
 Error_enumStatus_t HUART_SendBuffAsync(HUSART_UserReq_t* Ptr_HUARTSendReq);
 
@@ -87,4 +102,94 @@ Error_enumStatus_t HUART_SendBuffAsync(HUSART_UserReq_t* Ptr_HUARTSendReq);
  * @return   : Error_enumStatus_t Error status indicating the success or failure of the receive operation initiation.
  **/
 Error_enumStatus_t HUART_ReceiveBuffAsync(HUSART_UserReq_t* Ptr_HUARTGetReq);
+
+/**
+ * @brief    : Starts continuous reception for UART communication.
+ * @details  : This function starts a receive operation that never stops by itself.
+ *             - Checks if the pointer to the UART stream request structure is valid.
+ *             - Hands the circular buffer and the run callback to the USART driver.
+ *             - Every run of received bytes is passed to the run callback from interrupt context,
+ *               without re-arming the receiver between runs.
+ * @param[in]: Ptr_HUARTStreamReq Pointer to the UART stream request structure.
+ * @return   : Error_enumStatus_t Error status indicating the success or failure of the receive operation start.
+ **/
+Error_enumStatus_t HUART_ReceiveStreamAsync(HUSART_StreamReq_t* Ptr_HUARTStreamReq);
+
+/**
+ * @brief    : Stops continuous reception for UART communication.
+ * @param[in]: USART_ID USART ID.
+ * @return   : Error_enumStatus_t Error status indicating the success or failure of the operation.
+ **/
+Error_enumStatus_t HUART_StopReceiveStream(uint8_t USART_ID);
+
+/**
+ * @brief    : Starts continuous reception into the port Rx queue.
+ * @details  : Received runs are copied into the port Rx queue from interrupt context and read
+ *             back with HUART_ReadRxQueue, typically from the main loop.
+ * @param[in]: USART_ID USART ID.
+ * @return   : Error_enumStatus_t Error status indicating the success or failure of the receive operation start.
+ **/
+Error_enumStatus_t HUART_StartRxQueue(uint8_t USART_ID);
+
+/**
+ * @brief    : Reads received bytes out of the port Rx queue.
+ * @details  : Never blocks, returns the bytes available so far. Must be called from one context only.
+ * @param[in]: USART_ID    USART ID.
+ * @param[out]: Ptr_Data   Destination buffer.
+ * @param[in]: MaxLen      Size of the destination buffer.
+ * @param[out]: Ptr_ReadLen Number of bytes read.
+ * @return   : Error_enumStatus_t Error status indicating the success or failure of the operation.
+ **/
+Error_enumStatus_t HUART_ReadRxQueue(uint8_t USART_ID, uint8_t *Ptr_Data, uint32_t MaxLen, uint32_t *Ptr_ReadLen);
+
+/**
+ * @brief    : Gives the received bytes at the front of the port Rx queue without copying them.
+ * @details  : Never blocks. The bytes stay in the queue until HUART_ConsumeRxQueue, the run stops at
+ *             the end of the queue storage, the rest comes with the next call. Must be called from
+ *             the context that reads the queue.
+ * @param[in]: USART_ID    USART ID.
+ * @param[out]: Ptr_Data   Set to the first received byte.
+ * @param[out]: Ptr_Len    Number of contiguous received bytes.
+ * @return   : Error_enumStatus_t Error status indicating the success or failure of the operation.
+ **/
+Error_enumStatus_t HUART_PeekRxQueue(uint8_t USART_ID, uint8_t **Ptr_Data, uint32_t *Ptr_Len);
+
+/**
+ * @brief    : Releases bytes returned by HUART_PeekRxQueue.
+ * @param[in]: USART_ID    USART ID.
+ * @param[in]: Len         Number of bytes to release, at most the length returned by the peek.
+ * @return   : Error_enumStatus_t Error status indicating the success or failure of the operation.
+ **/
+Error_enumStatus_t HUART_ConsumeRxQueue(uint8_t USART_ID, uint32_t Len);
+
+/**
+ * @brief    : Reads the room left in the port Tx queue.
+ * @details  : A send of at most this many bytes is accepted. Only the sender fills the queue,
+ *             so the room can only grow until its next send.
+ * @param[in]: USART_ID    USART ID.
+ * @param[out]: Ptr_Free   Number of free bytes.
+ * @return   : Error_enumStatus_t Error status indicating the success or failure of the operation.
+ **/
+Error_enumStatus_t HUART_GetTxFree(uint8_t USART_ID, uint32_t *Ptr_Free);
+
+/**
+ * @brief    : Reads the number of received bytes that did not fit in the port Rx queue.
+ * @param[in]: USART_ID    USART ID.
+ * @param[out]: Ptr_Count  Number of bytes lost since start up.
+ * @return   : Error_enumStatus_t Error status indicating the success or failure of the operation.
+ **/
+Error_enumStatus_t HUART_GetRxOverflow(uint8_t USART_ID, uint32_t *Ptr_Count);
+
+/**
+ * @brief    : Changes the baud rate of a port once everything queued for it has been sent.
+ * @details  : Never blocks, the caller retries while Status_enumBusyState is returned.
+ *             - Busy while the Tx queue holds bytes or a chunk is being transmitted.
+ *             - Busy until the last frame has left the shift register (TC set).
+ *             - The Rx queue is kept, bytes received before the change stay readable.
+ * @param[in]: USART_ID USART ID.
+ * @param[in]: BaudRate New baud rate.
+ * @return   : Error_enumStatus_t Status_enumBusyState while the port is still transmitting,
+ *             Status_enumWrongInput if the rate can't be reached.
+ **/
+Error_enumStatus_t HUART_SetBaudRate(uint8_t USART_ID, uint32_t BaudRate);
 #endif
\ No newline at end of file
@@ -0,0 +1,137 @@
+/*
+ ============================================================================
+ Name        : Profile.c
+ Author      : Omar Medhat Mohamed
+ Description : Source File for the cycle count profiler
+ Date        : 2/6/2024
+ ============================================================================
+ */
+/*******************************************************************************
+ *                                Includes	                                  *
+ *******************************************************************************/
+#include "HAL/Profile/Profile.h"
+
+#if PROFILE_ENABLE
+/*******************************************************************************
+ *                             Definitions                                      *
+ *******************************************************************************/
+/* Empty measurements averaged to get the probe overhead */
+#define PROFILE_CALIBRATION_RUNS 8
+/*******************************************************************************
+ *                              Variables		                                *
+ *******************************************************************************/
+/* Statistics of every probe, also readable with the debugger */
+Profile_Stats_t Profile_Stats[_PROFILE_PROBE_NUM];
+/* Cycles spent by PROFILE_BEGIN and PROFILE_END themselves */
+static uint32_t Profile_Overhead = 0;
+
+/*******************************************************************************
+ *                             Implementation   				                *
+ *******************************************************************************/
+/*
+ * @brief    : Initialize the profiler
+ * @param[in]: void
+ * @return   : Error_enumStatus_t: Status_enumNotOk if the core has no cycle counter
+ * @details  : Starts the DWT cycle counter, measures the cost of an empty probe so it is
+ *             removed from every sample, and clears all the probes.
+ */
+Error_enumStatus_t Profile_Init(void)
+{
+    /* Local Variable to store error status */
+    Error_enumStatus_t Loc_enumReturnStatus = DWT_EnableCycleCounter();
+    uint32_t Loc_u32Min = 0xFFFFFFFF;
+    uint8_t Loc_u8Run;
+
+    if (Loc_enumReturnStatus == Status_enumOk)
+    {
+        /* The cheapest empty measurement is the overhead, the others were interrupted */
+        Profile_Overhead = 0;
+        for (Loc_u8Run = 0; Loc_u8Run < PROFILE_CALIBRATION_RUNS; Loc_u8Run++)
+        {
+            PROFILE_BEGIN(Loc_u32Start);
+            uint32_t Loc_u32Cycles = DWT_GetCycleCount() - Loc_u32Start;
+
+            if (Loc_u32Cycles < Loc_u32Min)
+            {
+                Loc_u32Min = Loc_u32Cycles;
+            }
+        }
+        Profile_Overhead = Loc_u32Min;
+    }
+    Profile_Reset();
+    /*Return error status*/
+    return Loc_enumReturnStatus;
+}
+
+/*
+ * @brief    : Record a sample
+ * @param[in]: Probe: Probe the sample belongs to
+ * @param[in]: Cycles: Measured core clock cycles, including the probe overhead
+ * @return   : void
+ * @details  : Called by PROFILE_END. Every probe must be recorded from a single context,
+ *             the statistics of a probe are not updated atomically.
+ */
+void Profile_Record(Profile_Probe_t Probe, uint32_t Cycles)
+{
+    if (Probe < _PROFILE_PROBE_NUM)
+    {
+        Profile_Stats_t *Loc_Stats = &Profile_Stats[Probe];
+
+        Cycles = (Cycles > Profile_Overhead) ? (Cycles - Profile_Overhead) : 0;
+        if ((Loc_Stats->Count == 0) || (Cycles < Loc_Stats->Min))
+        {
+            Loc_Stats->Min = Cycles;
+        }
+        if (Cycles > Loc_Stats->Max)
+        {
+            Loc_Stats->Max = Cycles;
+        }
+        Loc_Stats->Total += Cycles;
+        Loc_Stats->Count++;
+    }
+}
+
+/*
+ * @brief    : Get the statistics of a probe
+ * @param[in]: Probe: Probe to read
+ * @param[out]: Ptr_Stats: Statistics of the probe
+ * @return   : Error_enumStatus_t: Status of the operation
+ * @details  : Count is 0 for a probe that was never hit, Min and Max are then 0.
+ */
+Error_enumStatus_t Profile_GetStats(Profile_Probe_t Probe, Profile_Stats_t *Ptr_Stats)
+{
+    /* Local Variable to store error status */
+    Error_enumStatus_t Loc_enumReturnStatus = Status_enumOk;
+
+    if (Ptr_Stats == NULL)
+    {
+        Loc_enumReturnStatus = Status_enumNULLPointer;
+    }
+    else if (Probe >= _PROFILE_PROBE_NUM)
+    {
+        Loc_enumReturnStatus = Status_enumWrongInput;
+    }
+    else
+    {
+        *Ptr_Stats = Profile_Stats[Probe];
+    }
+    /*Return error status*/
+    return Loc_enumReturnStatus;
+}
+
+/*
+ * @brief    : Reset the profiler
+ * @param[in]: void
+ * @return   : void
+ * @details  : Clears the statistics of every probe.
+ */
+void Profile_Reset(void)
+{
+    uint8_t Loc_u8Probe;
+
+    for (Loc_u8Probe = 0; Loc_u8Probe < _PROFILE_PROBE_NUM; Loc_u8Probe++)
+    {
+        Profile_Stats[Loc_u8Probe] = (Profile_Stats_t){0};
+    }
+}
+#endif
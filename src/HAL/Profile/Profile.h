@@ -0,0 +1,117 @@
+/*
+ ============================================================================
+ Name        : Profile.h
+ Author      : Omar Medhat Mohamed
+ Description : Header File for the cycle count profiler
+ Date        : 2/6/2024
+ ============================================================================
+ */
+#ifndef PROFILE_H_
+#define PROFILE_H_
+/*******************************************************************************
+ *                                Includes	                                  *
+ *******************************************************************************/
+#include "LIB/std_types.h"
+#include "LIB/Error.h"
+#include "MCAL/DWT/DWT.h"
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+/* Probes are compiled in with -D PROFILE_ENABLE=1, otherwise they expand to nothing */
+#ifndef PROFILE_ENABLE
+#define PROFILE_ENABLE 0
+#endif
+
+/* One probe per received message ID, see Msg_ProfileReport.Probes */
+#define PROFILE_HANDLER_PROBES 16
+
+/*
+ * PROFILE_BEGIN(Token) starts a measurement in the local variable Token,
+ * PROFILE_END(Probe, Token) adds the cycles elapsed since PROFILE_BEGIN to Probe.
+ * Both must be used in the same block.
+ */
+#if PROFILE_ENABLE
+#define PROFILE_BEGIN(Token)        uint32_t Token = DWT_GetCycleCount()
+#define PROFILE_END(Probe, Token)   Profile_Record((Probe), DWT_GetCycleCount() - (Token))
+#else
+#define PROFILE_BEGIN(Token)
+#define PROFILE_END(Probe, Token)
+#endif
+/*******************************************************************************
+ *                        	  Types Declaration                                 *
+ *******************************************************************************/
+/* Probe points, the host tool mirrors this order to name the probes of a report */
+typedef enum
+{
+    PROFILE_PROBE_USART1_IRQ,       /* USART1_IRQHandler */
+    PROFILE_PROBE_PROTO_RECEIVE,    /* Proto_Receive of one Rx chunk */
+    PROFILE_PROBE_PB_DECODE,        /* pb_decode of a frame body */
+    PROFILE_PROBE_PB_ENCODE,        /* Encoding of a reply frame */
+    PROFILE_PROBE_CRC,              /* CRC_Calculate of a frame check, on the CRC unit */
+    PROFILE_PROBE_HANDLER_FIRST,    /* Handler of message ID is probe PROFILE_PROBE_HANDLER_FIRST + ID */
+    _PROFILE_PROBE_NUM = PROFILE_PROBE_HANDLER_FIRST + PROFILE_HANDLER_PROBES
+} Profile_Probe_t;
+
+typedef struct
+{
+    uint32_t Count;     /* Number of samples */
+    uint32_t Min;       /* Shortest sample in core clock cycles */
+    uint32_t Max;       /* Longest sample in core clock cycles */
+    uint64_t Total;     /* Sum of the samples, Total / Count is the mean */
+} Profile_Stats_t;
+/*******************************************************************************
+ *                  	    Functions Prototypes                               *
+ *******************************************************************************/
+#if PROFILE_ENABLE
+/*
+ * @brief    : Initialize the profiler
+ * @param[in]: void
+ * @return   : Error_enumStatus_t: Status_enumNotOk if the core has no cycle counter
+ * @details  : Starts the DWT cycle counter, measures the cost of an empty probe so it is
+ *             removed from every sample, and clears all the probes.
+ */
+Error_enumStatus_t Profile_Init(void);
+
+/*
+ * @brief    : Record a sample
+ * @param[in]: Probe: Probe the sample belongs to
+ * @param[in]: Cycles: Measured core clock cycles, including the probe overhead
+ * @return   : void
+ * @details  : Called by PROFILE_END. Every probe must be recorded from a single context,
+ *             the statistics of a probe are not updated atomically.
+ */
+void Profile_Record(Profile_Probe_t Probe, uint32_t Cycles);
+
+/*
+ * @brief    : Get the statistics of a probe
+ * @param[in]: Probe: Probe to read
+ * @param[out]: Ptr_Stats: Statistics of the probe
+ * @return   : Error_enumStatus_t: Status of the operation
+ * @details  : Count is 0 for a probe that was never hit, Min and Max are then 0.
+ */
+Error_enumStatus_t Profile_GetStats(Profile_Probe_t Probe, Profile_Stats_t *Ptr_Stats);
+
+/*
+ * @brief    : Reset the profiler
+ * @param[in]: void
+ * @return   : void
+ * @details  : Clears the statistics of every probe.
+ */
+void Profile_Reset(void);
+#else
+/* Profiling disabled, the calls compile to nothing */
+static inline Error_enumStatus_t Profile_Init(void)
+{
+    return Status_enumNotOk;
+}
+static inline Error_enumStatus_t Profile_GetStats(Profile_Probe_t Probe, Profile_Stats_t *Ptr_Stats)
+{
+    (void)Probe;
+    (void)Ptr_Stats;
+    return Status_enumNotOk;
+}
+static inline void Profile_Reset(void)
+{
+}
+#endif
+#endif
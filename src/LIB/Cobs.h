@@ -0,0 +1,195 @@
+/*
+ ============================================================================
+ Name        : Cobs.h
+ Author      : Omar Medhat Mohamed
+ Description : Consistent Overhead Byte Stuffing encoder and streaming decoder
+ Date        : 20/6/2024
+ ============================================================================
+ */
+#ifndef COBS_H_
+#define COBS_H_
+/*******************************************************************************
+ *                                Includes	                                  *
+ *******************************************************************************/
+#include "LIB/std_types.h"
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+/* Frame delimiter, the only byte value that never appears inside an encoded frame */
+#define COBS_DELIMITER			0x00
+/* A code byte is followed by at most 254 data bytes */
+#define COBS_BLOCK_MAX			0xFF
+/* Worst case size of Len bytes once encoded, without delimiters */
+#define COBS_ENCODED_MAX(Len)	((Len) + ((Len) / (COBS_BLOCK_MAX - 1)) + 1)
+/* Cobs_Encode can encode in place when the source starts this far after the destination */
+#define COBS_INPLACE_OFFSET(Len)	(COBS_ENCODED_MAX(Len) - (Len))
+/*******************************************************************************
+ *                        	  Types Declaration                                 *
+ *******************************************************************************/
+typedef enum
+{
+	COBS_DECODE_MORE,	/* Byte consumed, the frame is not complete yet */
+	COBS_DECODE_FRAME,	/* Delimiter after a valid frame, Len bytes are decoded in Buffer */
+	COBS_DECODE_ERROR,	/* Malformed or oversized frame, the rest of it is skipped */
+}
+Cobs_DecodeStatus_t;
+
+/**
+ * @brief    : Streaming decoder state, fed one byte at a time.
+ * @note     : Decoded bytes go straight into Buffer, so a frame is never copied as a whole.
+ *             After an error, bytes are ignored up to the next delimiter, where decoding resumes.
+ **/
+typedef struct
+{
+	uint8_t *Buffer;
+	uint32_t Size;
+	uint32_t Len;
+	/* Code byte of the current block, COBS_BLOCK_MAX at the start of a frame */
+	uint8_t Code;
+	/* Data bytes left in the current block, 0 when a code byte is expected */
+	uint8_t Left;
+	/* Set after an error until the next delimiter */
+	uint8_t Skip;
+}
+Cobs_Decoder_t;
+/*******************************************************************************
+ *                  	    Functions Implementation                           *
+ *******************************************************************************/
+/**
+ * @brief    : Starts decoding a new frame into a buffer.
+ * @param[in]: Ptr_Decoder Pointer to the decoder.
+ * @param[in]: Ptr_Buffer  Destination of the decoded bytes, may change between frames.
+ * @param[in]: Size        Size of the destination buffer.
+ **/
+static inline void Cobs_DecoderStart(Cobs_Decoder_t *Ptr_Decoder, uint8_t *Ptr_Buffer, uint32_t Size)
+{
+	Ptr_Decoder->Buffer = Ptr_Buffer;
+	Ptr_Decoder->Size = Size;
+	Ptr_Decoder->Len = 0;
+	Ptr_Decoder->Code = COBS_BLOCK_MAX;
+	Ptr_Decoder->Left = 0;
+	Ptr_Decoder->Skip = 0;
+}
+
+/**
+ * @brief    : Decodes one received byte.
+ * @param[in]: Ptr_Decoder Pointer to the decoder.
+ * @param[in]: Byte        Received byte.
+ * @return   : Cobs_DecodeStatus_t COBS_DECODE_FRAME once per valid frame, COBS_DECODE_ERROR once per bad one.
+ * @details  : A delimiter always ends the frame, valid or not, so the decoder is back in step
+ *             with the sender at the next frame whatever was lost or corrupted before it.
+ *             Empty frames (back to back delimiters) are ignored. After COBS_DECODE_FRAME the
+ *             caller reads the frame and starts the next one with Cobs_DecoderStart, after
+ *             COBS_DECODE_ERROR the decoder gets back in step by itself.
+ **/
+static inline Cobs_DecodeStatus_t Cobs_DecodeByte(Cobs_Decoder_t *Ptr_Decoder, uint8_t Byte)
+{
+	Cobs_DecodeStatus_t Loc_Status = COBS_DECODE_MORE;
+
+	if (Byte == COBS_DELIMITER)
+	{
+		if (Ptr_Decoder->Skip)
+		{
+			/* Already reported, resume with the next frame */
+			Cobs_DecoderStart(Ptr_Decoder, Ptr_Decoder->Buffer, Ptr_Decoder->Size);
+		}
+		else if (Ptr_Decoder->Left != 0)
+		{
+			/* Block cut short by the delimiter */
+			Cobs_DecoderStart(Ptr_Decoder, Ptr_Decoder->Buffer, Ptr_Decoder->Size);
+			Loc_Status = COBS_DECODE_ERROR;
+		}
+		else if ((Ptr_Decoder->Len != 0) || (Ptr_Decoder->Code != COBS_BLOCK_MAX))
+		{
+			Loc_Status = COBS_DECODE_FRAME;
+		}
+		else
+		{
+			/* Empty frame */
+		}
+	}
+	else if (Ptr_Decoder->Skip)
+	{
+		/* Rest of a bad frame */
+	}
+	else if (Ptr_Decoder->Left == 0)
+	{
+		/* Code byte, every block but the last and the full ones ends with an implicit zero */
+		if (Ptr_Decoder->Code != COBS_BLOCK_MAX)
+		{
+			if (Ptr_Decoder->Len < Ptr_Decoder->Size)
+			{
+				Ptr_Decoder->Buffer[Ptr_Decoder->Len++] = 0;
+			}
+			else
+			{
+				Loc_Status = COBS_DECODE_ERROR;
+			}
+		}
+		Ptr_Decoder->Code = Byte;
+		Ptr_Decoder->Left = Byte - 1;
+	}
+	else if (Ptr_Decoder->Len < Ptr_Decoder->Size)
+	{
+		Ptr_Decoder->Buffer[Ptr_Decoder->Len++] = Byte;
+		Ptr_Decoder->Left--;
+	}
+	else
+	{
+		Loc_Status = COBS_DECODE_ERROR;
+	}
+
+	if ((Loc_Status == COBS_DECODE_ERROR) && (Byte != COBS_DELIMITER))
+	{
+		Ptr_Decoder->Skip = 1;
+	}
+
+	return Loc_Status;
+}
+
+/**
+ * @brief    : Encodes a block, without the delimiters around it.
+ * @param[in]: Ptr_Src Bytes to encode.
+ * @param[in]: Len     Number of bytes to encode.
+ * @param[out]: Ptr_Dst Destination, at least COBS_ENCODED_MAX(Len) bytes. It may overlap Ptr_Src
+ *             only when Ptr_Src is at least COBS_INPLACE_OFFSET(Len) bytes after it.
+ * @return   : Number of encoded bytes, none of them is COBS_DELIMITER.
+ * @details  : Every byte is read before its encoded position is written, and an encoded byte
+ *             lands at most one byte per started block after its source. With the source that
+ *             far ahead, the encoder never overwrites a byte it has not read yet.
+ **/
+static inline uint32_t Cobs_Encode(const uint8_t *Ptr_Src, uint32_t Len, uint8_t *Ptr_Dst)
+{
+	/* Where the code byte of the current block goes, filled in once the block ends */
+	uint32_t Loc_CodeIndex = 0;
+	uint32_t Loc_Out = 1;
+	uint8_t Loc_Code = 1;
+	uint32_t Loc_idx;
+
+	for (Loc_idx = 0; Loc_idx < Len; Loc_idx++)
+	{
+		if (Ptr_Src[Loc_idx] == 0)
+		{
+			Ptr_Dst[Loc_CodeIndex] = Loc_Code;
+			Loc_CodeIndex = Loc_Out++;
+			Loc_Code = 1;
+		}
+		else
+		{
+			Ptr_Dst[Loc_Out++] = Ptr_Src[Loc_idx];
+			Loc_Code++;
+			if (Loc_Code == COBS_BLOCK_MAX)
+			{
+				/* Full block, no implicit zero after it */
+				Ptr_Dst[Loc_CodeIndex] = Loc_Code;
+				Loc_CodeIndex = Loc_Out++;
+				Loc_Code = 1;
+			}
+		}
+	}
+	Ptr_Dst[Loc_CodeIndex] = Loc_Code;
+
+	return Loc_Out;
+}
+
+#endif /* COBS_H_ */
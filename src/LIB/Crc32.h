@@ -0,0 +1,141 @@
+/*
+ ============================================================================
+ Name        : Crc32.h
+ Author      : Omar Medhat Mohamed
+ Description : Software CRC-32/MPEG-2, the frame check computed by the CRC unit
+ Date        : 24/6/2024
+ ============================================================================
+ */
+#ifndef CRC32_H_
+#define CRC32_H_
+/*******************************************************************************
+ *                                Includes	                                  *
+ *******************************************************************************/
+#include "LIB/std_types.h"
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+/* Polynomial of the STM32 CRC unit, shifted MSB first, no reflection and no final XOR */
+#define CRC32_POLYNOMIAL		0x04C11DB7UL
+/* Value of the CRC unit after a reset, start value of every frame check */
+#define CRC32_INITIAL			0xFFFFFFFFUL
+/* CRC32_Bitwise of "123456789" from CRC32_INITIAL */
+#define CRC32_CHECK				0x0376E6E7UL
+/*******************************************************************************
+ *                        	  Types Declaration                                 *
+ *******************************************************************************/
+/**
+ * @brief    : Lookup tables of the table driven variants, filled by Crc32_InitTables.
+ * @note     : Table[0] alone serves Crc32_Bytewise, Table[k] advances a byte by k more bytes
+ *             of zeros so Crc32_SliceBy8 folds eight bytes per step. 8 KiB, host side only.
+ **/
+typedef struct
+{
+	uint32_t Table[8][256];
+}
+Crc32_Tables_t;
+/*******************************************************************************
+ *                  	    Functions Implementation                           *
+ *******************************************************************************/
+/**
+ * @brief    : Updates a CRC one bit at a time, no table.
+ * @param[in]: Crc      CRC so far, CRC32_INITIAL for a new frame.
+ * @param[in]: Ptr_Data Bytes to add.
+ * @param[in]: Len      Number of bytes to add.
+ * @return   : Updated CRC.
+ **/
+static inline uint32_t Crc32_Bitwise(uint32_t Crc, const uint8_t *Ptr_Data, uint32_t Len)
+{
+	uint32_t Loc_idx;
+	uint8_t Loc_Bit;
+
+	for (Loc_idx = 0; Loc_idx < Len; Loc_idx++)
+	{
+		Crc ^= (uint32_t)Ptr_Data[Loc_idx] << 24;
+		for (Loc_Bit = 0; Loc_Bit < 8; Loc_Bit++)
+		{
+			Crc = (Crc & 0x80000000UL) ? ((Crc << 1) ^ CRC32_POLYNOMIAL) : (Crc << 1);
+		}
+	}
+
+	return Crc;
+}
+
+/**
+ * @brief    : Fills the lookup tables of Crc32_Bytewise and Crc32_SliceBy8.
+ * @param[out]: Ptr_Tables Tables to fill.
+ **/
+static inline void Crc32_InitTables(Crc32_Tables_t *Ptr_Tables)
+{
+	uint32_t Loc_Value;
+	uint32_t Loc_Slice;
+
+	for (Loc_Value = 0; Loc_Value < 256; Loc_Value++)
+	{
+		uint8_t Loc_Byte = (uint8_t)Loc_Value;
+
+		/* The CRC of a single byte from zero is the byte shifted through the polynomial */
+		Ptr_Tables->Table[0][Loc_Value] = Crc32_Bitwise(0, &Loc_Byte, 1);
+	}
+	for (Loc_Slice = 1; Loc_Slice < 8; Loc_Slice++)
+	{
+		for (Loc_Value = 0; Loc_Value < 256; Loc_Value++)
+		{
+			uint32_t Loc_Prev = Ptr_Tables->Table[Loc_Slice - 1][Loc_Value];
+
+			Ptr_Tables->Table[Loc_Slice][Loc_Value] = (Loc_Prev << 8) ^ Ptr_Tables->Table[0][Loc_Prev >> 24];
+		}
+	}
+}
+
+/**
+ * @brief    : Updates a CRC one byte at a time through Table[0].
+ * @param[in]: Ptr_Tables Tables filled by Crc32_InitTables.
+ * @param[in]: Crc        CRC so far, CRC32_INITIAL for a new frame.
+ * @param[in]: Ptr_Data   Bytes to add.
+ * @param[in]: Len        Number of bytes to add.
+ * @return   : Updated CRC.
+ **/
+static inline uint32_t Crc32_Bytewise(const Crc32_Tables_t *Ptr_Tables, uint32_t Crc, const uint8_t *Ptr_Data, uint32_t Len)
+{
+	uint32_t Loc_idx;
+
+	for (Loc_idx = 0; Loc_idx < Len; Loc_idx++)
+	{
+		Crc = (Crc << 8) ^ Ptr_Tables->Table[0][(Crc >> 24) ^ Ptr_Data[Loc_idx]];
+	}
+
+	return Crc;
+}
+
+/**
+ * @brief    : Updates a CRC eight bytes at a time, slice-by-8.
+ * @param[in]: Ptr_Tables Tables filled by Crc32_InitTables.
+ * @param[in]: Crc        CRC so far, CRC32_INITIAL for a new frame.
+ * @param[in]: Ptr_Data   Bytes to add, no alignment needed.
+ * @param[in]: Len        Number of bytes to add.
+ * @return   : Updated CRC.
+ * @details  : The first four bytes of a step are XORed into the CRC, then every byte of the
+ *             step is looked up in the table of its distance to the end of the step. The
+ *             eight lookups are independent, the tail goes through Crc32_Bytewise.
+ **/
+static inline uint32_t Crc32_SliceBy8(const Crc32_Tables_t *Ptr_Tables, uint32_t Crc, const uint8_t *Ptr_Data, uint32_t Len)
+{
+	const uint32_t (*Loc_T)[256] = Ptr_Tables->Table;
+
+	while (Len >= 8)
+	{
+		Crc ^= ((uint32_t)Ptr_Data[0] << 24) | ((uint32_t)Ptr_Data[1] << 16) |
+			   ((uint32_t)Ptr_Data[2] << 8) | (uint32_t)Ptr_Data[3];
+		Crc = Loc_T[7][Crc >> 24] ^ Loc_T[6][(Crc >> 16) & 0xFF] ^
+			  Loc_T[5][(Crc >> 8) & 0xFF] ^ Loc_T[4][Crc & 0xFF] ^
+			  Loc_T[3][Ptr_Data[4]] ^ Loc_T[2][Ptr_Data[5]] ^
+			  Loc_T[1][Ptr_Data[6]] ^ Loc_T[0][Ptr_Data[7]];
+		Ptr_Data += 8;
+		Len -= 8;
+	}
+
+	return Crc32_Bytewise(Ptr_Tables, Crc, Ptr_Data, Len);
+}
+
+#endif /* CRC32_H_ */
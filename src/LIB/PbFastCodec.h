@@ -0,0 +1,260 @@
+/*
+ ============================================================================
+ Name        : PbFastCodec.h
+ Author      : Omar Medhat Mohamed
+ Description : Straight-line encoder and decoder of flat nanopb messages, built
+               from the *_FIELDLIST X-macros of the generated header
+ Date        : 1/7/2024
+ ============================================================================
+ */
+#ifndef PBFASTCODEC_H_
+#define PBFASTCODEC_H_
+/*******************************************************************************
+ *                                Includes	                                  *
+ *******************************************************************************/
+#include <pb.h>
+#include <pb_decode.h>
+#include "LIB/std_types.h"
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+/*
+ * A flat message only has STATIC REQUIRED fields of the types below. PB_FAST_CODEC_DEFINE(Msg)
+ * expands Msg_FIELDLIST into two functions with one unrolled step per field:
+ *
+ *   bool     PbFast_Decode_Msg(const uint8_t *Ptr_Buffer, uint32_t Len, void *Ptr_Msg)
+ *   uint32_t PbFast_Encode_Msg(const void *Ptr_Msg, uint8_t *Ptr_Buffer)
+ *
+ * The decoder expects the fields in field number order, each once, as every encoder writes
+ * them. Anything else (another order, unknown or repeated fields, long varints, a value too
+ * large for its field) goes to pb_decode, so the result is always the one of pb_decode.
+ * The encoder writes the bytes of pb_encode into a buffer of at least Msg_size bytes.
+ * A field of any other type or kind does not compile.
+ */
+
+/* Wire type of each field type */
+#define PB_FAST_WT_BOOL			PB_WT_VARINT
+#define PB_FAST_WT_UINT32		PB_WT_VARINT
+#define PB_FAST_WT_UENUM		PB_WT_VARINT
+#define PB_FAST_WT_SINT32		PB_WT_VARINT
+#define PB_FAST_WT_FIXED32		PB_WT_32BIT
+
+/* Field key, a varint of the field number and the wire type */
+#define PB_FAST_KEY(Tag, Ltype)	(((uint32_t)(Tag) << 3) | PB_FAST_WT_##Ltype)
+
+/* Only STATIC REQUIRED fields are flat, any other kind leaves this undefined */
+#define PB_FAST_KIND_STATIC_REQUIRED
+
+/* Decode steps, expressions reading one value at Loc_Ptr into Dest, false to fall back */
+#define PB_FAST_DECODE_UINT32(Dest)		(PbFast_ReadVarint(&Loc_Ptr, Loc_End, &Loc_Value) && \
+										 PbFast_FitsUnsigned(Loc_Value, sizeof(Dest)) && ((Dest = Loc_Value), true))
+#define PB_FAST_DECODE_UENUM(Dest)		PB_FAST_DECODE_UINT32(Dest)
+#define PB_FAST_DECODE_BOOL(Dest)		(PbFast_ReadVarint(&Loc_Ptr, Loc_End, &Loc_Value) && ((Dest = (Loc_Value != 0)), true))
+#define PB_FAST_DECODE_SINT32(Dest)		(PbFast_ReadVarint(&Loc_Ptr, Loc_End, &Loc_Value) && \
+										 PbFast_FitsSigned(PbFast_ZigZagDecode(Loc_Value), sizeof(Dest)) && \
+										 ((Dest = PbFast_ZigZagDecode(Loc_Value)), true))
+#define PB_FAST_DECODE_FIXED32(Dest)	(PbFast_ReadFixed32(&Loc_Ptr, Loc_End, &Loc_Value) && ((Dest = Loc_Value), true))
+
+/* Encode steps, write one value at Ptr and return the end of it */
+#define PB_FAST_ENCODE_UINT32(Ptr, Value)	PbFast_WriteVarint(Ptr, (uint32_t)(Value))
+#define PB_FAST_ENCODE_UENUM(Ptr, Value)	PbFast_WriteVarint(Ptr, (uint32_t)(Value))
+#define PB_FAST_ENCODE_BOOL(Ptr, Value)		PbFast_WriteVarint(Ptr, (Value) ? 1U : 0U)
+#define PB_FAST_ENCODE_SINT32(Ptr, Value)	PbFast_WriteVarint(Ptr, PbFast_ZigZagEncode((int32_t)(Value)))
+#define PB_FAST_ENCODE_FIXED32(Ptr, Value)	PbFast_WriteFixed32(Ptr, (uint32_t)(Value))
+
+/* One step per field, X of the FIELDLIST. Msg is the message pointer passed as its first argument */
+#define PB_FAST_DECODE_FIELD(Msg, Atype, Htype, Ltype, Name, Tag) \
+	PB_FAST_KIND_##Atype##_##Htype \
+	&& PbFast_ReadKey(&Loc_Ptr, Loc_End, PB_FAST_KEY(Tag, Ltype)) && PB_FAST_DECODE_##Ltype(Msg->Name)
+#define PB_FAST_ENCODE_FIELD(Msg, Atype, Htype, Ltype, Name, Tag) \
+	PB_FAST_KIND_##Atype##_##Htype \
+	Loc_Ptr = PbFast_WriteVarint(Loc_Ptr, PB_FAST_KEY(Tag, Ltype)); \
+	Loc_Ptr = PB_FAST_ENCODE_##Ltype(Loc_Ptr, Msg->Name);
+
+/* Defines PbFast_Decode_Msg and PbFast_Encode_Msg, see above */
+#define PB_FAST_CODEC_DEFINE(Msg) \
+	static inline bool PbFast_Decode_##Msg(const uint8_t *Ptr_Buffer, uint32_t Len, void *Ptr_Msg) \
+	{ \
+		Msg *Loc_Msg = (Msg *)Ptr_Msg; \
+		const uint8_t *Loc_Ptr = Ptr_Buffer; \
+		const uint8_t *Loc_End = Ptr_Buffer + Len; \
+		uint32_t Loc_Value = 0; \
+		bool Loc_Ok = true Msg##_FIELDLIST(PB_FAST_DECODE_FIELD, Loc_Msg) && (Loc_Ptr == Loc_End); \
+		\
+		if (!Loc_Ok) \
+		{ \
+			pb_istream_t Loc_Stream = pb_istream_from_buffer(Ptr_Buffer, Len); \
+			\
+			Loc_Ok = pb_decode(&Loc_Stream, Msg##_fields, Ptr_Msg); \
+		} \
+		return Loc_Ok; \
+	} \
+	static inline uint32_t PbFast_Encode_##Msg(const void *Ptr_Msg, uint8_t *Ptr_Buffer) \
+	{ \
+		const Msg *Loc_Msg = (const Msg *)Ptr_Msg; \
+		uint8_t *Loc_Ptr = Ptr_Buffer; \
+		\
+		Msg##_FIELDLIST(PB_FAST_ENCODE_FIELD, Loc_Msg) \
+		return (uint32_t)(Loc_Ptr - Ptr_Buffer); \
+	}
+/*******************************************************************************
+ *                  	    Functions Implementation                           *
+ *******************************************************************************/
+/**
+ * @brief    : Consumes a field key when it is the expected one.
+ * @param[in]: Ptr_Ptr Read position, moved past the key.
+ * @param[in]: Ptr_End End of the message.
+ * @param[in]: Key     Expected key, PB_FAST_KEY of the field.
+ * @return   : false if the next bytes are not the key, the position is then unchanged.
+ * @details  : Key is a constant, the compiler keeps only the one or two byte comparison.
+ **/
+static inline bool PbFast_ReadKey(const uint8_t **Ptr_Ptr, const uint8_t *Ptr_End, uint32_t Key)
+{
+	const uint8_t *Loc_Ptr = *Ptr_Ptr;
+	bool Loc_Match = false;
+
+	if (Key < 0x80)
+	{
+		Loc_Match = (Loc_Ptr < Ptr_End) && (Loc_Ptr[0] == Key);
+		*Ptr_Ptr += Loc_Match ? 1 : 0;
+	}
+	else if (Key < 0x4000)
+	{
+		Loc_Match = ((Ptr_End - Loc_Ptr) >= 2) && (Loc_Ptr[0] == ((Key & 0x7F) | 0x80)) && (Loc_Ptr[1] == (Key >> 7));
+		*Ptr_Ptr += Loc_Match ? 2 : 0;
+	}
+
+	return Loc_Match;
+}
+
+/**
+ * @brief    : Reads a varint of at most 32 bits.
+ * @param[in]: Ptr_Ptr   Read position, moved past the varint.
+ * @param[in]: Ptr_End   End of the message.
+ * @param[out]: Ptr_Value Value read.
+ * @return   : false if the varint is cut short or does not fit 32 bits in five bytes.
+ **/
+static inline bool PbFast_ReadVarint(const uint8_t **Ptr_Ptr, const uint8_t *Ptr_End, uint32_t *Ptr_Value)
+{
+	const uint8_t *Loc_Ptr = *Ptr_Ptr;
+	uint32_t Loc_Value = 0;
+	uint8_t Loc_Shift = 0;
+	bool Loc_Done = false;
+
+	/* Pins, ports and small counts take the first round only. The fifth byte has four bits left */
+	while ((Loc_Shift < 35) && (Loc_Ptr < Ptr_End) && !Loc_Done && ((Loc_Shift < 28) || (*Loc_Ptr <= 0x0F)))
+	{
+		Loc_Value |= (uint32_t)(*Loc_Ptr & 0x7F) << Loc_Shift;
+		Loc_Done = (*Loc_Ptr++ < 0x80);
+		Loc_Shift += 7;
+	}
+	if (Loc_Done)
+	{
+		*Ptr_Value = Loc_Value;
+		*Ptr_Ptr = Loc_Ptr;
+	}
+
+	return Loc_Done;
+}
+
+/**
+ * @brief    : Reads a little endian fixed32 value.
+ * @param[in]: Ptr_Ptr   Read position, moved past the value.
+ * @param[in]: Ptr_End   End of the message.
+ * @param[out]: Ptr_Value Value read.
+ * @return   : false if the message ends first.
+ **/
+static inline bool PbFast_ReadFixed32(const uint8_t **Ptr_Ptr, const uint8_t *Ptr_End, uint32_t *Ptr_Value)
+{
+	const uint8_t *Loc_Ptr = *Ptr_Ptr;
+	bool Loc_Ok = ((Ptr_End - Loc_Ptr) >= 4);
+
+	if (Loc_Ok)
+	{
+		*Ptr_Value = (uint32_t)Loc_Ptr[0] | ((uint32_t)Loc_Ptr[1] << 8) |
+					 ((uint32_t)Loc_Ptr[2] << 16) | ((uint32_t)Loc_Ptr[3] << 24);
+		*Ptr_Ptr = Loc_Ptr + 4;
+	}
+
+	return Loc_Ok;
+}
+
+/**
+ * @brief    : Checks an unsigned value against the size of its field, as pb_decode does.
+ * @param[in]: Value Decoded value.
+ * @param[in]: Size  Size of the field in bytes, a constant.
+ * @return   : true if the field holds the value.
+ **/
+static inline bool PbFast_FitsUnsigned(uint32_t Value, uint32_t Size)
+{
+	return (Size >= 4) || (((uint64_t)Value >> (8 * Size)) == 0);
+}
+
+/**
+ * @brief    : Checks a signed value against the size of its field, as pb_decode does.
+ * @param[in]: Value Decoded value.
+ * @param[in]: Size  Size of the field in bytes, a constant.
+ * @return   : true if the field holds the value.
+ **/
+static inline bool PbFast_FitsSigned(int32_t Value, uint32_t Size)
+{
+	int64_t Loc_Limit = (int64_t)1 << ((8 * Size) - 1);
+
+	return (Size >= 4) || ((Value >= -Loc_Limit) && (Value < Loc_Limit));
+}
+
+/**
+ * @brief    : Value of a sint32 field from its varint.
+ * @param[in]: Value ZigZag encoded value.
+ * @return   : Signed value.
+ **/
+static inline int32_t PbFast_ZigZagDecode(uint32_t Value)
+{
+	return (int32_t)(Value >> 1) ^ -(int32_t)(Value & 1);
+}
+
+/**
+ * @brief    : Varint of a sint32 field, small magnitudes of either sign stay short.
+ * @param[in]: Value Signed value.
+ * @return   : ZigZag encoded value.
+ **/
+static inline uint32_t PbFast_ZigZagEncode(int32_t Value)
+{
+	return ((uint32_t)Value << 1) ^ (uint32_t)(Value >> 31);
+}
+
+/**
+ * @brief    : Writes a varint.
+ * @param[in]: Ptr_Buffer Write position.
+ * @param[in]: Value      Value to write.
+ * @return   : Position after the varint.
+ **/
+static inline uint8_t *PbFast_WriteVarint(uint8_t *Ptr_Buffer, uint32_t Value)
+{
+	while (Value >= 0x80)
+	{
+		*Ptr_Buffer++ = (uint8_t)(Value | 0x80);
+		Value >>= 7;
+	}
+	*Ptr_Buffer++ = (uint8_t)Value;
+
+	return Ptr_Buffer;
+}
+
+/**
+ * @brief    : Writes a little endian fixed32 value.
+ * @param[in]: Ptr_Buffer Write position.
+ * @param[in]: Value      Value to write.
+ * @return   : Position after the value.
+ **/
+static inline uint8_t *PbFast_WriteFixed32(uint8_t *Ptr_Buffer, uint32_t Value)
+{
+	Ptr_Buffer[0] = (uint8_t)Value;
+	Ptr_Buffer[1] = (uint8_t)(Value >> 8);
+	Ptr_Buffer[2] = (uint8_t)(Value >> 16);
+	Ptr_Buffer[3] = (uint8_t)(Value >> 24);
+
+	return Ptr_Buffer + 4;
+}
+
+#endif /* PBFASTCODEC_H_ */
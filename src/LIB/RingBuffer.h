@@ -0,0 +1,188 @@
+/*
+ ============================================================================
+ Name        : RingBuffer.h
+ Author      : Omar Medhat Mohamed
+ Description : Lock-free single-producer/single-consumer byte ring
+ Date        : 25/5/2024
+ ============================================================================
+ */
+#ifndef RINGBUFFER_H_
+#define RINGBUFFER_H_
+/*******************************************************************************
+ *                                Includes	                                  *
+ *******************************************************************************/
+#include <string.h>
+#include "LIB/std_types.h"
+#include "LIB/Error.h"
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+/* Head and Tail are only written by one side each, loads/stores are ordered so the
+ * data bytes are visible before the index that publishes them */
+#define RING_LOAD_ACQUIRE(Ptr_Index)          __atomic_load_n((Ptr_Index), __ATOMIC_ACQUIRE)
+#define RING_STORE_RELEASE(Ptr_Index, Value)  __atomic_store_n((Ptr_Index), (Value), __ATOMIC_RELEASE)
+/*******************************************************************************
+ *                        	  Types Declaration                                 *
+ *******************************************************************************/
+/**
+ * @brief    : Byte ring shared by exactly one producer and one consumer (e.g. ISR and main loop).
+ * @note     : Head and Tail run freely and wrap at 2^32, Size must be a power of two.
+ *             Head is written by the producer only, Tail by the consumer only.
+ **/
+typedef struct
+{
+	uint8_t *Buffer;
+	uint32_t Size;
+	uint32_t Head;
+	uint32_t Tail;
+}
+RingBuffer_t;
+/*******************************************************************************
+ *                  	    Functions Implementation                           *
+ *******************************************************************************/
+/**
+ * @brief    : Initializes an empty ring over a user buffer.
+ * @param[in]: Ptr_Ring   Pointer to the ring.
+ * @param[in]: Ptr_Buffer Storage of the ring.
+ * @param[in]: Size       Size of the storage, must be a power of two.
+ * @return   : Error_enumStatus_t Error status indicating the success or failure of the operation.
+ **/
+static inline Error_enumStatus_t RingBuffer_Init(RingBuffer_t *Ptr_Ring, uint8_t *Ptr_Buffer, uint32_t Size)
+{
+	Error_enumStatus_t Loc_enumReturnStatus = Status_enumOk;
+
+	if ((Ptr_Ring == NULL) || (Ptr_Buffer == NULL))
+	{
+		Loc_enumReturnStatus = Status_enumNULLPointer;
+	}
+	else if ((Size == 0) || ((Size & (Size - 1)) != 0))
+	{
+		Loc_enumReturnStatus = Status_enumWrongInput;
+	}
+	else
+	{
+		Ptr_Ring->Buffer = Ptr_Buffer;
+		Ptr_Ring->Size = Size;
+		Ptr_Ring->Head = 0;
+		Ptr_Ring->Tail = 0;
+	}
+
+	return Loc_enumReturnStatus;
+}
+
+/**
+ * @brief    : Number of bytes waiting in the ring, callable from both sides.
+ **/
+static inline uint32_t RingBuffer_GetUsed(RingBuffer_t *Ptr_Ring)
+{
+	return RING_LOAD_ACQUIRE(&Ptr_Ring->Head) - RING_LOAD_ACQUIRE(&Ptr_Ring->Tail);
+}
+
+/**
+ * @brief    : Number of bytes that can be written without overwriting unread data.
+ **/
+static inline uint32_t RingBuffer_GetFree(RingBuffer_t *Ptr_Ring)
+{
+	return Ptr_Ring->Size - RingBuffer_GetUsed(Ptr_Ring);
+}
+
+/**
+ * @brief    : Producer side, copies a block into the ring.
+ * @param[in]: Ptr_Ring Pointer to the ring.
+ * @param[in]: Ptr_Data Bytes to write.
+ * @param[in]: Len      Number of bytes to write.
+ * @return   : Status_enumOk if the whole block was written, Status_enumBusyState if there is not
+ *             enough free space, in which case nothing is written.
+ * @details  : Never blocks. The block is published at once, so the consumer never sees part of it.
+ **/
+static inline Error_enumStatus_t RingBuffer_Write(RingBuffer_t *Ptr_Ring, const uint8_t *Ptr_Data, uint32_t Len)
+{
+	Error_enumStatus_t Loc_enumReturnStatus = Status_enumOk;
+	uint32_t Loc_Head = Ptr_Ring->Head;
+	uint32_t Loc_Free = Ptr_Ring->Size - (Loc_Head - RING_LOAD_ACQUIRE(&Ptr_Ring->Tail));
+
+	if (Len > Loc_Free)
+	{
+		Loc_enumReturnStatus = Status_enumBusyState;
+	}
+	else
+	{
+		uint32_t Loc_Index = Loc_Head & (Ptr_Ring->Size - 1);
+		uint32_t Loc_First = Ptr_Ring->Size - Loc_Index;
+
+		if (Loc_First > Len)
+		{
+			Loc_First = Len;
+		}
+		/* Copy up to the end of the storage, then wrap to its start */
+		memcpy(&Ptr_Ring->Buffer[Loc_Index], Ptr_Data, Loc_First);
+		memcpy(Ptr_Ring->Buffer, &Ptr_Data[Loc_First], Len - Loc_First);
+		RING_STORE_RELEASE(&Ptr_Ring->Head, Loc_Head + Len);
+	}
+
+	return Loc_enumReturnStatus;
+}
+
+/**
+ * @brief    : Consumer side, copies up to MaxLen bytes out of the ring.
+ * @param[in]: Ptr_Ring  Pointer to the ring.
+ * @param[out]: Ptr_Data Destination buffer.
+ * @param[in]: MaxLen    Size of the destination buffer.
+ * @return   : Number of bytes read.
+ **/
+static inline uint32_t RingBuffer_Read(RingBuffer_t *Ptr_Ring, uint8_t *Ptr_Data, uint32_t MaxLen)
+{
+	uint32_t Loc_Tail = Ptr_Ring->Tail;
+	uint32_t Loc_Len = RING_LOAD_ACQUIRE(&Ptr_Ring->Head) - Loc_Tail;
+	uint32_t Loc_Index = Loc_Tail & (Ptr_Ring->Size - 1);
+	uint32_t Loc_First;
+
+	if (Loc_Len > MaxLen)
+	{
+		Loc_Len = MaxLen;
+	}
+	Loc_First = Ptr_Ring->Size - Loc_Index;
+	if (Loc_First > Loc_Len)
+	{
+		Loc_First = Loc_Len;
+	}
+	memcpy(Ptr_Data, &Ptr_Ring->Buffer[Loc_Index], Loc_First);
+	memcpy(&Ptr_Data[Loc_First], Ptr_Ring->Buffer, Loc_Len - Loc_First);
+	RING_STORE_RELEASE(&Ptr_Ring->Tail, Loc_Tail + Loc_Len);
+
+	return Loc_Len;
+}
+
+/**
+ * @brief    : Consumer side, gives the longest run of unread bytes that is contiguous in memory.
+ * @param[in]: Ptr_Ring  Pointer to the ring.
+ * @param[out]: Ptr_Data Set to the first unread byte.
+ * @return   : Number of contiguous unread bytes, the bytes stay in the ring until RingBuffer_Consume.
+ * @details  : Lets a transmitter send straight out of the ring storage without copying.
+ **/
+static inline uint32_t RingBuffer_Peek(RingBuffer_t *Ptr_Ring, uint8_t **Ptr_Data)
+{
+	uint32_t Loc_Tail = Ptr_Ring->Tail;
+	uint32_t Loc_Len = RING_LOAD_ACQUIRE(&Ptr_Ring->Head) - Loc_Tail;
+	uint32_t Loc_Index = Loc_Tail & (Ptr_Ring->Size - 1);
+
+	if (Loc_Len > (Ptr_Ring->Size - Loc_Index))
+	{
+		Loc_Len = Ptr_Ring->Size - Loc_Index;
+	}
+	*Ptr_Data = &Ptr_Ring->Buffer[Loc_Index];
+
+	return Loc_Len;
+}
+
+/**
+ * @brief    : Consumer side, releases bytes returned by RingBuffer_Peek.
+ * @param[in]: Ptr_Ring Pointer to the ring.
+ * @param[in]: Len      Number of bytes to release.
+ **/
+static inline void RingBuffer_Consume(RingBuffer_t *Ptr_Ring, uint32_t Len)
+{
+	RING_STORE_RELEASE(&Ptr_Ring->Tail, Ptr_Ring->Tail + Len);
+}
+
+#endif /* RINGBUFFER_H_ */
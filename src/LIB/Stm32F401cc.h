@@ -10,6 +10,49 @@
 #ifndef STM32F401CC_H_
 #define STM32F401CC_H_
 
+/*******************************************************************************
+ *                                Includes	                                  *
+ *******************************************************************************/
+#include "LIB/std_types.h"
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+#define PERIPHERAL_BASE_ADDRESS 0x40000000UL
+#define PERIPHERAL_REGION_SIZE  0x00080000UL
+/* Internal peripherals of the core: DWT, SysTick, NVIC, SCB and the debug registers */
+#define CORE_PERIPHERAL_BASE_ADDRESS 0xE0000000UL
+#define CORE_PERIPHERAL_REGION_SIZE  0x00010000UL
+
+/**
+ * In native builds the peripheral registers live in a simulated register block
+ * provided by the host environment instead of the real memory mapped region.
+ */
+#ifdef NATIVE_BUILD
+extern uint32_t Sim_PeripheralMemory[PERIPHERAL_REGION_SIZE / 4];
+extern uint32_t Sim_CorePeripheralMemory[CORE_PERIPHERAL_REGION_SIZE / 4];
+#define PERIPHERAL_ADDRESS(Address) ((void *)((uint8_t *)Sim_PeripheralMemory + ((Address) - PERIPHERAL_BASE_ADDRESS)))
+#define CORE_PERIPHERAL_ADDRESS(Address) ((void *)((uint8_t *)Sim_CorePeripheralMemory + ((Address) - CORE_PERIPHERAL_BASE_ADDRESS)))
+#else
+#define PERIPHERAL_ADDRESS(Address) ((void *)(Address))
+#define CORE_PERIPHERAL_ADDRESS(Address) ((void *)(Address))
+#endif
+
+/**
+ * Accesses to registers whose read or write has a side effect in hardware (USART DR,
+ * GPIO BSRR and IDR, RCC ready and clock switch status, SysTick VAL, DWT CYCCNT,
+ * NVIC set/clear and STIR, CRC DR and CR). The firmware simulator (NATIVE_SIM) models
+ * the side effect, every other build accesses the register directly.
+ */
+#ifdef NATIVE_SIM
+uint32_t Sim_ReadRegister(volatile uint32_t *Ptr_Register);
+void Sim_WriteRegister(volatile uint32_t *Ptr_Register, uint32_t Value);
+#define REG_READ(Register)         Sim_ReadRegister(&(Register))
+#define REG_WRITE(Register, Value) Sim_WriteRegister(&(Register), (Value))
+#else
+#define REG_READ(Register)         (Register)
+#define REG_WRITE(Register, Value) ((Register) = (Value))
+#endif
+
 /*******************************************************************************
  *                        	  Types Declaration                                 *
  *******************************************************************************/
@@ -31,14 +31,13 @@ typedef unsigned char boolean;
     #define NULL    ((void*)0)
 #endif
 
-typedef unsigned char         uint8_t;          /*           0 .. 255              */
-typedef signed char           sint8_t;          /*        -128 .. +127             */
-typedef unsigned short        uint16_t;         /*           0 .. 65535            */
-typedef signed short          sint16_t;         /*      -32768 .. +32767           */
-typedef unsigned long         uint32_t;         /*           0 .. 4294967295       */
-typedef signed long           sint32_t;         /* -2147483648 .. +2147483647      */
-typedef unsigned long long    uint64_t;         /*       0 .. 18446744073709551615  */
-typedef signed long long      sint64_t;         /* -9223372036854775808 .. 9223372036854775807 */
+/* Fixed width unsigned types are taken from the compiler so they match on every target */
+#include <stdint.h>
+
+typedef int8_t                sint8_t;          /*        -128 .. +127             */
+typedef int16_t               sint16_t;         /*      -32768 .. +32767           */
+typedef int32_t               sint32_t;         /* -2147483648 .. +2147483647      */
+typedef int64_t               sint64_t;         /* -9223372036854775808 .. 9223372036854775807 */
 typedef float                 float32_t;
 typedef double                float64_t;
 
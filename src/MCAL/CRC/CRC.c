@@ -0,0 +1,79 @@
+/*
+ ============================================================================
+ Name        : CRC.c
+ Author      : Omar Medhat Mohamed
+ Description : Source File for the CRC calculation unit Driver
+ Date        : 24/6/2024
+ ============================================================================
+ */
+
+/*******************************************************************************
+ *                                Includes	                                  *
+ *******************************************************************************/
+/* Include the header file for CRC driver */
+#include "MCAL/CRC/CRC.h"
+#include "LIB/Crc32.h"
+/*******************************************************************************
+ *                             Definitions                                      *
+ *******************************************************************************/
+#define CRC_BASE_ADDRESS             0x40023000 /* Base address of CRC peripheral */
+#define CRC_CR_RESET_MASK            0x00000001 /* Loads 0xFFFFFFFF into the data register */
+/*******************************************************************************
+ *                        	  Types Declaration                                 *
+ *******************************************************************************/
+typedef struct
+{
+    /* Data register, a write adds a word, a read gives the CRC so far */
+    uint32_t CRC_DR;
+    /* Independent data register, general purpose byte */
+    uint32_t CRC_IDR;
+    /* Control register */
+    uint32_t CRC_CR;
+} CRC_PERI_t;
+/*******************************************************************************
+ *                              Variables		                                *
+ *******************************************************************************/
+/* Pointer to CRC peripheral */
+volatile CRC_PERI_t *const CRC_Unit = (volatile CRC_PERI_t *)PERIPHERAL_ADDRESS(CRC_BASE_ADDRESS);
+
+/*******************************************************************************
+ *                             Implementation   				                *
+ *******************************************************************************/
+/*
+ * @brief    : Calculate the CRC of a buffer with the CRC unit
+ * @param[in]: Ptr_Data: Bytes to check, no alignment needed
+ * @param[in]: Len: Number of bytes
+ * @param[out]: Ptr_Crc: CRC-32/MPEG-2 of the bytes, the value of Crc32_Bitwise in LIB/Crc32.h
+ * @return   : Error_enumStatus_t: Status of the operation
+ * @details  : The unit takes whole words, most significant byte first, so the bytes are fed in
+ *             the order they are sent. The last 1 to 3 bytes are added in software from the value
+ *             the unit reached. The unit clock must be on (Set_Clock_ON(CRC)). Not reentrant,
+ *             every call must come from the same context.
+ */
+Error_enumStatus_t CRC_Calculate(const uint8_t *Ptr_Data, uint32_t Len, uint32_t *Ptr_Crc)
+{
+    /* Local Variable to store error status */
+    Error_enumStatus_t Loc_enumReturnStatus = Status_enumOk;
+    uint32_t Loc_Words = Len / 4;
+    uint32_t Loc_idx;
+
+    if (((Ptr_Data == NULL) && (Len != 0)) || (Ptr_Crc == NULL))
+    {
+        Loc_enumReturnStatus = Status_enumNULLPointer;
+    }
+    else
+    {
+        REG_WRITE(CRC_Unit->CRC_CR, CRC_CR_RESET_MASK);
+        for (Loc_idx = 0; Loc_idx < Loc_Words; Loc_idx++)
+        {
+            /* Big endian assembly, the compiler turns it into a load and a REV */
+            REG_WRITE(CRC_Unit->CRC_DR, ((uint32_t)Ptr_Data[0] << 24) | ((uint32_t)Ptr_Data[1] << 16) |
+                                        ((uint32_t)Ptr_Data[2] << 8) | (uint32_t)Ptr_Data[3]);
+            Ptr_Data += 4;
+        }
+        /* The read waits for the last word to be processed */
+        *Ptr_Crc = Crc32_Bitwise(REG_READ(CRC_Unit->CRC_DR), Ptr_Data, Len % 4);
+    }
+    /*Return error status*/
+    return Loc_enumReturnStatus;
+}
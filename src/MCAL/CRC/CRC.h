@@ -0,0 +1,32 @@
+/*
+ ============================================================================
+ Name        : CRC.h
+ Author      : Omar Medhat Mohamed
+ Description : Header File for the CRC calculation unit Driver
+ Date        : 24/6/2024
+ ============================================================================
+ */
+#ifndef CRC_H_
+#define CRC_H_
+/*******************************************************************************
+ *                                Includes	                                  *
+ *******************************************************************************/
+#include  	"LIB/std_types.h"
+#include 	"LIB/Error.h"
+#include	"LIB/Stm32F401cc.h"
+/*******************************************************************************
+ *                  	    Functions Prototypes                               *
+ *******************************************************************************/
+/*
+ * @brief    : Calculate the CRC of a buffer with the CRC unit
+ * @param[in]: Ptr_Data: Bytes to check, no alignment needed
+ * @param[in]: Len: Number of bytes
+ * @param[out]: Ptr_Crc: CRC-32/MPEG-2 of the bytes, the value of Crc32_Bitwise in LIB/Crc32.h
+ * @return   : Error_enumStatus_t: Status of the operation
+ * @details  : The unit takes whole words, most significant byte first, so the bytes are fed in
+ *             the order they are sent. The last 1 to 3 bytes are added in software from the value
+ *             the unit reached. The unit clock must be on (Set_Clock_ON(CRC)). Not reentrant,
+ *             every call must come from the same context.
+ */
+Error_enumStatus_t CRC_Calculate(const uint8_t *Ptr_Data, uint32_t Len, uint32_t *Ptr_Crc);
+#endif
@@ -0,0 +1,275 @@
+/*
+ ============================================================================
+ Name        : DMA.c
+ Author      : Omar Medhat Mohamed
+ Description : Source File for the DMA Driver
+ Date        : 20/5/2024
+ ============================================================================
+ */
+/*******************************************************************************
+ *                                Includes                                    *
+ *******************************************************************************/
+#include "MCAL/DMA/DMA.h"
+#include "LIB/Stm32F401cc.h"
+/*******************************************************************************
+ *                             Definitions                                      *
+ *******************************************************************************/
+#define DMA1_BA PERIPHERAL_ADDRESS(0x40026000UL)
+#define DMA2_BA PERIPHERAL_ADDRESS(0x40026400UL)
+#define DMA_NUMS_IN_TARGET 2
+#define DMA_STREAMS_NUM 8
+#define DMA_STREAMS_PER_FLAG_REG 4
+#define DMA_STREAM_EN_MASK 0X00000001
+#define DMA_STREAM_MINC_MASK 0X00000400
+#define DMA_STREAM_CFG_CLR_MASK 0XF0100000
+#define DMA_STREAM_ALL_FLAGS 0X0000003D
+#define DMA_DISABLE_TIMEOUT 1000
+/*******************************************************************************
+ *                            Types Declaration                                 *
+ *******************************************************************************/
+typedef struct
+{
+    uint32_t DMA_SxCR;
+    uint32_t DMA_SxNDTR;
+    uint32_t DMA_SxPAR;
+    uint32_t DMA_SxM0AR;
+    uint32_t DMA_SxM1AR;
+    uint32_t DMA_SxFCR;
+} DMA_STREAM_t;
+typedef struct
+{
+    uint32_t DMA_LISR;
+    uint32_t DMA_HISR;
+    uint32_t DMA_LIFCR;
+    uint32_t DMA_HIFCR;
+    DMA_STREAM_t Stream[DMA_STREAMS_NUM];
+} DMA_PERI_t;
+/*******************************************************************************
+ *                              Variables                                       *
+ *******************************************************************************/
+volatile void *const DMA[DMA_NUMS_IN_TARGET] = {DMA1_BA, DMA2_BA};
+/* Flags offset of each stream inside its LISR/HISR register */
+static const uint8_t DMA_FlagsShift[DMA_STREAMS_PER_FLAG_REG] = {0, 6, 16, 22};
+static DMA_CBF_t DMA_CallBacks[DMA_NUMS_IN_TARGET][DMA_STREAMS_NUM];
+/*******************************************************************************
+ *                         Static Function Prototypes		                   *
+ *******************************************************************************/
+static void DMA_ClearFlags(uint8_t DMA_ID, uint8_t Stream, uint32_t Flags);
+static void DMA_IRQHandler(uint8_t DMA_ID, uint8_t Stream);
+/*******************************************************************************
+ *                             Implementation                                   *
+ *******************************************************************************/
+/**
+ * @brief    : Clears pending flags of a DMA stream.
+ * @param[in]: DMA_ID  DMA controller ID.
+ * @param[in]: Stream  Stream number.
+ * @param[in]: Flags   Flags to clear aligned to bit 0 (DMA_EVENT_xx masks).
+ **/
+static void DMA_ClearFlags(uint8_t DMA_ID, uint8_t Stream, uint32_t Flags)
+{
+    volatile DMA_PERI_t *const Loc_DMA = (volatile DMA_PERI_t *)DMA[DMA_ID];
+    uint32_t Loc_Value = Flags << DMA_FlagsShift[Stream % DMA_STREAMS_PER_FLAG_REG];
+
+    if (Stream < DMA_STREAMS_PER_FLAG_REG)
+    {
+        Loc_DMA->DMA_LIFCR = Loc_Value;
+    }
+    else
+    {
+        Loc_DMA->DMA_HIFCR = Loc_Value;
+    }
+}
+
+/**
+ * @brief    : Configures a DMA stream.
+ * @param[in]: Ptr_Config Pointer to the stream configuration structure.
+ * @return   : Error_enumStatus_t Error status indicating the success or failure of the configuration.
+ * @details  : This function disables the stream, waits until it is released by the hardware,
+ *             clears its pending flags, programs the control register and registers the stream callback.
+ **/
+Error_enumStatus_t DMA_ConfigStream(const DMA_StreamConfig_t *Ptr_Config)
+{
+    /* Local Variable to store error status */
+    Error_enumStatus_t Loc_enumReturnStatus = Status_enumOk;
+    /* Control register value */
+    uint32_t Loc_CRValue = 0;
+
+    /* Check for NULL pointer */
+    if (Ptr_Config == NULL)
+    {
+        Loc_enumReturnStatus = Status_enumNULLPointer;
+    }
+    else if ((Ptr_Config->DMA_ID >= DMA_NUMS_IN_TARGET) || (Ptr_Config->Stream >= DMA_STREAMS_NUM))
+    {
+        Loc_enumReturnStatus = Status_enumWrongInput;
+    }
+    else
+    {
+        volatile DMA_STREAM_t *const Loc_Stream = &((volatile DMA_PERI_t *)DMA[Ptr_Config->DMA_ID])->Stream[Ptr_Config->Stream];
+
+        /* Make sure the stream is released before reprogramming it */
+        Loc_enumReturnStatus = DMA_StopStream(Ptr_Config->DMA_ID, Ptr_Config->Stream);
+        /* Clear all pending flags of the stream */
+        DMA_ClearFlags(Ptr_Config->DMA_ID, Ptr_Config->Stream, DMA_STREAM_ALL_FLAGS);
+        /* Byte transfers, memory address incremented, peripheral address fixed */
+        Loc_CRValue = Loc_Stream->DMA_SxCR & DMA_STREAM_CFG_CLR_MASK;
+        Loc_CRValue |= Ptr_Config->Channel | Ptr_Config->Direction | Ptr_Config->Mode | Ptr_Config->Priority |
+                       Ptr_Config->Interrupts | DMA_STREAM_MINC_MASK;
+        Loc_Stream->DMA_SxCR = Loc_CRValue;
+        /* Direct mode, FIFO disabled */
+        Loc_Stream->DMA_SxFCR = 0;
+        /* Register the stream callback */
+        DMA_CallBacks[Ptr_Config->DMA_ID][Ptr_Config->Stream] = Ptr_Config->CallBack;
+    }
+
+    /* Return the status of the configuration */
+    return Loc_enumReturnStatus;
+}
+
+/**
+ * @brief    : Starts a transfer on a configured DMA stream.
+ * @param[in]: DMA_ID      DMA controller ID.
+ * @param[in]: Stream      Stream number.
+ * @param[in]: PeriphAddr  Address of the peripheral data register.
+ * @param[in]: MemAddr     Address of the memory buffer.
+ * @param[in]: Len         Number of data items to transfer.
+ * @return   : Error_enumStatus_t Error status indicating the success or failure of the operation.
+ * @details  : This function clears the stream pending flags, programs the addresses and the number
+ *             of data items and enables the stream.
+ **/
+Error_enumStatus_t DMA_StartTransfer(uint8_t DMA_ID, uint8_t Stream, uint32_t PeriphAddr, uint32_t MemAddr, uint32_t Len)
+{
+    /* Local Variable to store error status */
+    Error_enumStatus_t Loc_enumReturnStatus = Status_enumOk;
+
+    if ((DMA_ID >= DMA_NUMS_IN_TARGET) || (Stream >= DMA_STREAMS_NUM) || (Len == 0))
+    {
+        Loc_enumReturnStatus = Status_enumWrongInput;
+    }
+    else
+    {
+        volatile DMA_STREAM_t *const Loc_Stream = &((volatile DMA_PERI_t *)DMA[DMA_ID])->Stream[Stream];
+
+        if (Loc_Stream->DMA_SxCR & DMA_STREAM_EN_MASK)
+        {
+            Loc_enumReturnStatus = Status_enumBusyState;
+        }
+        else
+        {
+            /* Flags of the previous transfer must be cleared before enabling the stream */
+            DMA_ClearFlags(DMA_ID, Stream, DMA_STREAM_ALL_FLAGS);
+            Loc_Stream->DMA_SxPAR = PeriphAddr;
+            Loc_Stream->DMA_SxM0AR = MemAddr;
+            Loc_Stream->DMA_SxNDTR = Len;
+            /* Enable the stream */
+            Loc_Stream->DMA_SxCR |= DMA_STREAM_EN_MASK;
+        }
+    }
+
+    /* Return the status of the operation */
+    return Loc_enumReturnStatus;
+}
+
+/**
+ * @brief    : Stops a DMA stream.
+ * @param[in]: DMA_ID      DMA controller ID.
+ * @param[in]: Stream      Stream number.
+ * @return   : Error_enumStatus_t Error status indicating the success or failure of the operation.
+ **/
+Error_enumStatus_t DMA_StopStream(uint8_t DMA_ID, uint8_t Stream)
+{
+    /* Local Variable to store error status */
+    Error_enumStatus_t Loc_enumReturnStatus = Status_enumOk;
+
+    if ((DMA_ID >= DMA_NUMS_IN_TARGET) || (Stream >= DMA_STREAMS_NUM))
+    {
+        Loc_enumReturnStatus = Status_enumWrongInput;
+    }
+    else
+    {
+        volatile DMA_STREAM_t *const Loc_Stream = &((volatile DMA_PERI_t *)DMA[DMA_ID])->Stream[Stream];
+        volatile uint16_t Time = DMA_DISABLE_TIMEOUT;
+
+        /* Disable the stream and wait for the current data item to finish */
+        Loc_Stream->DMA_SxCR &= ~DMA_STREAM_EN_MASK;
+        while ((Loc_Stream->DMA_SxCR & DMA_STREAM_EN_MASK) && Time)
+        {
+            Time--;
+        }
+        if (Loc_Stream->DMA_SxCR & DMA_STREAM_EN_MASK)
+        {
+            Loc_enumReturnStatus = Status_enumTimOut;
+        }
+    }
+
+    /* Return the status of the operation */
+    return Loc_enumReturnStatus;
+}
+
+/**
+ * @brief    : Reads the number of data items left to transfer on a DMA stream.
+ * @param[in]: DMA_ID      DMA controller ID.
+ * @param[in]: Stream      Stream number.
+ * @param[out]: Ptr_Remaining Pointer to a variable to store the number of remaining data items.
+ * @return   : Error_enumStatus_t Error status indicating the success or failure of the operation.
+ **/
+Error_enumStatus_t DMA_GetRemaining(uint8_t DMA_ID, uint8_t Stream, uint32_t *Ptr_Remaining)
+{
+    /* Local Variable to store error status */
+    Error_enumStatus_t Loc_enumReturnStatus = Status_enumOk;
+
+    if (Ptr_Remaining == NULL)
+    {
+        Loc_enumReturnStatus = Status_enumNULLPointer;
+    }
+    else if ((DMA_ID >= DMA_NUMS_IN_TARGET) || (Stream >= DMA_STREAMS_NUM))
+    {
+        Loc_enumReturnStatus = Status_enumWrongInput;
+    }
+    else
+    {
+        *Ptr_Remaining = ((volatile DMA_PERI_t *)DMA[DMA_ID])->Stream[Stream].DMA_SxNDTR;
+    }
+
+    /* Return the status of the operation */
+    return Loc_enumReturnStatus;
+}
+
+/**
+ * @brief    : Common DMA stream interrupt handler.
+ * @param[in]: DMA_ID  DMA controller ID.
+ * @param[in]: Stream  Stream number.
+ * @details  : Reads and clears the stream flags and reports them to the stream callback.
+ **/
+static void DMA_IRQHandler(uint8_t DMA_ID, uint8_t Stream)
+{
+    volatile DMA_PERI_t *const Loc_DMA = (volatile DMA_PERI_t *)DMA[DMA_ID];
+    uint32_t Loc_Flags = (Stream < DMA_STREAMS_PER_FLAG_REG) ? Loc_DMA->DMA_LISR : Loc_DMA->DMA_HISR;
+
+    /* Keep only the flags of this stream */
+    Loc_Flags = (Loc_Flags >> DMA_FlagsShift[Stream % DMA_STREAMS_PER_FLAG_REG]) & DMA_STREAM_ALL_FLAGS;
+    DMA_ClearFlags(DMA_ID, Stream, Loc_Flags);
+
+    /* Call callback function if available */
+    if ((Loc_Flags & (DMA_EVENT_TC | DMA_EVENT_HT | DMA_EVENT_TE)) && DMA_CallBacks[DMA_ID][Stream])
+    {
+        DMA_CallBacks[DMA_ID][Stream](Loc_Flags);
+    }
+}
+
+void DMA1_Stream0_IRQHandler(void) { DMA_IRQHandler(DMA1_ID, DMA_STREAM0); }
+void DMA1_Stream1_IRQHandler(void) { DMA_IRQHandler(DMA1_ID, DMA_STREAM1); }
+void DMA1_Stream2_IRQHandler(void) { DMA_IRQHandler(DMA1_ID, DMA_STREAM2); }
+void DMA1_Stream3_IRQHandler(void) { DMA_IRQHandler(DMA1_ID, DMA_STREAM3); }
+void DMA1_Stream4_IRQHandler(void) { DMA_IRQHandler(DMA1_ID, DMA_STREAM4); }
+void DMA1_Stream5_IRQHandler(void) { DMA_IRQHandler(DMA1_ID, DMA_STREAM5); }
+void DMA1_Stream6_IRQHandler(void) { DMA_IRQHandler(DMA1_ID, DMA_STREAM6); }
+void DMA1_Stream7_IRQHandler(void) { DMA_IRQHandler(DMA1_ID, DMA_STREAM7); }
+void DMA2_Stream0_IRQHandler(void) { DMA_IRQHandler(DMA2_ID, DMA_STREAM0); }
+void DMA2_Stream1_IRQHandler(void) { DMA_IRQHandler(DMA2_ID, DMA_STREAM1); }
+void DMA2_Stream2_IRQHandler(void) { DMA_IRQHandler(DMA2_ID, DMA_STREAM2); }
+void DMA2_Stream3_IRQHandler(void) { DMA_IRQHandler(DMA2_ID, DMA_STREAM3); }
+void DMA2_Stream4_IRQHandler(void) { DMA_IRQHandler(DMA2_ID, DMA_STREAM4); }
+void DMA2_Stream5_IRQHandler(void) { DMA_IRQHandler(DMA2_ID, DMA_STREAM5); }
+void DMA2_Stream6_IRQHandler(void) { DMA_IRQHandler(DMA2_ID, DMA_STREAM6); }
+void DMA2_Stream7_IRQHandler(void) { DMA_IRQHandler(DMA2_ID, DMA_STREAM7); }
@@ -0,0 +1,124 @@
+/*
+ ============================================================================
+ Name        : DMA.h
+ Author      : Omar Medhat Mohamed
+ Description : Header File for the DMA Driver
+ Date        : 20/5/2024
+ ============================================================================
+ */
+#ifndef DMA_H_
+#define DMA_H_
+/*******************************************************************************
+ *                                Includes	                                  *
+ *******************************************************************************/
+#include  	"LIB/std_types.h"
+#include 	"LIB/Mask32.h"
+#include 	"LIB/Error.h"
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+#define DMA1_ID 				0
+#define DMA2_ID 				1
+
+#define DMA_STREAM0 			0
+#define DMA_STREAM1 			1
+#define DMA_STREAM2 			2
+#define DMA_STREAM3 			3
+#define DMA_STREAM4 			4
+#define DMA_STREAM5 			5
+#define DMA_STREAM6 			6
+#define DMA_STREAM7 			7
+
+#define DMA_CHANNEL0 			0X00000000
+#define DMA_CHANNEL1 			0X02000000
+#define DMA_CHANNEL2 			0X04000000
+#define DMA_CHANNEL3 			0X06000000
+#define DMA_CHANNEL4 			0X08000000
+#define DMA_CHANNEL5 			0X0A000000
+#define DMA_CHANNEL6 			0X0C000000
+#define DMA_CHANNEL7 			0X0E000000
+
+#define DMA_DIR_PERIPH_TO_MEM	0X00000000
+#define DMA_DIR_MEM_TO_PERIPH	0X00000040
+#define DMA_DIR_MEM_TO_MEM		0X00000080
+
+#define DMA_MODE_NORMAL			0X00000000
+#define DMA_MODE_CIRCULAR		0X00000100
+
+#define DMA_PRIORITY_LOW		0X00000000
+#define DMA_PRIORITY_MEDIUM		0X00010000
+#define DMA_PRIORITY_HIGH		0X00020000
+#define DMA_PRIORITY_VERY_HIGH	0X00030000
+
+#define DMA_INT_TE				0X00000004
+#define DMA_INT_HT				0X00000008
+#define DMA_INT_TC				0X00000010
+
+/* Events reported to the stream callback */
+#define DMA_EVENT_TE			BIT3_MASK
+#define DMA_EVENT_HT			BIT4_MASK
+#define DMA_EVENT_TC			BIT5_MASK
+/*******************************************************************************
+ *                        	  Types Declaration                                 *
+ *******************************************************************************/
+/**
+ * @brief    : DMA stream callback, Events is a combination of DMA_EVENT_xx.
+ **/
+typedef void (*DMA_CBF_t)(uint32_t Events);
+/**
+ * @brief    : DMA stream configuration structure.
+ * @note     : Peripheral address is never incremented and memory address is always incremented,
+ *             data size is one byte on both sides.
+ **/
+typedef struct
+{
+	uint8_t 	DMA_ID;
+	uint8_t 	Stream;
+	uint32_t 	Channel;
+	uint32_t 	Direction;
+	uint32_t 	Mode;
+	uint32_t 	Priority;
+	uint32_t 	Interrupts;
+	DMA_CBF_t 	CallBack;
+}
+DMA_StreamConfig_t;
+/*******************************************************************************
+ *                  	    Functions Prototypes                               *
+ *******************************************************************************/
+/**
+ * @brief    : Configures a DMA stream.
+ * @param[in]: Ptr_Config Pointer to the stream configuration structure.
+ * @return   : Error_enumStatus_t Error status indicating the success or failure of the configuration.
+ * @details  : This function disables the stream, waits until it is released by the hardware,
+ *             clears its pending flags, programs the control register and registers the stream callback.
+ **/
+Error_enumStatus_t DMA_ConfigStream(const DMA_StreamConfig_t* Ptr_Config);
+/**
+ * @brief    : Starts a transfer on a configured DMA stream.
+ * @param[in]: DMA_ID      DMA controller ID.
+ * @param[in]: Stream      Stream number.
+ * @param[in]: PeriphAddr  Address of the peripheral data register.
+ * @param[in]: MemAddr     Address of the memory buffer.
+ * @param[in]: Len         Number of data items to transfer.
+ * @return   : Error_enumStatus_t Error status indicating the success or failure of the operation.
+ * @details  : This function clears the stream pending flags, programs the addresses and the number
+ *             of data items and enables the stream.
+ **/
+Error_enumStatus_t DMA_StartTransfer(uint8_t DMA_ID, uint8_t Stream, uint32_t PeriphAddr, uint32_t MemAddr, uint32_t Len);
+/**
+ * @brief    : Stops a DMA stream.
+ * @param[in]: DMA_ID      DMA controller ID.
+ * @param[in]: Stream      Stream number.
+ * @return   : Error_enumStatus_t Error status indicating the success or failure of the operation.
+ **/
+Error_enumStatus_t DMA_StopStream(uint8_t DMA_ID, uint8_t Stream);
+/**
+ * @brief    : Reads the number of data items left to transfer on a DMA stream.
+ * @param[in]: DMA_ID      DMA controller ID.
+ * @param[in]: Stream      Stream number.
+ * @param[out]: Ptr_Remaining Pointer to a variable to store the number of remaining data items.
+ * @return   : Error_enumStatus_t Error status indicating the success or failure of the operation.
+ **/
+Error_enumStatus_t DMA_GetRemaining(uint8_t DMA_ID, uint8_t Stream, uint32_t *Ptr_Remaining);
+
+#endif /* DMA_H_ */
@@ -0,0 +1,91 @@
+/*
+ ============================================================================
+ Name        : DWT.c
+ Author      : Omar Medhat Mohamed
+ Description : Source File for the DWT cycle counter Driver
+ Date        : 2/6/2024
+ ============================================================================
+ */
+
+/*******************************************************************************
+ *                                Includes	                                  *
+ *******************************************************************************/
+/* Include the header file for DWT driver */
+#include "MCAL/DWT/DWT.h"
+/*******************************************************************************
+ *                             Definitions                                      *
+ *******************************************************************************/
+#define DWT_BASE_ADDRESS             0xE0001000 /* Base address of DWT peripheral */
+#define DEMCR_ADDRESS                0xE000EDFC /* Debug exception and monitor control register */
+#define DEMCR_TRCENA_MASK            0x01000000 /* Enables the DWT and ITM units */
+#define DWT_CTRL_CYCCNTENA_MASK      0x00000001 /* Enables CYCCNT */
+#define DWT_CTRL_NOCYCCNT_MASK       0x02000000 /* Set when the core has no cycle counter */
+/*******************************************************************************
+ *                        	  Types Declaration                                 *
+ *******************************************************************************/
+typedef struct
+{
+    /* Control register */
+    uint32_t DWT_CTRL;
+    /* Cycle count register */
+    uint32_t DWT_CYCCNT;
+} DWT_PERI_t;
+/*******************************************************************************
+ *                              Variables		                                *
+ *******************************************************************************/
+/* Pointer to DWT peripheral */
+volatile DWT_PERI_t *const DWT = (volatile DWT_PERI_t *)CORE_PERIPHERAL_ADDRESS(DWT_BASE_ADDRESS);
+/* Pointer to DEMCR register */
+volatile uint32_t *const DEMCR = (volatile uint32_t *)CORE_PERIPHERAL_ADDRESS(DEMCR_ADDRESS);
+
+/*******************************************************************************
+ *                             Implementation   				                *
+ *******************************************************************************/
+/*
+ * @brief    : Enable the DWT cycle counter
+ * @param[in]: void
+ * @return   : Error_enumStatus_t: Status of the operation
+ * @details  : Enables the trace block, clears CYCCNT and starts it counting core clock cycles.
+ *             Returns Status_enumNotOk if the core has no cycle counter.
+ */
+Error_enumStatus_t DWT_EnableCycleCounter(void)
+{
+    /* Local Variable to store error status */
+    Error_enumStatus_t Loc_enumReturnStatus = Status_enumOk;
+    /* The DWT registers are only accessible once the trace block is enabled */
+    *DEMCR |= DEMCR_TRCENA_MASK;
+    if (DWT->DWT_CTRL & DWT_CTRL_NOCYCCNT_MASK)
+    {
+        Loc_enumReturnStatus = Status_enumNotOk;
+    }
+    else
+    {
+        /* Start counting from zero */
+        REG_WRITE(DWT->DWT_CYCCNT, 0);
+        DWT->DWT_CTRL |= DWT_CTRL_CYCCNTENA_MASK;
+    }
+    /*Return error status*/
+    return Loc_enumReturnStatus;
+}
+
+/*
+ * @brief    : Disable the DWT cycle counter
+ * @param[in]: void
+ * @return   : void
+ * @details  : Stops CYCCNT, its value is kept.
+ */
+void DWT_DisableCycleCounter(void)
+{
+    DWT->DWT_CTRL &= ~DWT_CTRL_CYCCNTENA_MASK;
+}
+
+/*
+ * @brief    : Get the DWT cycle count
+ * @param[in]: void
+ * @return   : uint32_t: Core clock cycles counted since the counter was enabled, wraps at 2^32
+ * @details  : Differences of two reads give the cycles elapsed between them, across one wrap.
+ */
+uint32_t DWT_GetCycleCount(void)
+{
+    return REG_READ(DWT->DWT_CYCCNT);
+}
@@ -0,0 +1,44 @@
+/*
+ ============================================================================
+ Name        : DWT.h
+ Author      : Omar Medhat Mohamed
+ Description : Header File for the DWT cycle counter Driver
+ Date        : 2/6/2024
+ ============================================================================
+ */
+#ifndef DWT_H_
+#define DWT_H_
+/*******************************************************************************
+ *                                Includes	                                  *
+ *******************************************************************************/
+#include  	"LIB/std_types.h"
+#include 	"LIB/Error.h"
+#include	"LIB/Stm32F401cc.h"
+/*******************************************************************************
+ *                  	    Functions Prototypes                               *
+ *******************************************************************************/
+/*
+ * @brief    : Enable the DWT cycle counter
+ * @param[in]: void
+ * @return   : Error_enumStatus_t: Status of the operation
+ * @details  : Enables the trace block, clears CYCCNT and starts it counting core clock cycles.
+ *             Returns Status_enumNotOk if the core has no cycle counter.
+ */
+Error_enumStatus_t DWT_EnableCycleCounter(void);
+
+/*
+ * @brief    : Disable the DWT cycle counter
+ * @param[in]: void
+ * @return   : void
+ * @details  : Stops CYCCNT, its value is kept.
+ */
+void DWT_DisableCycleCounter(void);
+
+/*
+ * @brief    : Get the DWT cycle count
+ * @param[in]: void
+ * @return   : uint32_t: Core clock cycles counted since the counter was enabled, wraps at 2^32
+ * @details  : Differences of two reads give the cycles elapsed between them, across one wrap.
+ */
+uint32_t DWT_GetCycleCount(void);
+#endif
@@ -0,0 +1,93 @@
+/*
+ ============================================================================
+ Name        : FLASH.c
+ Author      : Omar Medhat Mohamed
+ Description : Source File for the FLASH interface Driver
+ Date        : 3/6/2024
+ ============================================================================
+ */
+
+/*******************************************************************************
+ *                                Includes	                                  *
+ *******************************************************************************/
+#include "MCAL/FLASH/FLASH.h"
+#include "LIB/Stm32F401cc.h"
+/*******************************************************************************
+ *                             Definitions                                      *
+ *******************************************************************************/
+#define FLASH_BASE_ADDRESS          0x40023C00 /* Base address of the flash interface */
+#define FLASH_LATENCY_CLR_MASK      0xFFFFFFF0
+#define FLASH_LATENCY_READ_MASK     0x0000000F
+#define FLASH_ACR_PRFTEN_MASK       0x00000100 /* Prefetch enable */
+#define FLASH_ACR_ICEN_MASK         0x00000200 /* Instruction cache enable */
+#define FLASH_ACR_DCEN_MASK         0x00000400 /* Data cache enable */
+/*******************************************************************************
+ *                        	  Types Declaration                                 *
+ *******************************************************************************/
+typedef struct
+{
+    /* Access control register */
+    uint32_t FLASH_ACR;
+    /* Key register */
+    uint32_t FLASH_KEYR;
+    /* Option key register */
+    uint32_t FLASH_OPTKEYR;
+    /* Status register */
+    uint32_t FLASH_SR;
+    /* Control register */
+    uint32_t FLASH_CR;
+    /* Option control register */
+    uint32_t FLASH_OPTCR;
+} FLASH_PERI_t;
+/*******************************************************************************
+ *                              Variables		                                *
+ *******************************************************************************/
+/* Pointer to the flash interface */
+volatile FLASH_PERI_t *const FLASH = (volatile FLASH_PERI_t *)PERIPHERAL_ADDRESS(FLASH_BASE_ADDRESS);
+
+/*******************************************************************************
+ *                             Implementation   				                *
+ *******************************************************************************/
+/*
+ * @brief    : Configure Flash Latency
+ * @param[in]: Copy_Latency: Wait states, FLASH_LATENCY_0WS to FLASH_LATENCY_7WS
+ * @return   : Error_enumStatus_t: Status of the operation
+ * @details  : Must be raised before HCLK is increased and lowered only after it is decreased.
+ *             Returns Status_enumNotOk if the new latency is not read back.
+ */
+Error_enumStatus_t FLASH_Config_Latency(uint32_t Copy_Latency)
+{
+    /* Local Variable to store error status */
+    Error_enumStatus_t Loc_enumReturnStatus = Status_enumOk;
+    uint32_t Loc_u32Temp = FLASH->FLASH_ACR;
+
+    if (Copy_Latency > FLASH_LATENCY_7WS)
+    {
+        Loc_enumReturnStatus = Status_enumWrongInput;
+    }
+    else
+    {
+        Loc_u32Temp &= FLASH_LATENCY_CLR_MASK;
+        Loc_u32Temp |= Copy_Latency;
+        FLASH->FLASH_ACR = Loc_u32Temp;
+        /* The new latency is in use once it reads back */
+        if ((FLASH->FLASH_ACR & FLASH_LATENCY_READ_MASK) != Copy_Latency)
+        {
+            Loc_enumReturnStatus = Status_enumNotOk;
+        }
+    }
+    /*Return error status*/
+    return Loc_enumReturnStatus;
+}
+
+/*
+ * @brief    : Enable Flash Acceleration
+ * @param[in]: void
+ * @return   : void
+ * @details  : Enables the prefetch buffer and the instruction and data caches (ART accelerator),
+ *             so code runs close to zero wait states from flash.
+ */
+void FLASH_Enable_Acceleration(void)
+{
+    FLASH->FLASH_ACR |= FLASH_ACR_PRFTEN_MASK | FLASH_ACR_ICEN_MASK | FLASH_ACR_DCEN_MASK;
+}
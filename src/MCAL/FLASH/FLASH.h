@@ -0,0 +1,48 @@
+/*
+ ============================================================================
+ Name        : FLASH.h
+ Author      : Omar Medhat Mohamed
+ Description : Header File for the FLASH interface Driver
+ Date        : 3/6/2024
+ ============================================================================
+ */
+#ifndef FLASH_H_
+#define FLASH_H_
+/*******************************************************************************
+ *                                Includes	                                  *
+ *******************************************************************************/
+#include  	"LIB/std_types.h"
+#include 	"LIB/Error.h"
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+/* Wait states of a flash read, at 2.7 V to 3.6 V each one allows 30 MHz more HCLK */
+#define FLASH_LATENCY_0WS	0x00000000 /* HCLK <= 30 MHz */
+#define FLASH_LATENCY_1WS	0x00000001 /* HCLK <= 64 MHz */
+#define FLASH_LATENCY_2WS	0x00000002 /* HCLK <= 84 MHz */
+#define FLASH_LATENCY_3WS	0x00000003
+#define FLASH_LATENCY_4WS	0x00000004
+#define FLASH_LATENCY_5WS	0x00000005
+#define FLASH_LATENCY_6WS	0x00000006
+#define FLASH_LATENCY_7WS	0x00000007
+/*******************************************************************************
+ *                  	    Functions Prototypes                               *
+ *******************************************************************************/
+/*
+ * @brief    : Configure Flash Latency
+ * @param[in]: Copy_Latency: Wait states, FLASH_LATENCY_0WS to FLASH_LATENCY_7WS
+ * @return   : Error_enumStatus_t: Status of the operation
+ * @details  : Must be raised before HCLK is increased and lowered only after it is decreased.
+ *             Returns Status_enumNotOk if the new latency is not read back.
+ */
+Error_enumStatus_t FLASH_Config_Latency(uint32_t Copy_Latency);
+
+/*
+ * @brief    : Enable Flash Acceleration
+ * @param[in]: void
+ * @return   : void
+ * @details  : Enables the prefetch buffer and the instruction and data caches (ART accelerator),
+ *             so code runs close to zero wait states from flash.
+ */
+void FLASH_Enable_Acceleration(void);
+#endif
@@ -13,6 +13,7 @@
 /************************************************Includes************************************************/
 /********************************************************************************************************/
 #include "MCAL/GPIO/GPIO.h"
+#include "LIB/Stm32F401cc.h"
 #include "assertparam.h"
 /********************************************************************************************************/
 /************************************************Defines*************************************************/
@@ -20,6 +21,8 @@
 #define MASK_1BIT  (0x1UL)
 #define MASK_2BITS (0X3UL)
 #define GPIO_AF_CLR_MASK 0x0000000F
+#define GPIO_PORT_MASK   (0xFFFFUL)
+#define GPIO_BSRR_RESET_SHIFT (16)
 
 #define GPIO_PINMODE_GET_MODE(PinMode) (PinMode & 0x00FUL)
 #define GPIO_PINMODE_GET_PULL(PinMode) ((PinMode & 0x0F0UL) >> 4)
@@ -29,12 +32,12 @@
 /************************************/
 /***************Registers************/
 /************************************/
-#define GPIOA_BASE (0x40020000UL)
-#define GPIOB_BASE (0x40020400UL)
-#define GPIOC_BASE (0x40020800UL)
-#define GPIOD_BASE (0x40020C00UL)
-#define GPIOE_BASE (0x40021000UL)
-#define GPIOH_BASE (0x40021C00UL)
+#define GPIOA_BASE PERIPHERAL_ADDRESS(0x40020000UL)
+#define GPIOB_BASE PERIPHERAL_ADDRESS(0x40020400UL)
+#define GPIOC_BASE PERIPHERAL_ADDRESS(0x40020800UL)
+#define GPIOD_BASE PERIPHERAL_ADDRESS(0x40020C00UL)
+#define GPIOE_BASE PERIPHERAL_ADDRESS(0x40021000UL)
+#define GPIOH_BASE PERIPHERAL_ADDRESS(0x40021C00UL)
 
 #define NUM_OF_GPIOS (6)
 
@@ -161,7 +164,8 @@ MCAL_Status_t GPIO_setPinValue(GPIO_Port_t Port, GPIO_Pin_t PinNumber, GPIO_PinS
     assert_param(IS_GPIO_PIN_STATE(PinState));
 
     GPIO_TypeDef volatile *const GPIO = GPIOS[Port];
-    GPIO->ODR = (GPIO->ODR & ~(MASK_1BIT << PinNumber)) | (PinState << PinNumber);
+    /* BSRR write is atomic, no read-modify-write of ODR */
+    REG_WRITE(GPIO->BSRR, (MASK_1BIT << PinNumber) << ((PinState == GPIO_PINSTATE_SET) ? 0 : GPIO_BSRR_RESET_SHIFT));
     return MCAL_OK;
 }
 
@@ -173,11 +177,29 @@ GPIO_PinState_t GPIO_getPinValue(GPIO_Port_t Port, GPIO_Pin_t PinNumber)
     
     GPIO_TypeDef volatile *const GPIO = GPIOS[Port];
 
-    uint32_t PinValue = (GPIO->IDR >> PinNumber) & MASK_1BIT;
+    uint32_t PinValue = (REG_READ(GPIO->IDR) >> PinNumber) & MASK_1BIT;
 
     return PinValue;
 }
 
+MCAL_Status_t GPIO_writePortMasked(GPIO_Port_t Port, uint16_t SetMask, uint16_t ResetMask)
+{
+    assert_param(IS_GPIO_PORT(Port));
+
+    GPIO_TypeDef volatile *const GPIO = GPIOS[Port];
+    REG_WRITE(GPIO->BSRR, ((uint32_t)ResetMask << GPIO_BSRR_RESET_SHIFT) | SetMask);
+    return MCAL_OK;
+}
+
+uint16_t GPIO_readPort(GPIO_Port_t Port)
+{
+    assert_param(IS_GPIO_PORT(Port));
+
+    GPIO_TypeDef volatile *const GPIO = GPIOS[Port];
+
+    return (uint16_t)(REG_READ(GPIO->IDR) & GPIO_PORT_MASK);
+}
+
 
 MCAL_Status_t GPIO_setPinAF(GPIO_Port_t Port, GPIO_Pin_t PinNumber,  GPIO_AF_NUM_t AFNumber) 
 {
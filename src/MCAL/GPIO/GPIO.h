@@ -220,6 +220,30 @@ MCAL_Status_t GPIO_setPinValue(GPIO_Port_t Port, GPIO_Pin_t PinNumber, GPIO_PinS
  */
 GPIO_PinState_t GPIO_getPinValue(GPIO_Port_t Port, GPIO_Pin_t PinNumber);
 
+/**
+ * @brief Sets and resets several pins of a GPIO port in a single bus write.
+ *
+ * This function writes both masks to the BSRR register, so all the selected pins change at the
+ * same moment and no read-modify-write of ODR is needed. Pins outside both masks keep their state.
+ * A pin present in both masks is set, as the set half of BSRR takes priority.
+ *
+ * @param[in] Port The GPIO port to write.
+ * @param[in] SetMask Pins to drive high, bit n selects pin n.
+ * @param[in] ResetMask Pins to drive low, bit n selects pin n.
+ * @return Status indicating the success or failure of the operation @ref MCAL_Status_t.
+ */
+MCAL_Status_t GPIO_writePortMasked(GPIO_Port_t Port, uint16_t SetMask, uint16_t ResetMask);
+
+/**
+ * @brief Gets the current value of all the pins of a GPIO port.
+ *
+ * This function reads the IDR register once, so all the pins are sampled at the same moment.
+ *
+ * @param[in] Port The GPIO port to read.
+ * @return The input state of the port, bit n holds pin n.
+ */
+uint16_t GPIO_readPort(GPIO_Port_t Port);
+
 /**
  * @brief Sets the alternate function for a GPIO pin.
  * 
@@ -82,9 +82,9 @@ typedef struct
  *                              Variables		                                *
  *******************************************************************************/
 /* Pointer to NVIC peripheral */
-volatile NVIC_PERI_t *const NVIC = (volatile NVIC_PERI_t *)NVIC_BASE_ADDRESS;
+volatile NVIC_PERI_t *const NVIC = (volatile NVIC_PERI_t *)CORE_PERIPHERAL_ADDRESS(NVIC_BASE_ADDRESS);
 /* Pointer to SCB peripheral */
-volatile SCB_PERI_t *const SCB = (volatile SCB_PERI_t *)SCB_BASE_ADDRESS;
+volatile SCB_PERI_t *const SCB = (volatile SCB_PERI_t *)CORE_PERIPHERAL_ADDRESS(SCB_BASE_ADDRESS);
 
 /*******************************************************************************
  *                             Implementation   				                *
@@ -109,7 +109,7 @@ Error_enumStatus_t Enable_NVIC_IRQ(IRQn_t IRQn)
     else
     {
         /* Enable the specified NVIC interrupt */
-        NVIC->NVIC_ISER[Loc_u8Index] = (1 << (IRQn % BITS_PER_GROUP));
+        REG_WRITE(NVIC->NVIC_ISER[Loc_u8Index], (1 << (IRQn % BITS_PER_GROUP)));
     }
     /*ٌReturn error status*/
     return Loc_enumReturnStatus;
@@ -135,7 +135,7 @@ Error_enumStatus_t Disable_NVIC_IRQ(IRQn_t IRQn)
     else
     {
         /* Disable the specified NVIC interrupt */
-        NVIC->NVIC_ICER[Loc_u8Index] = (1 << (IRQn % BITS_PER_GROUP));
+        REG_WRITE(NVIC->NVIC_ICER[Loc_u8Index], (1 << (IRQn % BITS_PER_GROUP)));
     }
     /*ٌReturn error status*/
     return Loc_enumReturnStatus;
@@ -160,7 +160,7 @@ Error_enumStatus_t Set_NVIC_Pending_IRQ(IRQn_t IRQn)
     else
     {
         /* Set the specified NVIC interrupt as pending */
-        NVIC->NVIC_ISPR[Loc_u8Index] = (1 << (IRQn % BITS_PER_GROUP));
+        REG_WRITE(NVIC->NVIC_ISPR[Loc_u8Index], (1 << (IRQn % BITS_PER_GROUP)));
     }
     /*ٌReturn error status*/
     return Loc_enumReturnStatus;
@@ -185,7 +185,7 @@ Error_enumStatus_t Clear_NVIC_Pending_IRQ(IRQn_t IRQn)
     else
     {
         /* Clear the pending status of the specified NVIC interrupt */
-        NVIC->NVIC_ICPR[Loc_u8Index] = (1 << (IRQn % BITS_PER_GROUP));
+        REG_WRITE(NVIC->NVIC_ICPR[Loc_u8Index], (1 << (IRQn % BITS_PER_GROUP)));
     }
     /*ٌReturn error status*/
     return Loc_enumReturnStatus;
@@ -363,7 +363,7 @@ Error_enumStatus_t SET_Software_Interrupt(IRQn_t IRQn)
     else
     {
         /* Generated a Software Interrupt */
-        NVIC->NVIC_STIR = IRQn;
+        REG_WRITE(NVIC->NVIC_STIR, IRQn);
     }
     return Loc_enumReturnStatus;
 }
@@ -10,6 +10,7 @@
  *                                Includes	                                  *
  *******************************************************************************/
 #include "MCAL/RCC/RCC.h"
+#include "LIB/Stm32F401cc.h"
 /*******************************************************************************
  *                             Definitions                                      *
  *******************************************************************************/
@@ -62,6 +63,18 @@
 #define PPRE2_APBH_CLR_MASK 0xFFFF1FFF
 #define PPRE1_APBL_CLR_MASK 0xFFFFE3FF
 #define HPRE_AHB_CLR_MASK 0xFFFFFF0F
+
+#define SysClk_STATUS_SHIFT 2
+#define SysClk_SWITCH_TIMEOUT 1000
+
+#define PLLM_READ_MASK 0x0000003F
+#define PLLN_READ_MASK 0x000001FF
+#define PLLP_READ_MASK 0x00000003
+
+#define HPRE_DIV_FLAG 0x8
+#define PPRE_DIV_FLAG 0x4
+#define PPRE_READ_MASK 0x7
+#define HPRE_READ_MASK 0xF
 /*******************************************************************************
  *                        	  Types Declaration                                 *
  *******************************************************************************/
@@ -106,7 +119,9 @@ typedef struct
 /*******************************************************************************
  *                              Variables		                                *
  *******************************************************************************/
-volatile RCC_PERI_t *const RCC = (volatile RCC_PERI_t *)RCC_Base_ADDRESS;
+volatile RCC_PERI_t *const RCC = (volatile RCC_PERI_t *)PERIPHERAL_ADDRESS(RCC_Base_ADDRESS);
+/* HPRE 1000..1111 divides HCLK by 2, 4, 8, 16, 64, 128, 256 and 512, as shifts */
+static const uint8_t AHB_PrescalerShift[8] = {1, 2, 3, 4, 6, 7, 8, 9};
 
 /*******************************************************************************
  *                             Implementation   				                *
@@ -191,13 +206,13 @@ Error_enumStatus_t RCC_READ_ClockReadyState(uint32_t Copy_ReadyClock)
         uint32_t timer = 1000; /* Set a timeout value for the clock readiness check. */
 
         /* Wait for the clock to become ready with a timeout */
-        while (timer && !(RCC->RCC_CR & Copy_ReadyClock))
+        while (timer && !(REG_READ(RCC->RCC_CR) & Copy_ReadyClock))
         {
             timer--; /* Decrement the timer. */
         }
 
         /* Check if the clock is still not ready after the timeout */
-        if (!(RCC->RCC_CR & Copy_ReadyClock))
+        if (!(REG_READ(RCC->RCC_CR) & Copy_ReadyClock))
         {
             Loc_enumReturnStatus = Status_enumNotOk;
         }
@@ -224,6 +239,8 @@ Error_enumStatus_t RCC_Select_Sysclk(uint32_t Copy_SysClk)
 
     /* Register to hold system clock configuration */
     uint32_t Loc_u32Temp = RCC->RCC_CFGR;
+    /* Timeout of the switch */
+    uint32_t Loc_u32Timer = SysClk_SWITCH_TIMEOUT;
 
     /* Check if the provided system clock source is valid */
     if (Copy_SysClk != SysClk_HSI_MASK && Copy_SysClk != SysClk_HSE_MASK && Copy_SysClk != SysClk_PLL_MASK)
@@ -236,6 +253,16 @@ Error_enumStatus_t RCC_Select_Sysclk(uint32_t Copy_SysClk)
         Loc_u32Temp &= SysClk_CLR_MASK; /* Clear the bits related to system clock configuration. */
         Loc_u32Temp |= Copy_SysClk;     /* Set the bits for the selected system clock source. */
         RCC->RCC_CFGR = Loc_u32Temp;    /* Update the RCC_CFGR register with the new system clock configuration. */
+
+        /* The switch takes effect once SWS reports the new source */
+        while (Loc_u32Timer && ((REG_READ(RCC->RCC_CFGR) & SysClk_READ_MASK) != (Copy_SysClk << SysClk_STATUS_SHIFT)))
+        {
+            Loc_u32Timer--;
+        }
+        if ((REG_READ(RCC->RCC_CFGR) & SysClk_READ_MASK) != (Copy_SysClk << SysClk_STATUS_SHIFT))
+        {
+            Loc_enumReturnStatus = Status_enumNotOk;
+        }
     }
 
     /* Return the status of the system clock source selection */
@@ -307,8 +334,8 @@ Error_enumStatus_t RCC_Config_PLLParamters(uint32_t PLLM, uint32_t PLLN, uint32_
         /* Convert PLLP value */
         PLLP = (uint32_t)(PLLP / 2) - 1;
         Loc_u32Temp &= PLL_CONFIG_CLR_MASK;
-        /* Calculate PLL configuration value */
-        Loc_u32Temp = PLLQ << PLL_Q_SHIFTING;
+        /* Calculate PLL configuration value, the PLL source and reserved bits are kept */
+        Loc_u32Temp |= PLLQ << PLL_Q_SHIFTING;
         Loc_u32Temp |= PLLP << PLL_P_SHIFTING;
         Loc_u32Temp |= PLLN << PLL_N_SHIFTING;
         Loc_u32Temp |= PLLM;
@@ -408,6 +435,96 @@ Error_enumStatus_t RCC_Config_AHB_BusPrescaler(uint32_t CopyPreScalerValue)
     return Loc_enumReturnStatus;
 }
 
+/*
+ * @brief    : Get System Clock Frequency.
+ * @return   : uint32_t SYSCLK in Hz.
+ * @details  : Computed from the clock source in use (SWS) and, for the PLL, from its source and M, N, P factors.
+ */
+uint32_t RCC_Get_SysclkFrequency(void)
+{
+    /* HSI is the clock out of reset */
+    uint32_t Loc_u32Frequency = RCC_HSI_FREQUENCY;
+    uint32_t Loc_u32Status = (RCC->RCC_CFGR & SysClk_READ_MASK);
+
+    if (Loc_u32Status == SysClk_HSE_READY_MASK)
+    {
+        Loc_u32Frequency = RCC_HSE_FREQUENCY;
+    }
+    else if (Loc_u32Status == SysClk_PLL_READY_MASK)
+    {
+        uint32_t Loc_u32PLL = RCC->RCC_PLLCFGR;
+        uint32_t Loc_u32PLLM = Loc_u32PLL & PLLM_READ_MASK;
+        uint32_t Loc_u32PLLN = (Loc_u32PLL >> PLL_N_SHIFTING) & PLLN_READ_MASK;
+        uint32_t Loc_u32PLLP = (((Loc_u32PLL >> PLL_P_SHIFTING) & PLLP_READ_MASK) + 1) * 2;
+        uint32_t Loc_u32Input = (Loc_u32PLL & PLL_SRC_HSE) ? RCC_HSE_FREQUENCY : RCC_HSI_FREQUENCY;
+
+        /* SYSCLK = Input / M * N / P, M is at least 2 in any valid configuration */
+        if (Loc_u32PLLM >= PLLM_BOUNDARY1)
+        {
+            Loc_u32Frequency = ((Loc_u32Input / Loc_u32PLLM) * Loc_u32PLLN) / Loc_u32PLLP;
+        }
+    }
+    else
+    {
+        /* HSI */
+    }
+    return Loc_u32Frequency;
+}
+
+/*
+ * @brief    : Get AHB Bus Frequency.
+ * @return   : uint32_t HCLK in Hz, the clock of the core, SysTick and the AHB peripherals.
+ * @details  : SYSCLK divided by the AHB prescaler.
+ */
+uint32_t RCC_Get_AHB_Frequency(void)
+{
+    uint32_t Loc_u32Frequency = RCC_Get_SysclkFrequency();
+    uint32_t Loc_u32HPRE = (RCC->RCC_CFGR >> HPRE_AHB_SHIFTING) & HPRE_READ_MASK;
+
+    /* HPRE 0xxx is not divided */
+    if (Loc_u32HPRE & HPRE_DIV_FLAG)
+    {
+        Loc_u32Frequency >>= AHB_PrescalerShift[Loc_u32HPRE & ~HPRE_DIV_FLAG];
+    }
+    return Loc_u32Frequency;
+}
+
+/*
+ * @brief    : Get APB1 Bus Frequency.
+ * @return   : uint32_t PCLK1 in Hz, the clock of USART2.
+ * @details  : HCLK divided by the APB low speed prescaler.
+ */
+uint32_t RCC_Get_APB1_Frequency(void)
+{
+    uint32_t Loc_u32Frequency = RCC_Get_AHB_Frequency();
+    uint32_t Loc_u32PPRE1 = (RCC->RCC_CFGR >> PPRE1_APBL_SHIFTING) & PPRE_READ_MASK;
+
+    /* PPRE 0xx is not divided, 100..111 divides by 2 to 16 */
+    if (Loc_u32PPRE1 & PPRE_DIV_FLAG)
+    {
+        Loc_u32Frequency >>= (Loc_u32PPRE1 & ~PPRE_DIV_FLAG) + 1;
+    }
+    return Loc_u32Frequency;
+}
+
+/*
+ * @brief    : Get APB2 Bus Frequency.
+ * @return   : uint32_t PCLK2 in Hz, the clock of USART1 and USART6.
+ * @details  : HCLK divided by the APB high speed prescaler.
+ */
+uint32_t RCC_Get_APB2_Frequency(void)
+{
+    uint32_t Loc_u32Frequency = RCC_Get_AHB_Frequency();
+    uint32_t Loc_u32PPRE2 = (RCC->RCC_CFGR >> PPRE2_APBH_SHIFTING) & PPRE_READ_MASK;
+
+    /* PPRE 0xx is not divided, 100..111 divides by 2 to 16 */
+    if (Loc_u32PPRE2 & PPRE_DIV_FLAG)
+    {
+        Loc_u32Frequency >>= (Loc_u32PPRE2 & ~PPRE_DIV_FLAG) + 1;
+    }
+    return Loc_u32Frequency;
+}
+
 /*
  * @brief    : Enable AHB1 Peripheral.
  * @param[in]: Copy_AHB1PeripheralName The AHB1 peripheral to be enabled.
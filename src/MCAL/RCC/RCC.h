@@ -32,6 +32,10 @@
 #define PLL_SRC_HSI 0X00000000
 #define PLL_SRC_HSE BIT22_MASK
 
+/* Oscillator frequencies in Hz, HSE is the 25 MHz crystal of the board */
+#define RCC_HSI_FREQUENCY 16000000UL
+#define RCC_HSE_FREQUENCY 25000000UL
+
 /************AHB1_BUS_Peripheral_Masks ************/
 #define GPIOA 	0x00000001
 #define GPIOB 	0x00000002
@@ -124,6 +128,7 @@ Error_enumStatus_t RCC_READ_ClockReadyState(uint32_t Copy_ReadyClock);
  * @param[in]: Copy_SysClk The system clock source to be selected. It can be SysClk_HSI_MASK, SysClk_HSE_MASK, or SysClk_PLL_MASK.
  * @return   : Error_enumStatus_t Error status indicating the success or failure of selecting the system clock.
  * @details  : This function selects the system clock source among the available options: HSI, HSE, or PLL.
+			   It returns Status_enumNotOk if the switch is not reported in SWS before a timeout.
  */
 Error_enumStatus_t RCC_Select_Sysclk(uint32_t Copy_SysClk);
 /*
@@ -161,6 +166,31 @@ Error_enumStatus_t RCC_Config_APBL_BusPrescaler(uint32_t CopyPreScalerValue);
  */
 Error_enumStatus_t RCC_Config_AHB_BusPrescaler(uint32_t CopyPreScalerValue);
 
+/*
+ * @brief    : Get System Clock Frequency.
+ * @return   : uint32_t SYSCLK in Hz.
+ * @details  : Computed from the clock source in use (SWS) and, for the PLL, from its source and M, N, P factors.
+ */
+uint32_t RCC_Get_SysclkFrequency(void);
+/*
+ * @brief    : Get AHB Bus Frequency.
+ * @return   : uint32_t HCLK in Hz, the clock of the core, SysTick and the AHB peripherals.
+ * @details  : SYSCLK divided by the AHB prescaler.
+ */
+uint32_t RCC_Get_AHB_Frequency(void);
+/*
+ * @brief    : Get APB1 Bus Frequency.
+ * @return   : uint32_t PCLK1 in Hz, the clock of USART2.
+ * @details  : HCLK divided by the APB low speed prescaler.
+ */
+uint32_t RCC_Get_APB1_Frequency(void);
+/*
+ * @brief    : Get APB2 Bus Frequency.
+ * @return   : uint32_t PCLK2 in Hz, the clock of USART1 and USART6.
+ * @details  : HCLK divided by the APB high speed prescaler.
+ */
+uint32_t RCC_Get_APB2_Frequency(void);
+
 /*
  * @brief    : Enable AHB1 Peripheral.
  * @param[in]: Copy_AHB1PeripheralName The AHB1 peripheral to be enabled.
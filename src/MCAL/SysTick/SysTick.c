@@ -3,6 +3,8 @@
 /********************************************************************************************************/
 
 #include "SysTick.h"
+#include "LIB/Stm32F401cc.h"
+#include "MCAL/RCC/RCC.h"
 #include "assertparam.h"
 #include <stddef.h>
 /********************************************************************************************************/
@@ -15,7 +17,7 @@
 
 #define SYSTICK_BASE     (0xE000E010UL)
 
-#define SYSTICK    ((SysTick_t volatile* const)(SYSTICK_BASE))
+#define SYSTICK    ((SysTick_t volatile* const)CORE_PERIPHERAL_ADDRESS(SYSTICK_BASE))
 
 #define SYSTICK_CTRL_CLKSOURCE_MASK (0x4UL)
 #define SYSTICK_CTRL_TICKINT_MASK (0X2UL)
@@ -104,8 +106,8 @@ void SysTick_init(SysTick_Config_t const *config)
     assert_param(IS_VALID_SYSTICK_EXCEPTION_STATE(config->ExceptionState));
 
     uint32_t CTRL = SYSTICK->CTRL;
-    CTRL = (CTRL & SYSTICK_CTRL_CLKSOURCE_MASK) | config->ClockSource;
-    CTRL = (CTRL & SYSTICK_CTRL_TICKINT_MASK) | config->ExceptionState;
+    CTRL = (CTRL & ~SYSTICK_CTRL_CLKSOURCE_MASK) | config->ClockSource;
+    CTRL = (CTRL & ~SYSTICK_CTRL_TICKINT_MASK) | config->ExceptionState;
 
     SYSTICK->CTRL = CTRL;
 
@@ -117,9 +119,11 @@ void SysTick_startTimerMS(uint32_t timeMS)
 
     stopSysTick();
 
-    uint64_t freq = (SYSTICK->CTRL & SYSTICK_CTRL_CLKSOURCE_MASK) ? SYSTICK_AHB_CLK : SYSTICK_AHB_CLK / 8;
+    /* The reload follows the AHB clock currently programmed in the RCC */
+    uint64_t ahbClock = RCC_Get_AHB_Frequency();
+    uint64_t freq = (SYSTICK->CTRL & SYSTICK_CTRL_CLKSOURCE_MASK) ? ahbClock : ahbClock / 8;
     SYSTICK->LOAD = ((freq / 1000) * (timeMS)) - 1;
-    SYSTICK->VAL = 0;
+    REG_WRITE(SYSTICK->VAL, 0);
     SYSTICK->CTRL |= SYSTICK_CTRL_ENABLE_MASK;
 }
 void SysTick_startTickCounter(uint32_t ticks)
@@ -133,7 +137,7 @@ void SysTick_startTickCounter(uint32_t ticks)
 
 uint32_t SysTick_currentTick(void)
 {
-    uint32_t currentTick = SYSTICK->VAL;
+    uint32_t currentTick = REG_READ(SYSTICK->VAL);
     return currentTick;
 }
 
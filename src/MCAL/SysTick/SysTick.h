@@ -22,8 +22,8 @@ typedef void (*SysTick_CallBackFn_t)(void);
  * @brief Enumeration for SysTick clock sources.
  */
 typedef enum {
-    SYSTICK_CLK_AHB_DIV_8 = (1UL << 2),   /**< SysTick clock source: AHB divided by 8 */
-    SYSTICK_CLK_AHB       = (0UL << 2),   /**< SysTick clock source: AHB */
+    SYSTICK_CLK_AHB_DIV_8 = (0UL << 2),   /**< SysTick clock source: AHB divided by 8 */
+    SYSTICK_CLK_AHB       = (1UL << 2),   /**< SysTick clock source: AHB */
 } SysTick_ClockSource_t;
 
 /**
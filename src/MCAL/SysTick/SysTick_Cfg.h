@@ -7,10 +7,7 @@
 /************************************************Defines*************************************************/
 /********************************************************************************************************/
 
-/**
- * @brief Defines the AHB Bus clock frequency in Hertz.
- */
-#define SYSTICK_AHB_CLK 16000000UL
+/* The AHB clock is read at run time with RCC_Get_AHB_Frequency */
 
 
 /********************************************************************************************************/
@@ -10,12 +10,17 @@
  *                                Includes                                    *
  *******************************************************************************/
 #include "MCAL/UART/USART.h"
+#include "MCAL/DMA/DMA.h"
+#include "MCAL/RCC/RCC.h"
+#include <stdlib.h>
+#include "LIB/Stm32F401cc.h"
+#include "HAL/Profile/Profile.h"
 /*******************************************************************************
  *                             Definitions                                      *
  *******************************************************************************/
-#define USART1_BA (void *)0x40011000
-#define USART2_BA (void *)0x40004400
-#define USART6_BA (void *)0x40011400
+#define USART1_BA PERIPHERAL_ADDRESS(0x40011000)
+#define USART2_BA PERIPHERAL_ADDRESS(0x40004400)
+#define USART6_BA PERIPHERAL_ADDRESS(0x40011400)
 #define UART_NUMS_IN_TARGET 3
 #define MANTISSA_SHIFT 4
 #define UART_PRE_ENABLE_MASK 0X00002000
@@ -27,6 +32,18 @@
 #define UART_TX_EMPTY_FLAG 0X00000080
 #define UART_RX_NOT_EMPTY_FLAG 0X00000020
 #define UART_TX_DONE_FLAG 0X00000040
+#define UART_DMAT_ENABLE_MASK 0X00000080
+#define UART_DMAR_ENABLE_MASK 0X00000040
+#define UART_IDLE_ENABLE_MASK 0X00000010
+#define UART_IDLE_FLAG 0X00000010
+/* Baud rate divider in clock periods per bit: 16 to 0xFFFF with OVER16, 8 to 0x7FFF with OVER8 */
+#define UART_OVS16_DIV_MIN 16
+#define UART_OVS16_DIV_MAX 0xFFFF
+#define UART_OVS8_DIV_MIN 8
+#define UART_OVS8_DIV_MAX 0x7FFF
+#define UART_OVS8_FRACTION_BITS 3
+#define UART_OVS8_FRACTION_MASK 0x7
+#define PPM 1000000
 /*******************************************************************************
  *                            Types Declaration                                 *
  *******************************************************************************/
@@ -66,6 +83,23 @@ typedef struct
     uint32_t USART_GTPR;
 
 } USART_PERI_t;
+typedef struct
+{
+    uint8_t DMA_ID;
+    uint8_t Stream;
+    uint32_t Channel;
+    DMA_CBF_t CallBack;
+} USART_DMAMap_t;
+typedef struct
+{
+    uint8_t *data;
+    uint32_t size;
+    /* Next position written by the receiver */
+    uint32_t Head;
+    /* Next position to be handed to the run callback */
+    uint32_t Tail;
+    USART_RxRunCb_t CB;
+} USART_RxStream_t;
 
 /*******************************************************************************
  *                              Variables                                       *
@@ -74,9 +108,41 @@ extern const USART_Config_t USARTS[_USART_Num];
 volatile void *const USART[UART_NUMS_IN_TARGET] = {USART1_BA, USART2_BA, USART6_BA};
 static USART_TxReq_t TxReq[_USART_Num];
 static USART_RXReq_t RxReq[_USART_Num];
+static USART_RxStream_t RxStream[_USART_Num];
+/* Baud rate programmed in each USART, indexed by USART ID */
+static USART_BaudInfo_t BaudInfo[UART_NUMS_IN_TARGET];
 uint8_t g_UART1_idx;
 uint8_t g_UART2_idx;
 uint8_t g_UART6_idx;
+/*******************************************************************************
+ *                         Static Function Prototypes		                   *
+ *******************************************************************************/
+static int32_t USART_BaudErrorPPM(uint32_t Clock, uint32_t BaudRate, uint32_t Divider);
+static uint32_t USART_BusClock(uint8_t USART_ID);
+static void USART_DMATxDone(uint8_t Loc_Reqidx, uint32_t Events);
+static void USART1_DMATxCallBack(uint32_t Events);
+static void USART2_DMATxCallBack(uint32_t Events);
+static void USART6_DMATxCallBack(uint32_t Events);
+static void USART_RxStreamDeliver(uint8_t Loc_Reqidx);
+static void USART_RxStreamIRQ(uint8_t Loc_Reqidx);
+static void USART_DMARxEvent(uint8_t Loc_Reqidx, uint32_t Events);
+static void USART1_DMARxCallBack(uint32_t Events);
+static void USART2_DMARxCallBack(uint32_t Events);
+static void USART6_DMARxCallBack(uint32_t Events);
+/* Tx DMA stream and channel of each USART (RM0368 DMA request mapping) */
+static const USART_DMAMap_t USART_TxDMA[UART_NUMS_IN_TARGET] =
+{
+    [USART1_ID] = {.DMA_ID = DMA2_ID, .Stream = DMA_STREAM7, .Channel = DMA_CHANNEL4, .CallBack = USART1_DMATxCallBack},
+    [USART2_ID] = {.DMA_ID = DMA1_ID, .Stream = DMA_STREAM6, .Channel = DMA_CHANNEL4, .CallBack = USART2_DMATxCallBack},
+    [USART6_ID] = {.DMA_ID = DMA2_ID, .Stream = DMA_STREAM6, .Channel = DMA_CHANNEL5, .CallBack = USART6_DMATxCallBack},
+};
+/* Rx DMA stream and channel of each USART (RM0368 DMA request mapping) */
+static const USART_DMAMap_t USART_RxDMA[UART_NUMS_IN_TARGET] =
+{
+    [USART1_ID] = {.DMA_ID = DMA2_ID, .Stream = DMA_STREAM5, .Channel = DMA_CHANNEL4, .CallBack = USART1_DMARxCallBack},
+    [USART2_ID] = {.DMA_ID = DMA1_ID, .Stream = DMA_STREAM5, .Channel = DMA_CHANNEL4, .CallBack = USART2_DMARxCallBack},
+    [USART6_ID] = {.DMA_ID = DMA2_ID, .Stream = DMA_STREAM1, .Channel = DMA_CHANNEL5, .CallBack = USART6_DMARxCallBack},
+};
 /*******************************************************************************
  *                             Implementation                                   *
  *******************************************************************************/
@@ -99,14 +165,10 @@ Error_enumStatus_t USART_Init(void)
     uint32_t Loc_CR1Value = 0;
     /* Control Register 2 value */
     uint32_t Loc_CR2Value = 0;
-    /* Oversampling mode */
-    uint32_t Loc_OVER8 = 0;
-    /* USART Divider value */
-    uint32_t Loc_USARTDIVValue = 0;
-    /* Fractional part of the divider */
-    uint32_t Loc_DIV_Fraction = 0;
-    /* Mantissa part of the divider */
-    uint32_t Loc_DIV_Mantissa = 0;
+    /* Clock of the bus the USART is on */
+    uint32_t Loc_BusClock = 0;
+    /* Status of the baud rate of one USART */
+    Error_enumStatus_t Loc_BaudStatus = Status_enumOk;
 
     /* Check if USART number is valid */
     if (_USART_Num > (USART6_ID + 1))
@@ -118,46 +180,21 @@ Error_enumStatus_t USART_Init(void)
         /* Iterate over each USART */
         for (Loc_idx = 0; Loc_idx < _USART_Num; Loc_idx++)
         {
-            /**
-             * Calculate USARTDIV value to set the required Tx/Rx baud as the equations is
-             * Tx/Rx baud Rate = F_CK / ( 8 × (2 – OVER8) × USARTDIV) )
-             */
-            /** Calculate oversampling mode value
-             * As if i use over sample by 8 the  Loc_OVER8 value will equal 1 otherwise it will equal zero**/
-            Loc_OVER8 = USARTS[Loc_idx].OverSamplingMode / USART_OVS_8;
-            /** Calculate USART Divider value Multiplied by 100 to get the first to fraction digits
-             * As if USARTDIV is equal to 50.99 i make it equals 5099
-             */
-            Loc_USARTDIVValue = (FCPU * 100) / (8 * (2 - Loc_OVER8) * USARTS[Loc_idx].BaudRate);
-            /** Calculate fractional part of divider from the below equation :
-             * DIV_Fraction = ( 8 × (2 – OVER8) * fraction part which it is the first 2 digits from
-             * USARTDIV value after multiply it by 100
-             */
-            Loc_DIV_Fraction = (Loc_USARTDIVValue % 100) * (8 * (2 - Loc_OVER8));
-            /* Adjust fractional part i get the nearest real number for it */
-            if (Loc_DIV_Fraction % 100 != 0)
+            Loc_BusClock = USART_BusClock(USARTS[Loc_idx].USART_ID);
+            /* Divisor and oversampling with the smallest baud rate error */
+            Loc_BaudStatus = USART_CalcBaudRate(Loc_BusClock, USARTS[Loc_idx].BaudRate, USARTS[Loc_idx].OverSamplingMode,
+                                                &BaudInfo[USARTS[Loc_idx].USART_ID]);
+            Loc_BRRValue = BaudInfo[USARTS[Loc_idx].USART_ID].BRR;
+            /* Configure Control Register 1 value, a USART whose baud rate can't be reached is left disabled */
+            Loc_CR1Value = BaudInfo[USARTS[Loc_idx].USART_ID].OverSampling | USARTS[Loc_idx].WordLength | USARTS[Loc_idx].ParityEn | USARTS[Loc_idx].ParityType;
+            if (Loc_BaudStatus == Status_enumOk)
             {
-                /*Got the real value of DIV_Factor after divid it by 100 */
-                Loc_DIV_Fraction = ((Loc_DIV_Fraction / 100) + 1);
+                Loc_CR1Value |= UART_PRE_ENABLE_MASK;
             }
             else
             {
-                Loc_DIV_Fraction = Loc_DIV_Fraction / 100;
+                Loc_enumReturnStatus = Loc_BaudStatus;
             }
-            /* Calculate mantissa part of divider as it uqual the real part of  USARTDIV value so i divid it by 100 */
-            Loc_DIV_Mantissa = Loc_USARTDIVValue / 100;
-            /* Adjust mantissa and fractional parts if needed in case of overflow happened */
-            if (((Loc_OVER8 == 1) && (Loc_DIV_Fraction == 8)) || ((Loc_OVER8 == 0) && (Loc_DIV_Fraction == 16)))
-            {
-                /*Set DIV_Fraction by zero and add the carry to mantissa */
-                Loc_DIV_Fraction = 0;
-                Loc_DIV_Mantissa++;
-            }
-            /* Combine mantissa and fractional parts to get BRR value */
-            Loc_DIV_Mantissa = Loc_DIV_Mantissa << MANTISSA_SHIFT;
-            Loc_BRRValue = Loc_DIV_Mantissa | Loc_DIV_Fraction;
-            /* Configure Control Register 1 value */
-            Loc_CR1Value = UART_PRE_ENABLE_MASK | USARTS[Loc_idx].OverSamplingMode | USARTS[Loc_idx].WordLength | USARTS[Loc_idx].ParityEn | USARTS[Loc_idx].ParityType;
             /* Configure Control Register 2 value */
             Loc_CR2Value = USARTS[Loc_idx].StopBits;
             /* Set BRR value */
@@ -166,6 +203,39 @@ Error_enumStatus_t USART_Init(void)
             ((USART_PERI_t *)USART[USARTS[Loc_idx].USART_ID])->USART_CR1 = Loc_CR1Value;
             /* Set CR2 value */
             ((USART_PERI_t *)USART[USARTS[Loc_idx].USART_ID])->USART_CR2 = Loc_CR2Value;
+            /* Configure the Tx DMA stream and enable DMA transmit requests */
+            if (USARTS[Loc_idx].TxMode == USART_TX_MODE_DMA)
+            {
+                DMA_StreamConfig_t Loc_DMAConfig =
+                {
+                    .DMA_ID = USART_TxDMA[USARTS[Loc_idx].USART_ID].DMA_ID,
+                    .Stream = USART_TxDMA[USARTS[Loc_idx].USART_ID].Stream,
+                    .Channel = USART_TxDMA[USARTS[Loc_idx].USART_ID].Channel,
+                    .Direction = DMA_DIR_MEM_TO_PERIPH,
+                    .Mode = DMA_MODE_NORMAL,
+                    .Priority = DMA_PRIORITY_MEDIUM,
+                    .Interrupts = DMA_INT_TC | DMA_INT_TE,
+                    .CallBack = USART_TxDMA[USARTS[Loc_idx].USART_ID].CallBack,
+                };
+                DMA_ConfigStream(&Loc_DMAConfig);
+                ((USART_PERI_t *)USART[USARTS[Loc_idx].USART_ID])->USART_CR3 |= UART_DMAT_ENABLE_MASK;
+            }
+            /* Configure the Rx DMA stream, it runs in circular mode once continuous reception starts */
+            if (USARTS[Loc_idx].RxMode == USART_RX_MODE_DMA)
+            {
+                DMA_StreamConfig_t Loc_DMAConfig =
+                {
+                    .DMA_ID = USART_RxDMA[USARTS[Loc_idx].USART_ID].DMA_ID,
+                    .Stream = USART_RxDMA[USARTS[Loc_idx].USART_ID].Stream,
+                    .Channel = USART_RxDMA[USARTS[Loc_idx].USART_ID].Channel,
+                    .Direction = DMA_DIR_PERIPH_TO_MEM,
+                    .Mode = DMA_MODE_CIRCULAR,
+                    .Priority = DMA_PRIORITY_HIGH,
+                    .Interrupts = DMA_INT_HT | DMA_INT_TC | DMA_INT_TE,
+                    .CallBack = USART_RxDMA[USARTS[Loc_idx].USART_ID].CallBack,
+                };
+                DMA_ConfigStream(&Loc_DMAConfig);
+            }
             switch (USARTS[Loc_idx].USART_ID)
             {
             case USART1_ID:
@@ -188,6 +258,234 @@ Error_enumStatus_t USART_Init(void)
     return Loc_enumReturnStatus;
 }
 
+/**
+ * @brief    : Clock of the bus a USART is on.
+ * @param[in]: USART_ID USART ID.
+ * @return   : uint32_t Clock in Hz, USART2 is clocked by APB1, USART1 and USART6 by APB2.
+ **/
+static uint32_t USART_BusClock(uint8_t USART_ID)
+{
+    return (USART_ID == USART2_ID) ? RCC_Get_APB1_Frequency() : RCC_Get_APB2_Frequency();
+}
+
+/**
+ * @brief    : Error of the baud rate produced by a divider.
+ * @param[in]: Clock    Clock of the USART in Hz.
+ * @param[in]: BaudRate Requested baud rate.
+ * @param[in]: Divider  Clock periods per bit, 16 x USARTDIV with OVER16 or 8 x USARTDIV with OVER8.
+ * @return   : int32_t (Actual - Requested) / Requested in parts per million, rounded.
+ **/
+static int32_t USART_BaudErrorPPM(uint32_t Clock, uint32_t BaudRate, uint32_t Divider)
+{
+    uint64_t Loc_Bits = (uint64_t)Divider * BaudRate;
+
+    return (int32_t)((((uint64_t)Clock * PPM) + (Loc_Bits / 2)) / Loc_Bits) - PPM;
+}
+
+/**
+ * @brief    : Calculates the baud rate register value for a baud rate.
+ * @param[in]: Clock        Clock of the USART bus in Hz.
+ * @param[in]: BaudRate     Requested baud rate.
+ * @param[in]: OverSampling USART_OVS_16, USART_OVS_8 or USART_OVS_AUTO.
+ * @param[out]: Ptr_Info    Chosen BRR and oversampling, the baud rate they produce and its error.
+ * @return   : Error_enumStatus_t Status_enumWrongInput if the error exceeds USART_BAUD_MAX_ERROR_PPM.
+ * @details  : Both modes divide the clock by an integer number of clock periods per bit, so they
+ *             reach the same rates where both apply. USART_OVS_AUTO keeps OVER16, which samples
+ *             each bit more often, unless OVER8 gets strictly closer to the requested rate, which
+ *             is the case above Clock / 16. Ptr_Info is filled even when the rate is rejected.
+ **/
+Error_enumStatus_t USART_CalcBaudRate(uint32_t Clock, uint32_t BaudRate, uint32_t OverSampling, USART_BaudInfo_t *Ptr_Info)
+{
+    /* Local Variable to store error status */
+    Error_enumStatus_t Loc_enumReturnStatus = Status_enumOk;
+    /* Oversampling modes tried, OVER16 first */
+    const uint32_t Loc_Modes[2] = {USART_OVS_16, USART_OVS_8};
+    uint32_t Loc_BestDivider = 0;
+    uint32_t Loc_BestMode = USART_OVS_16;
+    int32_t Loc_BestError = 0;
+    uint8_t Loc_Mode;
+
+    if (Ptr_Info == NULL)
+    {
+        Loc_enumReturnStatus = Status_enumNULLPointer;
+    }
+    else if ((Clock == 0) || (BaudRate == 0) ||
+             ((OverSampling != USART_OVS_16) && (OverSampling != USART_OVS_8) && (OverSampling != USART_OVS_AUTO)))
+    {
+        Loc_enumReturnStatus = Status_enumWrongInput;
+    }
+    else
+    {
+        for (Loc_Mode = 0; Loc_Mode < 2; Loc_Mode++)
+        {
+            uint32_t Loc_Min = (Loc_Modes[Loc_Mode] == USART_OVS_8) ? UART_OVS8_DIV_MIN : UART_OVS16_DIV_MIN;
+            uint32_t Loc_Max = (Loc_Modes[Loc_Mode] == USART_OVS_8) ? UART_OVS8_DIV_MAX : UART_OVS16_DIV_MAX;
+            /* The dividers on both sides of Clock / BaudRate, clamped to the range of the mode */
+            uint32_t Loc_Candidates[2] = {Clock / BaudRate, (Clock / BaudRate) + 1};
+            uint8_t Loc_Candidate;
+
+            if ((OverSampling != USART_OVS_AUTO) && (OverSampling != Loc_Modes[Loc_Mode]))
+            {
+                continue;
+            }
+            for (Loc_Candidate = 0; Loc_Candidate < 2; Loc_Candidate++)
+            {
+                uint32_t Loc_Divider = Loc_Candidates[Loc_Candidate];
+                int32_t Loc_Error;
+
+                Loc_Divider = (Loc_Divider < Loc_Min) ? Loc_Min : ((Loc_Divider > Loc_Max) ? Loc_Max : Loc_Divider);
+                Loc_Error = USART_BaudErrorPPM(Clock, BaudRate, Loc_Divider);
+                /* Strictly better only, so ties keep OVER16 and the lower divider */
+                if ((Loc_BestDivider == 0) || (abs(Loc_Error) < abs(Loc_BestError)))
+                {
+                    Loc_BestDivider = Loc_Divider;
+                    Loc_BestMode = Loc_Modes[Loc_Mode];
+                    Loc_BestError = Loc_Error;
+                }
+            }
+        }
+
+        Ptr_Info->OverSampling = Loc_BestMode;
+        Ptr_Info->ErrorPPM = Loc_BestError;
+        Ptr_Info->ActualBaudRate = (Clock + (Loc_BestDivider / 2)) / Loc_BestDivider;
+        /* With OVER8 the 3 bit fraction sits in BRR[2:0] and BRR[3] stays clear */
+        if (Loc_BestMode == USART_OVS_8)
+        {
+            Ptr_Info->BRR = ((Loc_BestDivider >> UART_OVS8_FRACTION_BITS) << MANTISSA_SHIFT) |
+                            (Loc_BestDivider & UART_OVS8_FRACTION_MASK);
+        }
+        else
+        {
+            Ptr_Info->BRR = Loc_BestDivider;
+        }
+        if (abs(Loc_BestError) > USART_BAUD_MAX_ERROR_PPM)
+        {
+            Loc_enumReturnStatus = Status_enumWrongInput;
+        }
+    }
+    /* Return the status of the calculation */
+    return Loc_enumReturnStatus;
+}
+
+/**
+ * @brief    : Gets the baud rate programmed in a USART.
+ * @param[in]: USART_ID   USART ID.
+ * @param[out]: Ptr_Info  BRR, oversampling, baud rate and error chosen by USART_Init.
+ * @return   : Error_enumStatus_t Error status indicating the success or failure of the operation.
+ **/
+Error_enumStatus_t USART_GetBaudInfo(uint8_t USART_ID, USART_BaudInfo_t *Ptr_Info)
+{
+    /* Local Variable to store error status */
+    Error_enumStatus_t Loc_enumReturnStatus = Status_enumOk;
+
+    if (Ptr_Info == NULL)
+    {
+        Loc_enumReturnStatus = Status_enumNULLPointer;
+    }
+    else if (USART_ID >= UART_NUMS_IN_TARGET)
+    {
+        Loc_enumReturnStatus = Status_enumWrongInput;
+    }
+    else
+    {
+        *Ptr_Info = BaudInfo[USART_ID];
+    }
+    /* Return the status of the operation */
+    return Loc_enumReturnStatus;
+}
+
+/**
+ * @brief    : Calculates the baud rate register value a USART would use for a baud rate.
+ * @param[in]: USART_ID   USART ID.
+ * @param[in]: BaudRate   Requested baud rate.
+ * @param[out]: Ptr_Info  BRR, oversampling, baud rate and error USART_SetBaudRate would program.
+ * @return   : Error_enumStatus_t Status_enumWrongInput if the error exceeds USART_BAUD_MAX_ERROR_PPM.
+ * @details  : Uses the current clock of the bus the USART is on and its configured oversampling mode.
+ *             Nothing is written to the USART.
+ **/
+Error_enumStatus_t USART_CheckBaudRate(uint8_t USART_ID, uint32_t BaudRate, USART_BaudInfo_t *Ptr_Info)
+{
+    /* Local Variable to store error status */
+    Error_enumStatus_t Loc_enumReturnStatus = Status_enumOk;
+    uint8_t Loc_Reqidx = 0;
+
+    switch (USART_ID)
+    {
+    case USART1_ID:
+        Loc_Reqidx = g_UART1_idx;
+        break;
+    case USART2_ID:
+        Loc_Reqidx = g_UART2_idx;
+        break;
+    case USART6_ID:
+        Loc_Reqidx = g_UART6_idx;
+        break;
+    default:
+        Loc_enumReturnStatus = Status_enumWrongInput;
+        break;
+    }
+    if (Loc_enumReturnStatus == Status_enumOk)
+    {
+        Loc_enumReturnStatus = USART_CalcBaudRate(USART_BusClock(USART_ID), BaudRate,
+                                                  USARTS[Loc_Reqidx].OverSamplingMode, Ptr_Info);
+    }
+    /* Return the status of the calculation */
+    return Loc_enumReturnStatus;
+}
+
+/**
+ * @brief    : Changes the baud rate of an initialized USART.
+ * @param[in]: USART_ID USART ID.
+ * @param[in]: BaudRate New baud rate.
+ * @return   : Error_enumStatus_t Status_enumBusyState while a transmission is in progress or the last
+ *             frame is still in the shift register (TC clear), Status_enumWrongInput if the rate can't
+ *             be reached, in both cases the USART keeps its current rate.
+ * @details  : The USART is disabled while BRR and OVER8 change, a frame being received at that
+ *             moment is lost. The new rate is reported by USART_GetBaudInfo.
+ **/
+Error_enumStatus_t USART_SetBaudRate(uint8_t USART_ID, uint32_t BaudRate)
+{
+    /* Local Variable to store error status */
+    Error_enumStatus_t Loc_enumReturnStatus = Status_enumOk;
+    USART_BaudInfo_t Loc_Info;
+    uint8_t Loc_Reqidx = 0;
+
+    Loc_enumReturnStatus = USART_CheckBaudRate(USART_ID, BaudRate, &Loc_Info);
+    if (Loc_enumReturnStatus == Status_enumOk)
+    {
+        volatile USART_PERI_t *const Loc_USART = (USART_PERI_t *)USART[USART_ID];
+
+        switch (USART_ID)
+        {
+        case USART1_ID:
+            Loc_Reqidx = g_UART1_idx;
+            break;
+        case USART2_ID:
+            Loc_Reqidx = g_UART2_idx;
+            break;
+        default:
+            Loc_Reqidx = g_UART6_idx;
+            break;
+        }
+        /* Changing BRR while a frame is on the wire would corrupt it */
+        if ((TxReq[Loc_Reqidx].state == USART_ReqBusy) || ((Loc_USART->USART_SR & UART_TX_DONE_FLAG) == 0))
+        {
+            Loc_enumReturnStatus = Status_enumBusyState;
+        }
+        else
+        {
+            uint32_t Loc_CR1Value = Loc_USART->USART_CR1;
+
+            Loc_USART->USART_CR1 = Loc_CR1Value & ~UART_PRE_ENABLE_MASK;
+            Loc_USART->USART_BRR = Loc_Info.BRR;
+            Loc_USART->USART_CR1 = (Loc_CR1Value & ~USART_OVS_8) | Loc_Info.OverSampling | UART_PRE_ENABLE_MASK;
+            BaudInfo[USART_ID] = Loc_Info;
+        }
+    }
+    /* Return the status of the operation */
+    return Loc_enumReturnStatus;
+}
+
 /**
  * @brief    : Asynchronously transmits data over USART.
  * @param[in]: Ptr_UserReq Pointer to USART user request structure containing transmit parameters.
@@ -238,11 +536,30 @@ Error_enumStatus_t USART_TxBufferAsyncZeroCopy(USART_UserReq_t *Ptr_UserReq)
             TxReq[Loc_Reqidx].CB = Ptr_UserReq->Buff_cb;
             /* Enable USART transmit */
             ((USART_PERI_t *)USART[Loc_Reqidx])->USART_CR1 |= UART_TX_ENABLE_MASK;
-            /* Load first byte of data into USART data register */
-            ((USART_PERI_t *)USART[Loc_Reqidx])->USART_DR = TxReq[Loc_Reqidx].buffer.data[0];
-            TxReq[Loc_Reqidx].buffer.Pos++;
-            /* Enable USART transmit data register empty interrupt */
-            ((USART_PERI_t *)USART[Loc_Reqidx])->USART_CR1 |= UART_TXE_ENABLE_MASK;
+            if (USARTS[Loc_Reqidx].TxMode == USART_TX_MODE_DMA)
+            {
+                /* Clear TC flag so it reflects this transfer, SR flags are rc_w0 so write the mask
+                   instead of a read-modify-write that could clear a flag set in between */
+                ((USART_PERI_t *)USART[Loc_Reqidx])->USART_SR = ~UART_TX_DONE_FLAG;
+                /* Let the DMA stream move the whole buffer into the data register */
+                if (DMA_StartTransfer(USART_TxDMA[USARTS[Loc_Reqidx].USART_ID].DMA_ID,
+                                      USART_TxDMA[USARTS[Loc_Reqidx].USART_ID].Stream,
+                                      (uint32_t)(uintptr_t) & (((USART_PERI_t *)USART[Loc_Reqidx])->USART_DR),
+                                      (uint32_t)(uintptr_t)TxReq[Loc_Reqidx].buffer.data,
+                                      TxReq[Loc_Reqidx].buffer.size) != Status_enumOk)
+                {
+                    TxReq[Loc_Reqidx].state = USART_ReqReady;
+                    Loc_enumReturnStatus = Status_enumNotOk;
+                }
+            }
+            else
+            {
+                /* Load first byte of data into USART data register */
+                REG_WRITE(((USART_PERI_t *)USART[Loc_Reqidx])->USART_DR, TxReq[Loc_Reqidx].buffer.data[0]);
+                TxReq[Loc_Reqidx].buffer.Pos++;
+                /* Enable USART transmit data register empty interrupt */
+                ((USART_PERI_t *)USART[Loc_Reqidx])->USART_CR1 |= UART_TXE_ENABLE_MASK;
+            }
         }
         else
         {
@@ -316,6 +633,152 @@ Error_enumStatus_t USART_RxBufferAsyncZeroCopy(USART_UserReq_t *Ptr_UserReq)
     return Loc_enumReturnStatus;
 }
 
+/**
+ * @brief    : Starts continuous reception into a circular buffer.
+ * @param[in]: Ptr_StreamReq Pointer to USART continuous receive request structure.
+ * @return   : Error_enumStatus_t Error status indicating the success or failure of the operation.
+ * @details  : This function checks for NULL pointer input and the state of the USART receive request.
+ *             If the receiver is free, it marks it busy until USART_RxStreamStop is called,
+ *             enables USART receive and the IDLE line interrupt, and then starts either the
+ *             circular Rx DMA stream or the receive data register not empty interrupt.
+ **/
+Error_enumStatus_t USART_RxStreamStart(USART_RxStreamReq_t *Ptr_StreamReq)
+{
+    /* Local Variable to store error status */
+    Error_enumStatus_t Loc_enumReturnStatus = Status_enumOk;
+    uint8_t Loc_Reqidx = 0;
+    /* Check for NULL pointer */
+    if ((Ptr_StreamReq == NULL) || (Ptr_StreamReq->Ptr_buffer == NULL) || (Ptr_StreamReq->Run_cb == NULL))
+    {
+        Loc_enumReturnStatus = Status_enumNULLPointer;
+    }
+    else if (Ptr_StreamReq->Buff_Len < 2)
+    {
+        Loc_enumReturnStatus = Status_enumWrongInput;
+    }
+    else
+    {
+        switch (Ptr_StreamReq->USART_ID)
+        {
+        case USART1_ID:
+            Loc_Reqidx = g_UART1_idx;
+            break;
+        case USART2_ID:
+            Loc_Reqidx = g_UART2_idx;
+            break;
+        case USART6_ID:
+            Loc_Reqidx = g_UART6_idx;
+            break;
+        default:
+            Loc_enumReturnStatus = Status_enumNotOk;
+            break;
+        }
+        if (Loc_enumReturnStatus != Status_enumOk)
+        {
+            /* Unknown USART */
+        }
+        else if (RxReq[Loc_Reqidx].state == USART_ReqReady)
+        {
+            volatile USART_PERI_t *const Loc_USART = (volatile USART_PERI_t *)USART[Loc_Reqidx];
+
+            /* The receiver stays busy until the stream is stopped */
+            RxReq[Loc_Reqidx].state = USART_ReqBusy;
+            RxStream[Loc_Reqidx].data = Ptr_StreamReq->Ptr_buffer;
+            RxStream[Loc_Reqidx].size = Ptr_StreamReq->Buff_Len;
+            RxStream[Loc_Reqidx].Head = 0;
+            RxStream[Loc_Reqidx].Tail = 0;
+            /* Enable USART receive */
+            Loc_USART->USART_CR1 |= UART_RX_ENABLE_MASK;
+            /* Drop stale data and flags, reading SR then DR clears IDLE and ORE */
+            (void)Loc_USART->USART_SR;
+            (void)REG_READ(Loc_USART->USART_DR);
+            if (USARTS[Loc_Reqidx].RxMode == USART_RX_MODE_DMA)
+            {
+                /* Let the DMA stream fill the buffer in circular mode */
+                Loc_enumReturnStatus = DMA_StartTransfer(USART_RxDMA[USARTS[Loc_Reqidx].USART_ID].DMA_ID,
+                                                         USART_RxDMA[USARTS[Loc_Reqidx].USART_ID].Stream,
+                                                         (uint32_t)(uintptr_t) & (Loc_USART->USART_DR),
+                                                         (uint32_t)(uintptr_t)RxStream[Loc_Reqidx].data,
+                                                         RxStream[Loc_Reqidx].size);
+                Loc_USART->USART_CR3 |= UART_DMAR_ENABLE_MASK;
+            }
+            else
+            {
+                /* Enable USART receive data register not empty interrupt */
+                Loc_USART->USART_CR1 |= UART_RXE_ENABLE_MASK;
+            }
+            if (Loc_enumReturnStatus == Status_enumOk)
+            {
+                RxStream[Loc_Reqidx].CB = Ptr_StreamReq->Run_cb;
+                /* Enable IDLE line interrupt to flush short runs */
+                Loc_USART->USART_CR1 |= UART_IDLE_ENABLE_MASK;
+            }
+            else
+            {
+                Loc_USART->USART_CR3 &= ~UART_DMAR_ENABLE_MASK;
+                RxReq[Loc_Reqidx].state = USART_ReqReady;
+            }
+        }
+        else
+        {
+            Loc_enumReturnStatus = Status_enumBusyState;
+        }
+    }
+
+    /* Return the status of the operation */
+    return Loc_enumReturnStatus;
+}
+
+/**
+ * @brief    : Stops continuous reception.
+ * @param[in]: USART_ID   USART ID.
+ * @return   : Error_enumStatus_t Error status indicating the success or failure of the operation.
+ * @details  : This function disables the receive interrupts and the Rx DMA stream, hands the
+ *             bytes that are still pending to the run callback and releases the receiver.
+ **/
+Error_enumStatus_t USART_RxStreamStop(uint8_t USART_ID)
+{
+    /* Local Variable to store error status */
+    Error_enumStatus_t Loc_enumReturnStatus = Status_enumOk;
+    uint8_t Loc_Reqidx = 0;
+
+    switch (USART_ID)
+    {
+    case USART1_ID:
+        Loc_Reqidx = g_UART1_idx;
+        break;
+    case USART2_ID:
+        Loc_Reqidx = g_UART2_idx;
+        break;
+    case USART6_ID:
+        Loc_Reqidx = g_UART6_idx;
+        break;
+    default:
+        Loc_enumReturnStatus = Status_enumNotOk;
+        break;
+    }
+    if ((Loc_enumReturnStatus == Status_enumOk) && (RxStream[Loc_Reqidx].CB != NULL))
+    {
+        volatile USART_PERI_t *const Loc_USART = (volatile USART_PERI_t *)USART[Loc_Reqidx];
+
+        /* Disable IDLE line and receive data register not empty interrupts */
+        Loc_USART->USART_CR1 &= ~(UART_IDLE_ENABLE_MASK | UART_RXE_ENABLE_MASK);
+        if (USARTS[Loc_Reqidx].RxMode == USART_RX_MODE_DMA)
+        {
+            Loc_USART->USART_CR3 &= ~UART_DMAR_ENABLE_MASK;
+            Loc_enumReturnStatus = DMA_StopStream(USART_RxDMA[USARTS[Loc_Reqidx].USART_ID].DMA_ID,
+                                                  USART_RxDMA[USARTS[Loc_Reqidx].USART_ID].Stream);
+        }
+        /* Hand over what is left before releasing the buffer */
+        USART_RxStreamDeliver(Loc_Reqidx);
+        RxStream[Loc_Reqidx].CB = NULL;
+        RxReq[Loc_Reqidx].state = USART_ReqReady;
+    }
+
+    /* Return the status of the operation */
+    return Loc_enumReturnStatus;
+}
+
 /**
  * @brief    : Transmits a single byte over USART.
  * @param[in]: Ptr_UserReq Pointer to USART user request structure containing transmit parameters.
@@ -365,7 +828,7 @@ Error_enumStatus_t USART_SendByte(USART_UserReq_t *Ptr_UserReq)
             ((USART_PERI_t *)USART[Loc_Reqidx])->USART_CR1 |= UART_TX_ENABLE_MASK;
 
             /* Transmit the byte of data */
-            ((USART_PERI_t *)USART[Loc_Reqidx])->USART_DR = *(Ptr_UserReq->Ptr_buffer);
+            REG_WRITE(((USART_PERI_t *)USART[Loc_Reqidx])->USART_DR, *(Ptr_UserReq->Ptr_buffer));
             /* Wait for transmission to complete */
             while ((((((USART_PERI_t *)USART[Loc_Reqidx])->USART_SR) & (UART_TX_EMPTY_FLAG)) == 0) && Time)
             {
@@ -451,13 +914,13 @@ Error_enumStatus_t USART_GetByte(USART_UserReq_t *Ptr_UserReq)
                 else
                 {
                     /* Read the received byte */
-                    *(Ptr_UserReq->Ptr_buffer) = ((USART_PERI_t *)USART[Loc_Reqidx])->USART_DR;
+                    *(Ptr_UserReq->Ptr_buffer) = REG_READ(((USART_PERI_t *)USART[Loc_Reqidx])->USART_DR);
                 }
             }
             else
             {
                 /* Read the received byte */
-                *(Ptr_UserReq->Ptr_buffer) = ((USART_PERI_t *)USART[Loc_Reqidx])->USART_DR;
+                *(Ptr_UserReq->Ptr_buffer) = REG_READ(((USART_PERI_t *)USART[Loc_Reqidx])->USART_DR);
             }
             /* Disable USART receive */
             ((USART_PERI_t *)USART[Loc_Reqidx])->USART_CR1 &= ~UART_RX_ENABLE_MASK;
@@ -580,25 +1043,26 @@ Error_enumStatus_t USART_IsRx(uint8_t USART_ID, uint8_t *Ptr_Status)
  **/
 void USART1_IRQHandler(void)
 {
+    PROFILE_BEGIN(Lo_ProfileStart);
     /* Local Variable to store CR1 value */
     uint32_t Lo_CR1_Value = ((USART_PERI_t *)USART[g_UART1_idx])->USART_CR1;
 
-    /* Check if USART transmission is empty */
-    if ((((USART_PERI_t *)USART[g_UART1_idx])->USART_SR) & UART_TX_EMPTY_FLAG)
+    /* Check if USART transmission is empty while the TXE interrupt is in use */
+    if (((((USART_PERI_t *)USART[g_UART1_idx])->USART_SR) & UART_TX_EMPTY_FLAG) && (Lo_CR1_Value & UART_TXE_ENABLE_MASK))
     {
         /* Check if there are more bytes to transmit */
         if ((TxReq[g_UART1_idx].buffer.Pos) < (TxReq[g_UART1_idx].buffer.size))
         {
             /* Transmit the next byte */
-            ((USART_PERI_t *)USART[g_UART1_idx])->USART_DR = TxReq[g_UART1_idx].buffer.data[TxReq[g_UART1_idx].buffer.Pos];
+            REG_WRITE(((USART_PERI_t *)USART[g_UART1_idx])->USART_DR, TxReq[g_UART1_idx].buffer.data[TxReq[g_UART1_idx].buffer.Pos]);
             TxReq[g_UART1_idx].buffer.Pos++;
         }
         else
         {
             /* Disable TXE interrupt */
-           // Lo_CR1_Value &= ~(UART_TXE_ENABLE_MASK);
+            Lo_CR1_Value &= ~(UART_TXE_ENABLE_MASK);
             TxReq[g_UART1_idx].state = USART_ReqReady;
-        //    ((USART_PERI_t *)USART[g_UART1_idx])->USART_CR1 = Lo_CR1_Value;
+            ((USART_PERI_t *)USART[g_UART1_idx])->USART_CR1 = Lo_CR1_Value;
             /* Call callback function if available */
             if (TxReq[g_UART1_idx].CB)
             {
@@ -606,14 +1070,19 @@ void USART1_IRQHandler(void)
             }
         }
     }
+    /* Continuous reception owns the receiver while it is running */
+    if (RxStream[g_UART1_idx].CB)
+    {
+        USART_RxStreamIRQ(g_UART1_idx);
+    }
     /* Check if USART reception is not empty */
-    if ((((USART_PERI_t *)USART[g_UART1_idx])->USART_SR) & UART_RX_NOT_EMPTY_FLAG)
+    else if ((((USART_PERI_t *)USART[g_UART1_idx])->USART_SR) & UART_RX_NOT_EMPTY_FLAG)
     {
         /* Check if there are more bytes to receive */
         if (RxReq[g_UART1_idx].buffer.Pos < RxReq[g_UART1_idx].buffer.size)
         {
             /* Receive the next byte */
-            RxReq[g_UART1_idx].buffer.data[RxReq[g_UART1_idx].buffer.Pos] = ((USART_PERI_t *)USART[g_UART1_idx])->USART_DR;
+            RxReq[g_UART1_idx].buffer.data[RxReq[g_UART1_idx].buffer.Pos] = REG_READ(((USART_PERI_t *)USART[g_UART1_idx])->USART_DR);
             RxReq[g_UART1_idx].buffer.Pos++;
             /* Check if all bytes are received */
             if (RxReq[g_UART1_idx].buffer.Pos == RxReq[g_UART1_idx].buffer.size)
@@ -630,6 +1099,7 @@ void USART1_IRQHandler(void)
             }
         }
     }
+    PROFILE_END(PROFILE_PROBE_USART1_IRQ, Lo_ProfileStart);
 }
 
 /**
@@ -642,14 +1112,14 @@ void USART2_IRQHandler(void)
     /* Local Variable to store CR1 value */
     uint32_t Lo_CR1_Value = ((USART_PERI_t *)USART[g_UART2_idx])->USART_CR1;
 
-    /* Check if USART transmission is empty */
-    if ((((USART_PERI_t *)USART[g_UART2_idx])->USART_SR) & UART_TX_EMPTY_FLAG)
+    /* Check if USART transmission is empty while the TXE interrupt is in use */
+    if (((((USART_PERI_t *)USART[g_UART2_idx])->USART_SR) & UART_TX_EMPTY_FLAG) && (Lo_CR1_Value & UART_TXE_ENABLE_MASK))
     {
         /* Check if there are more bytes to transmit */
         if ((TxReq[g_UART2_idx].buffer.Pos) < (TxReq[g_UART2_idx].buffer.size))
         {
             /* Transmit the next byte */
-            ((USART_PERI_t *)USART[g_UART2_idx])->USART_DR = TxReq[g_UART2_idx].buffer.data[TxReq[g_UART2_idx].buffer.Pos];
+            REG_WRITE(((USART_PERI_t *)USART[g_UART2_idx])->USART_DR, TxReq[g_UART2_idx].buffer.data[TxReq[g_UART2_idx].buffer.Pos]);
             TxReq[g_UART2_idx].buffer.Pos++;
         }
         else
@@ -665,14 +1135,19 @@ void USART2_IRQHandler(void)
             }
         }
     }
+    /* Continuous reception owns the receiver while it is running */
+    if (RxStream[g_UART2_idx].CB)
+    {
+        USART_RxStreamIRQ(g_UART2_idx);
+    }
     /* Check if USART reception is not empty */
-    if ((((USART_PERI_t *)USART[g_UART2_idx])->USART_SR) & UART_RX_NOT_EMPTY_FLAG)
+    else if ((((USART_PERI_t *)USART[g_UART2_idx])->USART_SR) & UART_RX_NOT_EMPTY_FLAG)
     {
         /* Check if there are more bytes to receive */
         if (RxReq[g_UART2_idx].buffer.Pos < RxReq[g_UART2_idx].buffer.size)
         {
             /* Receive the next byte */
-            RxReq[g_UART2_idx].buffer.data[RxReq[g_UART2_idx].buffer.Pos] = ((USART_PERI_t *)USART[g_UART2_idx])->USART_DR;
+            RxReq[g_UART2_idx].buffer.data[RxReq[g_UART2_idx].buffer.Pos] = REG_READ(((USART_PERI_t *)USART[g_UART2_idx])->USART_DR);
             RxReq[g_UART2_idx].buffer.Pos++;
             /* Check if all bytes are received */
             if (RxReq[g_UART2_idx].buffer.Pos == RxReq[g_UART2_idx].buffer.size)
@@ -700,14 +1175,14 @@ void USART6_IRQHandler(void)
     /* Local Variable to store CR1 value */
     uint32_t Lo_CR1_Value = ((USART_PERI_t *)USART[g_UART6_idx])->USART_CR1;
 
-    /* Check if USART transmission is empty */
-    if ((((USART_PERI_t *)USART[g_UART6_idx])->USART_SR) & UART_TX_EMPTY_FLAG)
+    /* Check if USART transmission is empty while the TXE interrupt is in use */
+    if (((((USART_PERI_t *)USART[g_UART6_idx])->USART_SR) & UART_TX_EMPTY_FLAG) && (Lo_CR1_Value & UART_TXE_ENABLE_MASK))
     {
         /* Check if there are more bytes to transmit */
         if ((TxReq[g_UART6_idx].buffer.Pos) < (TxReq[g_UART6_idx].buffer.size))
         {
             /* Transmit the next byte */
-            ((USART_PERI_t *)USART[g_UART6_idx])->USART_DR = TxReq[g_UART6_idx].buffer.data[TxReq[g_UART6_idx].buffer.Pos];
+            REG_WRITE(((USART_PERI_t *)USART[g_UART6_idx])->USART_DR, TxReq[g_UART6_idx].buffer.data[TxReq[g_UART6_idx].buffer.Pos]);
             TxReq[g_UART6_idx].buffer.Pos++;
         }
         else
@@ -723,14 +1198,19 @@ void USART6_IRQHandler(void)
             }
         }
     }
+    /* Continuous reception owns the receiver while it is running */
+    if (RxStream[g_UART6_idx].CB)
+    {
+        USART_RxStreamIRQ(g_UART6_idx);
+    }
     /* Check if USART reception is not empty */
-    if ((((USART_PERI_t *)USART[g_UART6_idx])->USART_SR) & UART_RX_NOT_EMPTY_FLAG)
+    else if ((((USART_PERI_t *)USART[g_UART6_idx])->USART_SR) & UART_RX_NOT_EMPTY_FLAG)
     {
         /* Check if there are more bytes to receive */
         if (RxReq[g_UART6_idx].buffer.Pos < RxReq[g_UART6_idx].buffer.size)
         {
             /* Receive the next byte */
-            RxReq[g_UART6_idx].buffer.data[RxReq[g_UART6_idx].buffer.Pos] = ((USART_PERI_t *)USART[g_UART6_idx])->USART_DR;
+            RxReq[g_UART6_idx].buffer.data[RxReq[g_UART6_idx].buffer.Pos] = REG_READ(((USART_PERI_t *)USART[g_UART6_idx])->USART_DR);
             RxReq[g_UART6_idx].buffer.Pos++;
             /* Check if all bytes are received */
             if (RxReq[g_UART6_idx].buffer.Pos == RxReq[g_UART6_idx].buffer.size)
@@ -747,3 +1227,152 @@ void USART6_IRQHandler(void)
         }
     }
 }
+
+/**
+ * @brief    : Handles the end of a DMA transmission.
+ * @param[in]: Loc_Reqidx Index of the USART in the configuration array.
+ * @param[in]: Events     DMA events reported by the stream.
+ * @details  : Releases the transmit request and calls the user callback once per buffer.
+ **/
+static void USART_DMATxDone(uint8_t Loc_Reqidx, uint32_t Events)
+{
+    if (Events & (DMA_EVENT_TC | DMA_EVENT_TE))
+    {
+        TxReq[Loc_Reqidx].buffer.Pos = TxReq[Loc_Reqidx].buffer.size;
+        TxReq[Loc_Reqidx].state = USART_ReqReady;
+        /* Call callback function if available */
+        if (TxReq[Loc_Reqidx].CB)
+        {
+            TxReq[Loc_Reqidx].CB();
+        }
+    }
+}
+
+static void USART1_DMATxCallBack(uint32_t Events)
+{
+    USART_DMATxDone(g_UART1_idx, Events);
+}
+
+static void USART2_DMATxCallBack(uint32_t Events)
+{
+    USART_DMATxDone(g_UART2_idx, Events);
+}
+
+static void USART6_DMATxCallBack(uint32_t Events)
+{
+    USART_DMATxDone(g_UART6_idx, Events);
+}
+
+/**
+ * @brief    : Hands the bytes received since the last call to the run callback.
+ * @param[in]: Loc_Reqidx Index of the USART in the configuration array.
+ * @details  : In DMA mode the write position is taken from the stream NDTR register,
+ *             otherwise it is the position kept by the RXNE interrupt.
+ *             A run that wraps around the end of the buffer is reported as two runs.
+ **/
+static void USART_RxStreamDeliver(uint8_t Loc_Reqidx)
+{
+    USART_RxStream_t *const Loc_Stream = &RxStream[Loc_Reqidx];
+    uint32_t Loc_Head = Loc_Stream->Head;
+
+    if (USARTS[Loc_Reqidx].RxMode == USART_RX_MODE_DMA)
+    {
+        uint32_t Loc_Remaining = 0;
+        DMA_GetRemaining(USART_RxDMA[USARTS[Loc_Reqidx].USART_ID].DMA_ID,
+                         USART_RxDMA[USARTS[Loc_Reqidx].USART_ID].Stream, &Loc_Remaining);
+        /* NDTR counts down and reloads with the buffer size at the end of each lap */
+        Loc_Head = (Loc_Remaining >= Loc_Stream->size) ? 0 : (Loc_Stream->size - Loc_Remaining);
+        Loc_Stream->Head = Loc_Head;
+    }
+    if (Loc_Head < Loc_Stream->Tail)
+    {
+        /* Deliver up to the end of the buffer first */
+        Loc_Stream->CB(&Loc_Stream->data[Loc_Stream->Tail], Loc_Stream->size - Loc_Stream->Tail);
+        Loc_Stream->Tail = 0;
+    }
+    if (Loc_Head > Loc_Stream->Tail)
+    {
+        Loc_Stream->CB(&Loc_Stream->data[Loc_Stream->Tail], Loc_Head - Loc_Stream->Tail);
+        Loc_Stream->Tail = Loc_Head;
+    }
+}
+
+/**
+ * @brief    : Continuous reception part of the USART interrupt handlers.
+ * @param[in]: Loc_Reqidx Index of the USART in the configuration array.
+ * @details  : In interrupt mode each received byte is stored at the write position and a run
+ *             is delivered when the buffer is half or completely filled, mirroring the DMA
+ *             half/full transfer interrupts. In both modes an IDLE line delivers the pending run.
+ **/
+static void USART_RxStreamIRQ(uint8_t Loc_Reqidx)
+{
+    volatile USART_PERI_t *const Loc_USART = (volatile USART_PERI_t *)USART[Loc_Reqidx];
+    USART_RxStream_t *const Loc_Stream = &RxStream[Loc_Reqidx];
+    uint32_t Loc_SRValue = Loc_USART->USART_SR;
+
+    /* Check if USART reception is not empty while the RXNE interrupt is in use */
+    if ((Loc_SRValue & UART_RX_NOT_EMPTY_FLAG) && (Loc_USART->USART_CR1 & UART_RXE_ENABLE_MASK))
+    {
+        Loc_Stream->data[Loc_Stream->Head] = (uint8_t)REG_READ(Loc_USART->USART_DR);
+        Loc_Stream->Head++;
+        if (Loc_Stream->Head == Loc_Stream->size)
+        {
+            Loc_Stream->Head = 0;
+            USART_RxStreamDeliver(Loc_Reqidx);
+        }
+        else if (Loc_Stream->Head == (Loc_Stream->size / 2))
+        {
+            USART_RxStreamDeliver(Loc_Reqidx);
+        }
+    }
+    /* Check if the line went idle after a run of bytes */
+    if (Loc_SRValue & UART_IDLE_FLAG)
+    {
+        /* Reading DR after SR clears IDLE, unless a new byte is waiting to be read by the next interrupt */
+        if ((Loc_USART->USART_SR & UART_RX_NOT_EMPTY_FLAG) == 0)
+        {
+            (void)REG_READ(Loc_USART->USART_DR);
+        }
+        USART_RxStreamDeliver(Loc_Reqidx);
+    }
+}
+
+/**
+ * @brief    : Handles the Rx DMA stream events of continuous reception.
+ * @param[in]: Loc_Reqidx Index of the USART in the configuration array.
+ * @param[in]: Events     DMA events reported by the stream.
+ * @details  : Half and full transfer events deliver the filled half of the buffer. A transfer
+ *             error disables the stream, so reception is restarted from the start of the buffer.
+ **/
+static void USART_DMARxEvent(uint8_t Loc_Reqidx, uint32_t Events)
+{
+    if (RxStream[Loc_Reqidx].CB)
+    {
+        USART_RxStreamDeliver(Loc_Reqidx);
+        if (Events & DMA_EVENT_TE)
+        {
+            RxStream[Loc_Reqidx].Head = 0;
+            RxStream[Loc_Reqidx].Tail = 0;
+            DMA_StartTransfer(USART_RxDMA[USARTS[Loc_Reqidx].USART_ID].DMA_ID,
+                              USART_RxDMA[USARTS[Loc_Reqidx].USART_ID].Stream,
+                              (uint32_t)(uintptr_t) & (((USART_PERI_t *)USART[Loc_Reqidx])->USART_DR),
+                              (uint32_t)(uintptr_t)RxStream[Loc_Reqidx].data,
+                              RxStream[Loc_Reqidx].size);
+        }
+    }
+}
+
+static void USART1_DMARxCallBack(uint32_t Events)
+{
+    USART_DMARxEvent(g_UART1_idx, Events);
+}
+
+static void USART2_DMARxCallBack(uint32_t Events)
+{
+    USART_DMARxEvent(g_UART2_idx, Events);
+}
+
+static void USART6_DMARxCallBack(uint32_t Events)
+{
+    USART_DMARxEvent(g_UART6_idx, Events);
+}
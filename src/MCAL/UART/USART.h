@@ -33,7 +33,12 @@
 #define USART_STOP_BIT_2		0X00002000
 #define USART_OVS_8				0X00008000
 #define USART_OVS_16			0X00000000
-#define FCPU					16000000
+/* Oversampling chosen by USART_Init to get the baud rate closest to the requested one */
+#define USART_OVS_AUTO			0XFFFFFFFF
+#define USART_TX_MODE_INTERRUPT	0
+#define USART_TX_MODE_DMA		1
+#define USART_RX_MODE_INTERRUPT	0
+#define USART_RX_MODE_DMA		1
 #define	Done					1
 #define	NOT_Done				0
 /*******************************************************************************
@@ -52,8 +57,21 @@ typedef struct
 	uint32_t 	ParityType;
 	uint32_t 	StopBits;
 	uint32_t 	OverSamplingMode;
+	uint8_t 	TxMode;
+	uint8_t 	RxMode;
 }
 USART_Config_t;
+/**
+ * @brief    : Baud rate reached by a USART.
+ **/
+typedef struct
+{
+	uint32_t 	BRR;				/* Value of the baud rate register */
+	uint32_t 	OverSampling;		/* USART_OVS_16 or USART_OVS_8 */
+	uint32_t 	ActualBaudRate;		/* Baud rate produced by BRR */
+	int32_t 	ErrorPPM;			/* (Actual - Requested) / Requested in parts per million */
+}
+USART_BaudInfo_t;
 /**
  * @brief    : USART user request structure.
  **/
@@ -65,6 +83,23 @@ typedef struct
 	Cb 		Buff_cb	;
 }
 USART_UserReq_t;
+/**
+ * @brief    : Continuous receive callback, called with each run of newly received bytes.
+ **/
+typedef void (*USART_RxRunCb_t)(const uint8_t *Ptr_Data, uint32_t Len);
+/**
+ * @brief    : USART continuous receive request structure.
+ * @note     : Ptr_buffer is used as a circular buffer and stays owned by the driver until
+ *             USART_RxStreamStop is called.
+ **/
+typedef struct
+{
+	uint8_t USART_ID;
+	uint8_t *Ptr_buffer ;
+	uint32_t Buff_Len ;
+	USART_RxRunCb_t Run_cb ;
+}
+USART_RxStreamReq_t;
 /*******************************************************************************
  *                  	    Functions Prototypes                               *
  *******************************************************************************/
@@ -76,6 +111,47 @@ USART_UserReq_t;
  *             and enabling USART communication.
  */ 
 Error_enumStatus_t USART_Init(void);
+/**
+ * @brief    : Calculates the baud rate register value for a baud rate.
+ * @param[in]: Clock        Clock of the USART bus in Hz.
+ * @param[in]: BaudRate     Requested baud rate.
+ * @param[in]: OverSampling USART_OVS_16, USART_OVS_8 or USART_OVS_AUTO.
+ * @param[out]: Ptr_Info    Chosen BRR and oversampling, the baud rate they produce and its error.
+ * @return   : Error_enumStatus_t Status_enumWrongInput if the error exceeds USART_BAUD_MAX_ERROR_PPM.
+ * @details  : Both modes divide the clock by an integer number of clock periods per bit, so they
+ *             reach the same rates where both apply. USART_OVS_AUTO keeps OVER16, which samples
+ *             each bit more often, unless OVER8 gets strictly closer to the requested rate, which
+ *             is the case above Clock / 16. Ptr_Info is filled even when the rate is rejected.
+ **/
+Error_enumStatus_t USART_CalcBaudRate(uint32_t Clock, uint32_t BaudRate, uint32_t OverSampling, USART_BaudInfo_t *Ptr_Info);
+/**
+ * @brief    : Gets the baud rate programmed in a USART.
+ * @param[in]: USART_ID   USART ID.
+ * @param[out]: Ptr_Info  BRR, oversampling, baud rate and error chosen by USART_Init.
+ * @return   : Error_enumStatus_t Error status indicating the success or failure of the operation.
+ **/
+Error_enumStatus_t USART_GetBaudInfo(uint8_t USART_ID, USART_BaudInfo_t *Ptr_Info);
+/**
+ * @brief    : Calculates the baud rate register value a USART would use for a baud rate.
+ * @param[in]: USART_ID   USART ID.
+ * @param[in]: BaudRate   Requested baud rate.
+ * @param[out]: Ptr_Info  BRR, oversampling, baud rate and error USART_SetBaudRate would program.
+ * @return   : Error_enumStatus_t Status_enumWrongInput if the error exceeds USART_BAUD_MAX_ERROR_PPM.
+ * @details  : Uses the current clock of the bus the USART is on and its configured oversampling mode.
+ *             Nothing is written to the USART.
+ **/
+Error_enumStatus_t USART_CheckBaudRate(uint8_t USART_ID, uint32_t BaudRate, USART_BaudInfo_t *Ptr_Info);
+/**
+ * @brief    : Changes the baud rate of an initialized USART.
+ * @param[in]: USART_ID USART ID.
+ * @param[in]: BaudRate New baud rate.
+ * @return   : Error_enumStatus_t Status_enumBusyState while a transmission is in progress or the last
+ *             frame is still in the shift register (TC clear), Status_enumWrongInput if the rate can't
+ *             be reached, in both cases the USART keeps its current rate.
+ * @details  : The USART is disabled while BRR and OVER8 change, a frame being received at that
+ *             moment is lost. The new rate is reported by USART_GetBaudInfo.
+ **/
+Error_enumStatus_t USART_SetBaudRate(uint8_t USART_ID, uint32_t BaudRate);
 /**
  * @brief    : Transmits a single byte over USART.
  * @param[in]: Ptr_UserReq Pointer to USART user request structure containing transmit parameters.
@@ -106,6 +182,8 @@ Error_enumStatus_t USART_GetByte(USART_UserReq_t* Ptr_UserReq);
  *             copies the transmit buffer parameters from the user request structure,
  *             enables USART transmit, loads the first byte of data into the USART data register,
  *             and enables USART transmit data register empty interrupt.
+ *             If the USART is configured in USART_TX_MODE_DMA the whole buffer is handed to the
+ *             USART DMA stream instead and the callback is called from the transfer complete interrupt.
  **/
 Error_enumStatus_t USART_TxBufferAsyncZeroCopy(USART_UserReq_t* Ptr_UserReq );
 /**
@@ -119,6 +197,27 @@ Error_enumStatus_t USART_TxBufferAsyncZeroCopy(USART_UserReq_t* Ptr_UserReq );
  *             enables USART receive, and enables USART receive data register not empty interrupt.
  **/
 Error_enumStatus_t USART_RxBufferAsyncZeroCopy(USART_UserReq_t* Ptr_UserReq );
+/**
+ * @brief    : Starts continuous reception into a circular buffer.
+ * @param[in]: Ptr_StreamReq Pointer to USART continuous receive request structure.
+ * @return   : Error_enumStatus_t Error status indicating the success or failure of the operation.
+ * @details  : This function keeps the receiver running until USART_RxStreamStop is called.
+ *             Received bytes are handed to the run callback in order, without gaps, whenever
+ *             the line goes idle and whenever half or all of the buffer has been filled.
+ *             If the USART is configured in USART_RX_MODE_DMA the bytes are moved by the USART
+ *             Rx DMA stream in circular mode, otherwise by the RXNE interrupt.
+ *             The run callback is called from interrupt context and a run never spans the
+ *             end of the buffer, so a wrap around is reported as two runs.
+ **/
+Error_enumStatus_t USART_RxStreamStart(USART_RxStreamReq_t* Ptr_StreamReq);
+/**
+ * @brief    : Stops continuous reception.
+ * @param[in]: USART_ID   USART ID.
+ * @return   : Error_enumStatus_t Error status indicating the success or failure of the operation.
+ * @details  : Bytes received before the call are handed to the run callback before the
+ *             buffer is released.
+ **/
+Error_enumStatus_t USART_RxStreamStop(uint8_t USART_ID);
 /**
  * @brief    : Checks if USART transmission is completed.
  * @param[in]: USART_ID   USART ID.
@@ -26,7 +26,15 @@ const  USART_Config_t USARTS[_USART_Num] =
     .ParityEn=USART_PARITY_DISABLE,
     .ParityType=0,
     .StopBits=USART_STOP_BIT_1,
-    .OverSamplingMode=USART_OVS_16},
+    .OverSamplingMode=USART_OVS_AUTO,
+#ifdef NATIVE_SIM
+    /* The firmware simulator models the USART registers but no DMA controller */
+    .TxMode=USART_TX_MODE_INTERRUPT,
+    .RxMode=USART_RX_MODE_INTERRUPT},
+#else
+    .TxMode=USART_TX_MODE_DMA,
+    .RxMode=USART_RX_MODE_DMA},
+#endif
   [UASART_2]={
     .USART_ID=USART2_ID,
     .BaudRate=9600,
@@ -34,5 +42,7 @@ const  USART_Config_t USARTS[_USART_Num] =
     .ParityEn=USART_PARITY_DISABLE,
     .ParityType=0,
     .StopBits=USART_STOP_BIT_1,
-    .OverSamplingMode=USART_OVS_16},   
+    .OverSamplingMode=USART_OVS_AUTO,
+    .TxMode=USART_TX_MODE_INTERRUPT,
+    .RxMode=USART_RX_MODE_INTERRUPT},
 };
@@ -8,6 +8,12 @@
  */
 #ifndef USART_CFG_H_
 #define USART_CFG_H_
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+/* Largest baud rate error accepted by USART_Init in parts per million, the receiver on
+ * the other side tolerates about 3.75 % (OVER16) or 3.3 % (OVER8) for both ends together */
+#define USART_BAUD_MAX_ERROR_PPM	15000
 /*******************************************************************************
  *                        	  Types Declaration                                 *
  *******************************************************************************/
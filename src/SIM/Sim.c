@@ -0,0 +1,960 @@
+/*
+ ============================================================================
+ Name        : Sim.c
+ Author      : Omar Medhat Mohamed
+ Description : Source File for the host-native firmware simulator
+ Date        : 1/6/2024
+ ============================================================================
+ */
+/*******************************************************************************
+ *                                Includes	                                  *
+ *******************************************************************************/
+#define _GNU_SOURCE
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include "SIM/Sim.h"
+#include "LIB/RingBuffer.h"
+#include "LIB/Crc32.h"
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+#define SIM_REG(Address)			(*(volatile uint32_t *)PERIPHERAL_ADDRESS(Address))
+#define SIM_CORE_REG(Address)		(*(volatile uint32_t *)CORE_PERIPHERAL_ADDRESS(Address))
+
+#define SIM_NS_PER_SECOND			1000000000ULL
+
+/* RCC */
+#define SIM_RCC_CR					0x40023800UL
+#define SIM_RCC_PLLCFGR				0x40023804UL
+#define SIM_RCC_CFGR				0x40023808UL
+#define SIM_RCC_CR_HSION			0x00000001UL
+#define SIM_RCC_CR_HSIRDY			0x00000002UL
+#define SIM_RCC_CR_HSEON			0x00010000UL
+#define SIM_RCC_CR_HSERDY			0x00020000UL
+#define SIM_RCC_CR_PLLON			0x01000000UL
+#define SIM_RCC_CR_PLLRDY			0x02000000UL
+#define SIM_RCC_CR_RESET			0x00000083UL
+#define SIM_RCC_CFGR_SW_MASK		0x00000003UL
+#define SIM_RCC_CFGR_SWS_SHIFT		2
+#define SIM_RCC_CFGR_HPRE_SHIFT		4
+#define SIM_RCC_CFGR_PPRE2_SHIFT	13
+#define SIM_RCC_PLLCFGR_SRC_HSE		0x00400000UL
+#define SIM_SYSCLK_HSE				1
+#define SIM_SYSCLK_PLL				2
+
+/* USART1 */
+#define SIM_USART1_BASE				0x40011000UL
+#define SIM_USART_SR				0x00UL
+#define SIM_USART_DR				0x04UL
+#define SIM_USART_BRR				0x08UL
+#define SIM_USART_CR1				0x0CUL
+#define SIM_USART_CR2				0x10UL
+#define SIM_USART_SR_ORE			0x00000008UL
+#define SIM_USART_SR_IDLE			0x00000010UL
+#define SIM_USART_SR_RXNE			0x00000020UL
+#define SIM_USART_SR_TC				0x00000040UL
+#define SIM_USART_SR_TXE			0x00000080UL
+#define SIM_USART_CR1_RE			0x00000004UL
+#define SIM_USART_CR1_TE			0x00000008UL
+#define SIM_USART_CR1_IDLEIE		0x00000010UL
+#define SIM_USART_CR1_RXNEIE		0x00000020UL
+#define SIM_USART_CR1_TCIE			0x00000040UL
+#define SIM_USART_CR1_TXEIE			0x00000080UL
+#define SIM_USART_CR1_M				0x00001000UL
+#define SIM_USART_CR1_UE			0x00002000UL
+#define SIM_USART_CR1_OVER8			0x00008000UL
+#define SIM_USART_CR2_STOP_SHIFT	12
+#define SIM_USART_CR2_STOP_MASK		0x3UL
+
+/* CRC unit */
+#define SIM_CRC_DR					0x40023000UL
+#define SIM_CRC_CR					0x40023008UL
+#define SIM_CRC_CR_RESET			0x00000001UL
+
+/* GPIO, ports A to H are 0x400 apart */
+#define SIM_GPIO_BASE				0x40020000UL
+#define SIM_GPIO_STRIDE				0x400UL
+#define SIM_GPIO_PORTS				8
+#define SIM_GPIO_MODER				0x00UL
+#define SIM_GPIO_PUPDR				0x0CUL
+#define SIM_GPIO_IDR				0x10UL
+#define SIM_GPIO_ODR				0x14UL
+#define SIM_GPIO_BSRR				0x18UL
+#define SIM_GPIO_MODE_INPUT			0x0UL
+#define SIM_GPIO_MODE_OUTPUT		0x1UL
+#define SIM_GPIO_PULL_UP			0x1UL
+#define SIM_GPIO_PINS				16
+
+/* Core peripherals */
+#define SIM_SYSTICK_CTRL			0xE000E010UL
+#define SIM_SYSTICK_LOAD			0xE000E014UL
+#define SIM_SYSTICK_VAL				0xE000E018UL
+#define SIM_SYSTICK_CTRL_ENABLE		0x00000001UL
+#define SIM_SYSTICK_CTRL_CLKSOURCE	0x00000004UL
+#define SIM_SYSTICK_LOAD_MASK		0x00FFFFFFUL
+#define SIM_NVIC_ISER				0xE000E100UL
+#define SIM_NVIC_ICER				0xE000E180UL
+#define SIM_NVIC_ISPR				0xE000E200UL
+#define SIM_NVIC_ICPR				0xE000E280UL
+/* ISER, ICER, ISPR and ICPR are 0x80 apart, 8 words used in each */
+#define SIM_NVIC_BANK_STRIDE		0x80UL
+#define SIM_NVIC_BANK_SIZE			0x20UL
+#define SIM_NVIC_STIR				0xE000EF00UL
+#define SIM_NVIC_STIR_MASK			0x000001FFUL
+#define SIM_DWT_CTRL				0xE0001000UL
+#define SIM_DWT_CYCCNT				0xE0001004UL
+#define SIM_DWT_CTRL_CYCCNTENA		0x00000001UL
+
+/* A level triggered interrupt whose flag is never cleared must not hang the simulated core */
+#define SIM_IRQ_RETRIGGER_MAX		32
+/* The simulated core is busy polling, it runs below the wire thread and the host tools */
+#define SIM_CORE_NICE				10
+/*******************************************************************************
+ *                        	  Types Declaration                                 *
+ *******************************************************************************/
+/* Events posted by the wire thread, applied to the registers by the core thread */
+typedef enum
+{
+	SIM_EVENT_TX_SHIFT,
+	SIM_EVENT_TX_DONE,
+	SIM_EVENT_RX_BYTE,
+	SIM_EVENT_RX_IDLE,
+	SIM_EVENT_TICK
+}
+Sim_EventType_t;
+
+typedef struct
+{
+	IRQn_t IRQn;
+	void (*Handler)(void);
+}
+Sim_Vector_t;
+/*******************************************************************************
+ *                              Variables		                                *
+ *******************************************************************************/
+/* Register blocks behind PERIPHERAL_ADDRESS and CORE_PERIPHERAL_ADDRESS */
+uint32_t Sim_PeripheralMemory[PERIPHERAL_REGION_SIZE / 4];
+uint32_t Sim_CorePeripheralMemory[CORE_PERIPHERAL_REGION_SIZE / 4];
+
+void USART1_IRQHandler(void) __attribute__((weak));
+void SPI4_IRQHandler(void) __attribute__((weak));
+/* Interrupts that can be raised through STIR */
+static const Sim_Vector_t Sim_SoftwareVectors[] =
+{
+	{USART1_IRQ, USART1_IRQHandler},
+	{SPI4_IRQ, SPI4_IRQHandler},
+};
+
+/* Thread running the firmware and thread timing the serial line */
+static pthread_t Sim_CoreThread;
+static pthread_t Sim_WireThread;
+static int Sim_PtyMaster = -1;
+static int Sim_PtySlave = -1;
+static int Sim_WakeFd = -1;
+static const char *Sim_LinkPath;
+
+/* Bytes written to DR by the core, shifted out by the wire thread */
+static RingBuffer_t Sim_TxQueue;
+static uint8_t Sim_TxQueueBuffer[SIM_TX_QUEUE_SIZE];
+/* Two byte records {Sim_EventType_t, data} from the wire thread to the core */
+static RingBuffer_t Sim_Events;
+static uint8_t Sim_EventsBuffer[SIM_EVENT_QUEUE_SIZE];
+static uint32_t Sim_EventDrops;
+
+/* USART1 state owned by the core thread */
+static uint32_t Sim_TxHolding;
+static uint32_t Sim_TxPending;
+static uint32_t Sim_RxFull;
+static uint8_t Sim_RxData;
+
+static uint64_t Sim_SysTickStart;
+/* Host time of the last CYCCNT write, the counter runs at the AHB clock from there */
+static uint64_t Sim_CycleStart;
+static volatile sig_atomic_t Sim_HandlerDepth;
+static volatile sig_atomic_t Sim_SoftwareActive;
+static int Sim_TraceGpio;
+/*******************************************************************************
+ *                         Static Function Prototypes		                   *
+ *******************************************************************************/
+static uint64_t Sim_Now(void);
+static void Sim_Lock(sigset_t *Ptr_Saved);
+static void Sim_Unlock(const sigset_t *Ptr_Saved);
+static uint32_t Sim_AddressOf(volatile uint32_t *Ptr_Register);
+static uint64_t Sim_USART1FrameTime(void);
+static void Sim_USART1UpdateFlags(void);
+static void Sim_USART1Write(uint8_t Data);
+static uint8_t Sim_USART1Read(void);
+static uint32_t Sim_IRQEnabled(IRQn_t IRQn);
+static void Sim_RunInterrupts(void);
+static void Sim_RaiseSoftware(uint32_t IRQn);
+static void Sim_RunSoftwareInterrupts(void);
+static void Sim_ApplyEvent(uint8_t Type, uint8_t Data);
+static void Sim_CoreSignal(int Signal);
+static void Sim_RccUpdate(void);
+static uint32_t Sim_SysTickValue(void);
+static uint32_t Sim_CycleCount(void);
+static uint32_t Sim_GpioInput(uint32_t Port);
+static void Sim_GpioSetReset(uint32_t Port, uint32_t Value);
+static void Sim_PostEvent(uint8_t Type, uint8_t Data);
+static void *Sim_WireMain(void *Ptr_Arg);
+static void Sim_OpenPty(void);
+static void Sim_RemoveLink(void);
+static void Sim_Terminate(int Signal);
+/*******************************************************************************
+ *                             Implementation   				                *
+ *******************************************************************************/
+static uint64_t Sim_Now(void)
+{
+	struct timespec Loc_Time;
+
+	clock_gettime(CLOCK_MONOTONIC, &Loc_Time);
+	return ((uint64_t)Loc_Time.tv_sec * SIM_NS_PER_SECOND) + (uint64_t)Loc_Time.tv_nsec;
+}
+
+/* Register side effects run with the interrupt signal masked, like a single bus access */
+static void Sim_Lock(sigset_t *Ptr_Saved)
+{
+	sigset_t Loc_Set;
+
+	sigemptyset(&Loc_Set);
+	sigaddset(&Loc_Set, SIGUSR1);
+	pthread_sigmask(SIG_BLOCK, &Loc_Set, Ptr_Saved);
+}
+
+static void Sim_Unlock(const sigset_t *Ptr_Saved)
+{
+	pthread_sigmask(SIG_SETMASK, Ptr_Saved, NULL);
+}
+
+static uint32_t Sim_AddressOf(volatile uint32_t *Ptr_Register)
+{
+	uintptr_t Loc_Ptr = (uintptr_t)Ptr_Register;
+	uintptr_t Loc_Peripheral = (uintptr_t)Sim_PeripheralMemory;
+	uintptr_t Loc_Core = (uintptr_t)Sim_CorePeripheralMemory;
+	uint32_t Loc_Address = 0;
+
+	if ((Loc_Ptr >= Loc_Peripheral) && (Loc_Ptr < (Loc_Peripheral + sizeof(Sim_PeripheralMemory))))
+	{
+		Loc_Address = PERIPHERAL_BASE_ADDRESS + (uint32_t)(Loc_Ptr - Loc_Peripheral);
+	}
+	else if ((Loc_Ptr >= Loc_Core) && (Loc_Ptr < (Loc_Core + sizeof(Sim_CorePeripheralMemory))))
+	{
+		Loc_Address = CORE_PERIPHERAL_BASE_ADDRESS + (uint32_t)(Loc_Ptr - Loc_Core);
+	}
+	return Loc_Address;
+}
+
+uint32_t Sim_GetAHBClock(void)
+{
+	static const uint8_t Loc_HPREShift[8] = {1, 2, 3, 4, 6, 7, 8, 9};
+	uint32_t Loc_CFGR = SIM_REG(SIM_RCC_CFGR);
+	uint32_t Loc_HPRE = (Loc_CFGR >> SIM_RCC_CFGR_HPRE_SHIFT) & 0xF;
+	uint32_t Loc_Clock = SIM_HSI_CLOCK;
+
+	if ((Loc_CFGR & SIM_RCC_CFGR_SW_MASK) == SIM_SYSCLK_HSE)
+	{
+		Loc_Clock = SIM_HSE_CLOCK;
+	}
+	else if ((Loc_CFGR & SIM_RCC_CFGR_SW_MASK) == SIM_SYSCLK_PLL)
+	{
+		uint32_t Loc_PLL = SIM_REG(SIM_RCC_PLLCFGR);
+		uint32_t Loc_M = Loc_PLL & 0x3F;
+		uint32_t Loc_N = (Loc_PLL >> 6) & 0x1FF;
+		uint32_t Loc_P = (((Loc_PLL >> 16) & 0x3) + 1) * 2;
+		uint32_t Loc_Input = (Loc_PLL & SIM_RCC_PLLCFGR_SRC_HSE) ? SIM_HSE_CLOCK : SIM_HSI_CLOCK;
+
+		if ((Loc_M != 0) && (Loc_N != 0))
+		{
+			Loc_Clock = (uint32_t)(((uint64_t)Loc_Input * Loc_N) / (Loc_M * Loc_P));
+		}
+	}
+	/* HPRE 0xxx is /1, 1000..1111 is /2 to /512 without /32 */
+	if (Loc_HPRE & 0x8)
+	{
+		Loc_Clock >>= Loc_HPREShift[Loc_HPRE & 0x7];
+	}
+	return Loc_Clock;
+}
+
+uint32_t Sim_GetAPB2Clock(void)
+{
+	uint32_t Loc_PPRE2 = (SIM_REG(SIM_RCC_CFGR) >> SIM_RCC_CFGR_PPRE2_SHIFT) & 0x7;
+	uint32_t Loc_Clock = Sim_GetAHBClock();
+
+	/* PPRE 0xx is /1, 100..111 is /2 to /16 */
+	if (Loc_PPRE2 & 0x4)
+	{
+		Loc_Clock >>= (Loc_PPRE2 & 0x3) + 1;
+	}
+	return Loc_Clock;
+}
+
+/* Time one character takes on the wire: start bit, 8 or 9 data bits and the stop bits */
+static uint64_t Sim_USART1FrameTime(void)
+{
+	/* Stop bits in half bits for STOP = 1, 0.5, 2 and 1.5 */
+	static const uint8_t Loc_StopHalfBits[4] = {2, 1, 4, 3};
+	uint32_t Loc_CR1 = SIM_REG(SIM_USART1_BASE + SIM_USART_CR1);
+	uint32_t Loc_CR2 = SIM_REG(SIM_USART1_BASE + SIM_USART_CR2);
+	uint32_t Loc_BRR = SIM_REG(SIM_USART1_BASE + SIM_USART_BRR) & 0xFFFF;
+	uint64_t Loc_ClocksPerBit;
+	uint64_t Loc_HalfBits;
+
+	/* BRR holds USARTDIV * 16 with OVER8 = 0, with OVER8 = 1 the fraction has 3 bits */
+	Loc_ClocksPerBit = (Loc_CR1 & SIM_USART_CR1_OVER8) ? (((Loc_BRR >> 4) * 8) + (Loc_BRR & 0x7)) : Loc_BRR;
+	if (Loc_ClocksPerBit == 0)
+	{
+		Loc_ClocksPerBit = 1;
+	}
+	Loc_HalfBits = (2 * (1 + ((Loc_CR1 & SIM_USART_CR1_M) ? 9 : 8))) +
+				   Loc_StopHalfBits[(Loc_CR2 >> SIM_USART_CR2_STOP_SHIFT) & SIM_USART_CR2_STOP_MASK];
+
+	return (Loc_HalfBits * Loc_ClocksPerBit * SIM_NS_PER_SECOND) / (2ULL * Sim_GetAPB2Clock());
+}
+
+/* TXE and RXNE follow the data registers, TC, IDLE and ORE are set by events and cleared by software */
+static void Sim_USART1UpdateFlags(void)
+{
+	uint32_t Loc_SR = SIM_REG(SIM_USART1_BASE + SIM_USART_SR) & ~(SIM_USART_SR_TXE | SIM_USART_SR_RXNE);
+
+	if (Sim_TxHolding == 0)
+	{
+		Loc_SR |= SIM_USART_SR_TXE;
+	}
+	if (Sim_RxFull)
+	{
+		Loc_SR |= SIM_USART_SR_RXNE;
+	}
+	SIM_REG(SIM_USART1_BASE + SIM_USART_SR) = Loc_SR;
+}
+
+static void Sim_USART1Write(uint8_t Data)
+{
+	uint32_t Loc_CR1 = SIM_REG(SIM_USART1_BASE + SIM_USART_CR1);
+	uint64_t Loc_Wake = 1;
+
+	if (((Loc_CR1 & (SIM_USART_CR1_UE | SIM_USART_CR1_TE)) == (SIM_USART_CR1_UE | SIM_USART_CR1_TE)) &&
+		(RingBuffer_Write(&Sim_TxQueue, &Data, 1) == Status_enumOk))
+	{
+		Sim_TxHolding++;
+		Sim_TxPending++;
+		SIM_REG(SIM_USART1_BASE + SIM_USART_SR) &= ~SIM_USART_SR_TC;
+		Sim_USART1UpdateFlags();
+		(void)write(Sim_WakeFd, &Loc_Wake, sizeof(Loc_Wake));
+	}
+}
+
+/* Reading DR after SR takes the received byte and clears IDLE and ORE */
+static uint8_t Sim_USART1Read(void)
+{
+	Sim_RxFull = 0;
+	SIM_REG(SIM_USART1_BASE + SIM_USART_SR) &= ~(SIM_USART_SR_IDLE | SIM_USART_SR_ORE);
+	Sim_USART1UpdateFlags();
+	return Sim_RxData;
+}
+
+static uint32_t Sim_IRQEnabled(IRQn_t IRQn)
+{
+	return (SIM_CORE_REG(SIM_NVIC_ISER + (4 * (IRQn / 32))) >> (IRQn % 32)) & 1;
+}
+
+/* Calls the USART1 handler for as long as an enabled flag is set, as the NVIC does for a level */
+static void Sim_RunInterrupts(void)
+{
+	uint32_t Loc_Count;
+
+	for (Loc_Count = 0; (Loc_Count < SIM_IRQ_RETRIGGER_MAX) && (USART1_IRQHandler != NULL); Loc_Count++)
+	{
+		uint32_t Loc_SR = SIM_REG(SIM_USART1_BASE + SIM_USART_SR);
+		uint32_t Loc_CR1 = SIM_REG(SIM_USART1_BASE + SIM_USART_CR1);
+		uint32_t Loc_Pending = ((Loc_CR1 & SIM_USART_CR1_TXEIE) && (Loc_SR & SIM_USART_SR_TXE)) ||
+							   ((Loc_CR1 & SIM_USART_CR1_TCIE) && (Loc_SR & SIM_USART_SR_TC)) ||
+							   ((Loc_CR1 & SIM_USART_CR1_RXNEIE) && (Loc_SR & (SIM_USART_SR_RXNE | SIM_USART_SR_ORE))) ||
+							   ((Loc_CR1 & SIM_USART_CR1_IDLEIE) && (Loc_SR & SIM_USART_SR_IDLE));
+
+		if (!(Loc_CR1 & SIM_USART_CR1_UE) || !Loc_Pending || !Sim_IRQEnabled(USART1_IRQ))
+		{
+			break;
+		}
+		USART1_IRQHandler();
+	}
+}
+
+static void Sim_RaiseSoftware(uint32_t IRQn)
+{
+	if (IRQn < _INT_Num)
+	{
+		SIM_CORE_REG(SIM_NVIC_ISPR + (4 * (IRQn / 32))) |= 1UL << (IRQn % 32);
+	}
+}
+
+/* Pending software interrupts run below the USART interrupt, which may preempt them */
+static void Sim_RunSoftwareInterrupts(void)
+{
+	sigset_t Loc_Saved;
+	sigset_t Loc_Set;
+	uint32_t Loc_Ran;
+	uint32_t Loc_idx;
+
+	if (!Sim_SoftwareActive)
+	{
+		Sim_SoftwareActive = 1;
+		sigemptyset(&Loc_Set);
+		sigaddset(&Loc_Set, SIGUSR1);
+		pthread_sigmask(SIG_UNBLOCK, &Loc_Set, NULL);
+		do
+		{
+			Loc_Ran = 0;
+			for (Loc_idx = 0; Loc_idx < (sizeof(Sim_SoftwareVectors) / sizeof(Sim_SoftwareVectors[0])); Loc_idx++)
+			{
+				IRQn_t Loc_IRQn = Sim_SoftwareVectors[Loc_idx].IRQn;
+				uint32_t Loc_Bit = 1UL << (Loc_IRQn % 32);
+				volatile uint32_t *Loc_ISPR = &SIM_CORE_REG(SIM_NVIC_ISPR + (4 * (Loc_IRQn / 32)));
+				uint32_t Loc_Pending;
+
+				Sim_Lock(&Loc_Saved);
+				Loc_Pending = (*Loc_ISPR & Loc_Bit) && Sim_IRQEnabled(Loc_IRQn);
+				if (Loc_Pending)
+				{
+					*Loc_ISPR &= ~Loc_Bit;
+				}
+				Sim_Unlock(&Loc_Saved);
+				if (Loc_Pending && (Sim_SoftwareVectors[Loc_idx].Handler != NULL))
+				{
+					Sim_SoftwareVectors[Loc_idx].Handler();
+					Loc_Ran = 1;
+				}
+			}
+		} while (Loc_Ran);
+		Sim_SoftwareActive = 0;
+	}
+}
+
+static void Sim_ApplyEvent(uint8_t Type, uint8_t Data)
+{
+	switch (Type)
+	{
+	case SIM_EVENT_TX_SHIFT:
+		/* DR moved to the shift register */
+		if (Sim_TxHolding)
+		{
+			Sim_TxHolding--;
+		}
+		break;
+	case SIM_EVENT_TX_DONE:
+		if (Sim_TxPending)
+		{
+			Sim_TxPending--;
+		}
+		if (Sim_TxPending == 0)
+		{
+			SIM_REG(SIM_USART1_BASE + SIM_USART_SR) |= SIM_USART_SR_TC;
+		}
+		break;
+	case SIM_EVENT_RX_BYTE:
+		/* A byte arriving while RXNE is still set is lost */
+		if (Sim_RxFull)
+		{
+			SIM_REG(SIM_USART1_BASE + SIM_USART_SR) |= SIM_USART_SR_ORE;
+		}
+		else
+		{
+			Sim_RxData = Data;
+			Sim_RxFull = 1;
+		}
+		break;
+	case SIM_EVENT_RX_IDLE:
+		SIM_REG(SIM_USART1_BASE + SIM_USART_SR) |= SIM_USART_SR_IDLE;
+		break;
+	case SIM_EVENT_TICK:
+		Sim_RccUpdate();
+		break;
+	default:
+		break;
+	}
+	Sim_USART1UpdateFlags();
+}
+
+/* Interrupt entry of the simulated core, raised by the wire thread */
+static void Sim_CoreSignal(int Signal)
+{
+	uint8_t Loc_Event[2];
+
+	(void)Signal;
+	Sim_HandlerDepth++;
+	/* The handler runs after each event, so back to back bytes are not taken as an overrun */
+	while (RingBuffer_Read(&Sim_Events, Loc_Event, sizeof(Loc_Event)) == sizeof(Loc_Event))
+	{
+		Sim_ApplyEvent(Loc_Event[0], Loc_Event[1]);
+		Sim_RunInterrupts();
+	}
+	Sim_RunInterrupts();
+	Sim_HandlerDepth--;
+	if (Sim_HandlerDepth == 0)
+	{
+		Sim_RunSoftwareInterrupts();
+	}
+}
+
+/* Oscillators and the PLL lock as soon as they are switched on, a clock switch is immediate */
+static void Sim_RccUpdate(void)
+{
+	uint32_t Loc_CR = SIM_REG(SIM_RCC_CR);
+	uint32_t Loc_CFGR = SIM_REG(SIM_RCC_CFGR);
+
+	Loc_CR &= ~(SIM_RCC_CR_HSIRDY | SIM_RCC_CR_HSERDY | SIM_RCC_CR_PLLRDY);
+	Loc_CR |= (Loc_CR & (SIM_RCC_CR_HSION | SIM_RCC_CR_HSEON | SIM_RCC_CR_PLLON)) << 1;
+	SIM_REG(SIM_RCC_CR) = Loc_CR;
+	SIM_REG(SIM_RCC_CFGR) = (Loc_CFGR & ~(SIM_RCC_CFGR_SW_MASK << SIM_RCC_CFGR_SWS_SHIFT)) |
+							((Loc_CFGR & SIM_RCC_CFGR_SW_MASK) << SIM_RCC_CFGR_SWS_SHIFT);
+}
+
+static uint32_t Sim_SysTickValue(void)
+{
+	uint32_t Loc_CTRL = SIM_CORE_REG(SIM_SYSTICK_CTRL);
+	uint32_t Loc_LOAD = SIM_CORE_REG(SIM_SYSTICK_LOAD) & SIM_SYSTICK_LOAD_MASK;
+	uint32_t Loc_Value = SIM_CORE_REG(SIM_SYSTICK_VAL);
+
+	if ((Loc_CTRL & SIM_SYSTICK_CTRL_ENABLE) && (Loc_LOAD != 0))
+	{
+		uint64_t Loc_Clock = (Loc_CTRL & SIM_SYSTICK_CTRL_CLKSOURCE) ? Sim_GetAHBClock() : (Sim_GetAHBClock() / 8);
+		uint64_t Loc_Elapsed = Sim_Now() - Sim_SysTickStart;
+		uint64_t Loc_Ticks = ((Loc_Elapsed / SIM_NS_PER_SECOND) * Loc_Clock) +
+							 (((Loc_Elapsed % SIM_NS_PER_SECOND) * Loc_Clock) / SIM_NS_PER_SECOND);
+
+		/* Counts down from LOAD to 0 and reloads */
+		Loc_Value = Loc_LOAD - (uint32_t)(Loc_Ticks % ((uint64_t)Loc_LOAD + 1));
+	}
+	return Loc_Value;
+}
+
+/* Cycles counted by the simulator are host time scaled to the core clock */
+static uint32_t Sim_CycleCount(void)
+{
+	uint32_t Loc_Value = SIM_CORE_REG(SIM_DWT_CYCCNT);
+
+	if (SIM_CORE_REG(SIM_DWT_CTRL) & SIM_DWT_CTRL_CYCCNTENA)
+	{
+		uint64_t Loc_Clock = Sim_GetAHBClock();
+		uint64_t Loc_Elapsed = Sim_Now() - Sim_CycleStart;
+
+		Loc_Value += (uint32_t)(((Loc_Elapsed / SIM_NS_PER_SECOND) * Loc_Clock) +
+								(((Loc_Elapsed % SIM_NS_PER_SECOND) * Loc_Clock) / SIM_NS_PER_SECOND));
+	}
+	return Loc_Value;
+}
+
+/* Output pins read back ODR, inputs read their pull, floating inputs read low */
+static uint32_t Sim_GpioInput(uint32_t Port)
+{
+	uint32_t Loc_Base = SIM_GPIO_BASE + (Port * SIM_GPIO_STRIDE);
+	uint32_t Loc_MODER = SIM_REG(Loc_Base + SIM_GPIO_MODER);
+	uint32_t Loc_PUPDR = SIM_REG(Loc_Base + SIM_GPIO_PUPDR);
+	uint32_t Loc_ODR = SIM_REG(Loc_Base + SIM_GPIO_ODR);
+	uint32_t Loc_IDR = 0;
+	uint32_t Loc_Pin;
+
+	for (Loc_Pin = 0; Loc_Pin < SIM_GPIO_PINS; Loc_Pin++)
+	{
+		uint32_t Loc_Mode = (Loc_MODER >> (Loc_Pin * 2)) & 0x3;
+		uint32_t Loc_Pull = (Loc_PUPDR >> (Loc_Pin * 2)) & 0x3;
+
+		if (Loc_Mode == SIM_GPIO_MODE_OUTPUT)
+		{
+			Loc_IDR |= Loc_ODR & (1UL << Loc_Pin);
+		}
+		else if ((Loc_Mode == SIM_GPIO_MODE_INPUT) && (Loc_Pull == SIM_GPIO_PULL_UP))
+		{
+			Loc_IDR |= 1UL << Loc_Pin;
+		}
+	}
+	SIM_REG(Loc_Base + SIM_GPIO_IDR) = Loc_IDR;
+	return Loc_IDR;
+}
+
+static void Sim_GpioSetReset(uint32_t Port, uint32_t Value)
+{
+	uint32_t Loc_Base = SIM_GPIO_BASE + (Port * SIM_GPIO_STRIDE);
+	uint32_t Loc_Old = SIM_REG(Loc_Base + SIM_GPIO_ODR);
+	/* Set wins over reset for a pin present in both halves */
+	uint32_t Loc_New = ((Loc_Old & ~(Value >> 16)) | Value) & 0xFFFF;
+
+	SIM_REG(Loc_Base + SIM_GPIO_ODR) = Loc_New;
+	if (Sim_TraceGpio && (Loc_New != Loc_Old))
+	{
+		fprintf(stderr, "sim: GPIO%c ODR 0x%04X\n", 'A' + (int)Port, (unsigned int)Loc_New);
+	}
+}
+
+uint32_t Sim_ReadRegister(volatile uint32_t *Ptr_Register)
+{
+	uint32_t Loc_Address = Sim_AddressOf(Ptr_Register);
+	uint32_t Loc_Value;
+	sigset_t Loc_Saved;
+
+	Sim_Lock(&Loc_Saved);
+	if (Loc_Address == (SIM_USART1_BASE + SIM_USART_DR))
+	{
+		Loc_Value = Sim_USART1Read();
+	}
+	else if (Loc_Address == SIM_SYSTICK_VAL)
+	{
+		Loc_Value = Sim_SysTickValue();
+	}
+	else if (Loc_Address == SIM_DWT_CYCCNT)
+	{
+		Loc_Value = Sim_CycleCount();
+	}
+	else if ((Loc_Address == SIM_RCC_CR) || (Loc_Address == SIM_RCC_CFGR))
+	{
+		/* Ready and switch status bits polled while the clocks are brought up */
+		Sim_RccUpdate();
+		Loc_Value = *Ptr_Register;
+	}
+	else if ((Loc_Address >= SIM_GPIO_BASE) && (Loc_Address < (SIM_GPIO_BASE + (SIM_GPIO_PORTS * SIM_GPIO_STRIDE))) &&
+			 (((Loc_Address - SIM_GPIO_BASE) % SIM_GPIO_STRIDE) == SIM_GPIO_IDR))
+	{
+		Loc_Value = Sim_GpioInput((Loc_Address - SIM_GPIO_BASE) / SIM_GPIO_STRIDE);
+	}
+	else
+	{
+		Loc_Value = *Ptr_Register;
+	}
+	Sim_Unlock(&Loc_Saved);
+	return Loc_Value;
+}
+
+void Sim_WriteRegister(volatile uint32_t *Ptr_Register, uint32_t Value)
+{
+	uint32_t Loc_Address = Sim_AddressOf(Ptr_Register);
+	sigset_t Loc_Saved;
+
+	Sim_Lock(&Loc_Saved);
+	if (Loc_Address == (SIM_USART1_BASE + SIM_USART_DR))
+	{
+		Sim_USART1Write((uint8_t)Value);
+	}
+	else if (Loc_Address == SIM_SYSTICK_VAL)
+	{
+		/* Any write clears the counter */
+		Sim_SysTickStart = Sim_Now();
+		*Ptr_Register = 0;
+	}
+	else if (Loc_Address == SIM_DWT_CYCCNT)
+	{
+		/* Counting restarts from the written value */
+		Sim_CycleStart = Sim_Now();
+		*Ptr_Register = Value;
+	}
+	else if (Loc_Address == SIM_NVIC_STIR)
+	{
+		Sim_RaiseSoftware(Value & SIM_NVIC_STIR_MASK);
+	}
+	else if (Loc_Address == SIM_CRC_DR)
+	{
+		/* The written word goes through the polynomial, most significant byte first */
+		uint8_t Loc_Word[4] = {(uint8_t)(Value >> 24), (uint8_t)(Value >> 16), (uint8_t)(Value >> 8), (uint8_t)Value};
+
+		*Ptr_Register = Crc32_Bitwise(*Ptr_Register, Loc_Word, sizeof(Loc_Word));
+	}
+	else if (Loc_Address == SIM_CRC_CR)
+	{
+		/* RESET reloads the data register and reads back as 0 */
+		if (Value & SIM_CRC_CR_RESET)
+		{
+			SIM_REG(SIM_CRC_DR) = CRC32_INITIAL;
+		}
+		*Ptr_Register = Value & ~SIM_CRC_CR_RESET;
+	}
+	else if ((Loc_Address >= SIM_NVIC_ISER) && (Loc_Address < (SIM_NVIC_ICPR + SIM_NVIC_BANK_SIZE)) &&
+			 (((Loc_Address - SIM_NVIC_ISER) % SIM_NVIC_BANK_STRIDE) < SIM_NVIC_BANK_SIZE))
+	{
+		/* Set and clear registers of the enable and pending bits, writing 0 has no effect */
+		uint32_t Loc_Bank = (Loc_Address - SIM_NVIC_ISER) / SIM_NVIC_BANK_STRIDE;
+		uint32_t Loc_Word = (Loc_Address - SIM_NVIC_ISER) % SIM_NVIC_BANK_STRIDE;
+		volatile uint32_t *Loc_Register = &SIM_CORE_REG(SIM_NVIC_ISER + ((Loc_Bank & 0x2) * SIM_NVIC_BANK_STRIDE) + Loc_Word);
+
+		if ((Loc_Bank & 0x1) == 0)
+		{
+			*Loc_Register |= Value;
+		}
+		else
+		{
+			*Loc_Register &= ~Value;
+		}
+	}
+	else if ((Loc_Address >= SIM_GPIO_BASE) && (Loc_Address < (SIM_GPIO_BASE + (SIM_GPIO_PORTS * SIM_GPIO_STRIDE))) &&
+			 (((Loc_Address - SIM_GPIO_BASE) % SIM_GPIO_STRIDE) == SIM_GPIO_BSRR))
+	{
+		Sim_GpioSetReset((Loc_Address - SIM_GPIO_BASE) / SIM_GPIO_STRIDE, Value);
+	}
+	else
+	{
+		*Ptr_Register = Value;
+	}
+	Sim_Unlock(&Loc_Saved);
+	/* Outside interrupt context a pending interrupt is taken as soon as it is raised or enabled */
+	if (((Loc_Address == SIM_NVIC_STIR) || ((Loc_Address >= SIM_NVIC_ISER) && (Loc_Address < SIM_NVIC_ICPR))) &&
+		(Sim_HandlerDepth == 0))
+	{
+		Sim_RunSoftwareInterrupts();
+	}
+}
+
+static void Sim_PostEvent(uint8_t Type, uint8_t Data)
+{
+	uint8_t Loc_Event[2] = {Type, Data};
+
+	if (RingBuffer_Write(&Sim_Events, Loc_Event, sizeof(Loc_Event)) != Status_enumOk)
+	{
+		Sim_EventDrops++;
+	}
+}
+
+/**
+ * @brief    : Wire thread, times the USART1 line at the programmed baud rate.
+ * @details  : - A byte written to DR moves to the shift register at once if it is free (TXE event)
+ *               and reaches the pty one character time later (TX_DONE event).
+ *             - Bytes from the pty are paced one character time apart (RX_BYTE events), the line
+ *               is reported idle one character time after the last stop bit (RX_IDLE event).
+ *             - A periodic TICK event lets the core re-evaluate its level triggered interrupts.
+ **/
+static void *Sim_WireMain(void *Ptr_Arg)
+{
+	static uint8_t Loc_RxFifo[SIM_RX_FIFO_SIZE];
+	uint32_t Loc_RxHead = 0;
+	uint32_t Loc_RxTail = 0;
+	uint64_t Loc_RxDoneAt = 0;
+	uint64_t Loc_RxIdleAt = 0;
+	uint64_t Loc_RxLineFree = 0;
+	uint32_t Loc_TxBusy = 0;
+	uint8_t Loc_TxByte = 0;
+	uint64_t Loc_TxDoneAt = 0;
+	uint64_t Loc_TickAt = Sim_Now() + SIM_TICK_PERIOD_NS;
+
+	(void)Ptr_Arg;
+	for (;;)
+	{
+		uint64_t Loc_Now = Sim_Now();
+		uint64_t Loc_Frame = Sim_USART1FrameTime();
+		uint32_t Loc_Posted = 0;
+		uint32_t Loc_TxJustDone = 0;
+		uint64_t Loc_Next;
+		struct pollfd Loc_Fds[2];
+		struct timespec Loc_Timeout;
+
+		/* Transmitter */
+		if (Loc_TxBusy && (Loc_Now >= Loc_TxDoneAt))
+		{
+			/* Nobody listening on the pty is an unconnected line, the byte is lost */
+			(void)write(Sim_PtyMaster, &Loc_TxByte, 1);
+			Loc_TxBusy = 0;
+			Loc_TxJustDone = 1;
+			Sim_PostEvent(SIM_EVENT_TX_DONE, 0);
+			Loc_Posted = 1;
+		}
+		if (!Loc_TxBusy && (RingBuffer_Read(&Sim_TxQueue, &Loc_TxByte, 1) == 1))
+		{
+			/* A byte already waiting in DR follows the previous stop bit without a gap */
+			Loc_TxDoneAt = (Loc_TxJustDone ? Loc_TxDoneAt : Loc_Now) + Loc_Frame;
+			Loc_TxBusy = 1;
+			Sim_PostEvent(SIM_EVENT_TX_SHIFT, 0);
+			Loc_Posted = 1;
+		}
+
+		/* Receiver */
+		if (Loc_RxDoneAt && (Loc_Now >= Loc_RxDoneAt))
+		{
+			Sim_PostEvent(SIM_EVENT_RX_BYTE, Loc_RxFifo[Loc_RxTail % SIM_RX_FIFO_SIZE]);
+			Loc_RxTail++;
+			Loc_RxLineFree = Loc_RxDoneAt;
+			Loc_RxDoneAt = (Loc_RxHead != Loc_RxTail) ? (Loc_RxDoneAt + Loc_Frame) : 0;
+			Loc_RxIdleAt = (Loc_RxHead != Loc_RxTail) ? 0 : (Loc_RxLineFree + Loc_Frame);
+			Loc_Posted = 1;
+		}
+		if (Loc_RxIdleAt && (Loc_Now >= Loc_RxIdleAt))
+		{
+			Sim_PostEvent(SIM_EVENT_RX_IDLE, 0);
+			Loc_RxIdleAt = 0;
+			Loc_Posted = 1;
+		}
+
+		if (Loc_Now >= Loc_TickAt)
+		{
+			Sim_PostEvent(SIM_EVENT_TICK, 0);
+			Loc_TickAt = Loc_Now + SIM_TICK_PERIOD_NS;
+			Loc_Posted = 1;
+		}
+		if (Loc_Posted)
+		{
+			pthread_kill(Sim_CoreThread, SIGUSR1);
+		}
+
+		/* Sleep until the next deadline, a DR write or bytes from the pty */
+		Loc_Next = Loc_TickAt;
+		if (Loc_TxBusy && (Loc_TxDoneAt < Loc_Next))
+		{
+			Loc_Next = Loc_TxDoneAt;
+		}
+		if (Loc_RxDoneAt && (Loc_RxDoneAt < Loc_Next))
+		{
+			Loc_Next = Loc_RxDoneAt;
+		}
+		if (Loc_RxIdleAt && (Loc_RxIdleAt < Loc_Next))
+		{
+			Loc_Next = Loc_RxIdleAt;
+		}
+		Loc_Now = Sim_Now();
+		Loc_Next = (Loc_Next > Loc_Now) ? (Loc_Next - Loc_Now) : 0;
+		Loc_Timeout.tv_sec = (time_t)(Loc_Next / SIM_NS_PER_SECOND);
+		Loc_Timeout.tv_nsec = (long)(Loc_Next % SIM_NS_PER_SECOND);
+		Loc_Fds[0].fd = Sim_WakeFd;
+		Loc_Fds[0].events = POLLIN;
+		Loc_Fds[1].fd = Sim_PtyMaster;
+		Loc_Fds[1].events = ((Loc_RxHead - Loc_RxTail) < SIM_RX_FIFO_SIZE) ? POLLIN : 0;
+		if (ppoll(Loc_Fds, 2, &Loc_Timeout, NULL) > 0)
+		{
+			if (Loc_Fds[0].revents & POLLIN)
+			{
+				uint64_t Loc_Count;
+				(void)read(Sim_WakeFd, &Loc_Count, sizeof(Loc_Count));
+			}
+			if (Loc_Fds[1].revents & POLLIN)
+			{
+				uint8_t Loc_Chunk[256];
+				uint32_t Loc_Room = SIM_RX_FIFO_SIZE - (Loc_RxHead - Loc_RxTail);
+				ssize_t Loc_Len = read(Sim_PtyMaster, Loc_Chunk, (Loc_Room < sizeof(Loc_Chunk)) ? Loc_Room : sizeof(Loc_Chunk));
+				uint32_t Loc_CR1 = SIM_REG(SIM_USART1_BASE + SIM_USART_CR1);
+				ssize_t Loc_idx;
+
+				/* Bytes sent while the receiver is disabled are not seen by the USART */
+				if ((Loc_Len > 0) && ((Loc_CR1 & (SIM_USART_CR1_UE | SIM_USART_CR1_RE)) == (SIM_USART_CR1_UE | SIM_USART_CR1_RE)))
+				{
+					for (Loc_idx = 0; Loc_idx < Loc_Len; Loc_idx++)
+					{
+						Loc_RxFifo[Loc_RxHead % SIM_RX_FIFO_SIZE] = Loc_Chunk[Loc_idx];
+						Loc_RxHead++;
+					}
+					if (Loc_RxDoneAt == 0)
+					{
+						/* The first byte starts on the wire now, or after the previous stop bit */
+						Loc_Now = Sim_Now();
+						Loc_RxDoneAt = ((Loc_RxLineFree > Loc_Now) ? Loc_RxLineFree : Loc_Now) + Loc_Frame;
+						Loc_RxIdleAt = 0;
+					}
+				}
+			}
+		}
+	}
+	return NULL;
+}
+
+static void Sim_OpenPty(void)
+{
+	const char *Loc_Name = NULL;
+	struct termios Loc_Termios;
+	struct stat Loc_Stat;
+
+	Sim_PtyMaster = posix_openpt(O_RDWR | O_NOCTTY);
+	if ((Sim_PtyMaster >= 0) && (grantpt(Sim_PtyMaster) == 0) && (unlockpt(Sim_PtyMaster) == 0))
+	{
+		Loc_Name = ptsname(Sim_PtyMaster);
+	}
+	if (Loc_Name == NULL)
+	{
+		fprintf(stderr, "sim: cannot open a pty for USART1\n");
+		exit(EXIT_FAILURE);
+	}
+	/* Holding the slave open keeps the master usable while no client is connected */
+	Sim_PtySlave = open(Loc_Name, O_RDWR | O_NOCTTY);
+	if ((Sim_PtySlave >= 0) && (tcgetattr(Sim_PtySlave, &Loc_Termios) == 0))
+	{
+		cfmakeraw(&Loc_Termios);
+		tcsetattr(Sim_PtySlave, TCSANOW, &Loc_Termios);
+	}
+	fcntl(Sim_PtyMaster, F_SETFL, fcntl(Sim_PtyMaster, F_GETFL) | O_NONBLOCK);
+
+	Sim_LinkPath = getenv("SIM_SERIAL_LINK");
+	if (Sim_LinkPath == NULL)
+	{
+		Sim_LinkPath = SIM_SERIAL_LINK_DEFAULT;
+	}
+	/* Only a stale link is replaced, never a regular file */
+	if ((lstat(Sim_LinkPath, &Loc_Stat) == 0) && S_ISLNK(Loc_Stat.st_mode))
+	{
+		unlink(Sim_LinkPath);
+	}
+	if (symlink(Loc_Name, Sim_LinkPath) == 0)
+	{
+		atexit(Sim_RemoveLink);
+		fprintf(stderr, "sim: USART1 on %s, linked as %s\n", Loc_Name, Sim_LinkPath);
+	}
+	else
+	{
+		Sim_LinkPath = NULL;
+		fprintf(stderr, "sim: USART1 on %s\n", Loc_Name);
+	}
+}
+
+static void Sim_RemoveLink(void)
+{
+	if (Sim_LinkPath != NULL)
+	{
+		unlink(Sim_LinkPath);
+	}
+}
+
+static void Sim_Terminate(int Signal)
+{
+	(void)Signal;
+	Sim_RemoveLink();
+	_exit(EXIT_SUCCESS);
+}
+
+/**
+ * @brief    : Brings up the simulated chip before main runs.
+ * @details  : - Loads the reset values of the modelled registers.
+ *             - Opens the pty that carries USART1 and starts the wire thread.
+ *             - Installs the signal that enters the simulated interrupt handlers on the core thread.
+ **/
+__attribute__((constructor)) static void Sim_Init(void)
+{
+	struct sigaction Loc_Action = {0};
+	sigset_t Loc_Saved;
+
+	Sim_CoreThread = pthread_self();
+	SIM_REG(SIM_USART1_BASE + SIM_USART_SR) = SIM_USART_SR_TXE | SIM_USART_SR_TC;
+	SIM_REG(SIM_RCC_CR) = SIM_RCC_CR_RESET;
+	RingBuffer_Init(&Sim_TxQueue, Sim_TxQueueBuffer, SIM_TX_QUEUE_SIZE);
+	RingBuffer_Init(&Sim_Events, Sim_EventsBuffer, SIM_EVENT_QUEUE_SIZE);
+	Sim_SysTickStart = Sim_Now();
+	Sim_TraceGpio = (getenv("SIM_GPIO_TRACE") != NULL);
+
+	Loc_Action.sa_handler = Sim_CoreSignal;
+	Loc_Action.sa_flags = SA_RESTART;
+	sigemptyset(&Loc_Action.sa_mask);
+	sigaction(SIGUSR1, &Loc_Action, NULL);
+	signal(SIGINT, Sim_Terminate);
+	signal(SIGTERM, Sim_Terminate);
+
+	Sim_OpenPty();
+	Sim_WakeFd = eventfd(0, EFD_NONBLOCK);
+
+	/* The wire thread never takes the interrupt signal */
+	Sim_Lock(&Loc_Saved);
+	pthread_create(&Sim_WireThread, NULL, Sim_WireMain, NULL);
+	Sim_Unlock(&Loc_Saved);
+	/* Nice is per thread on Linux, only the busy polling core is lowered */
+	setpriority(PRIO_PROCESS, (id_t)syscall(SYS_gettid), SIM_CORE_NICE);
+}
@@ -0,0 +1,48 @@
+/*
+ ============================================================================
+ Name        : Sim.h
+ Author      : Omar Medhat Mohamed
+ Description : Header File for the host-native firmware simulator
+ Date        : 1/6/2024
+ ============================================================================
+ */
+#ifndef SIM_H_
+#define SIM_H_
+/*******************************************************************************
+ *                                Includes	                                  *
+ *******************************************************************************/
+#include "LIB/Stm32F401cc.h"
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+/* Symlink to the pty that carries the simulated USART1, relative to the directory the
+ * simulator is started from, overridden at run time by the SIM_SERIAL_LINK environment variable */
+#ifndef SIM_SERIAL_LINK_DEFAULT
+#define SIM_SERIAL_LINK_DEFAULT		"nanopbsender/COM9"
+#endif
+/* Clock of the external crystal on the board */
+#define SIM_HSE_CLOCK				25000000UL
+#define SIM_HSI_CLOCK				16000000UL
+/* Period of the timer that re-evaluates the level triggered interrupts */
+#define SIM_TICK_PERIOD_NS			1000000UL
+/* Bytes read from the pty ahead of the simulated wire */
+#define SIM_RX_FIFO_SIZE			4096
+/* Bytes written to DR and not yet shifted out */
+#define SIM_TX_QUEUE_SIZE			64
+/* Events posted by the timing thread to the simulated core, must be a power of two */
+#define SIM_EVENT_QUEUE_SIZE		4096
+/*******************************************************************************
+ *                  	    Functions Prototypes                               *
+ *******************************************************************************/
+/**
+ * @brief    : Gets the clock of the APB2 bus as programmed in the simulated RCC.
+ * @return   : uint32_t Clock in Hz.
+ **/
+uint32_t Sim_GetAPB2Clock(void);
+
+/**
+ * @brief    : Gets the clock of the AHB bus as programmed in the simulated RCC.
+ * @return   : uint32_t Clock in Hz.
+ **/
+uint32_t Sim_GetAHBClock(void);
+#endif
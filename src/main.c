@@ -2,21 +2,87 @@
 /************************************************Includes************************************************/
 /********************************************************************************************************/
 
+#include <string.h>
 #include <pb_encode.h>
 #include <pb_decode.h>
 #include "proto/message.pb.h"
+#include "proto/message.services.h"
 
 #include "MCAL/GPIO/GPIO.h"
 #include "HAL/ControlClock/CLK_Control.h"
 
 #include "HAL/HUART/HUART.h"
 #include "MCAL/RCC/RCC.h"
+#include "MCAL/NVIC/NVIC.h"
+#include "MCAL/SysTick/SysTick.h"
+#include "MCAL/CRC/CRC.h"
+#include "LIB/RingBuffer.h"
+#include "LIB/Cobs.h"
+#include "HAL/Profile/Profile.h"
 
 
 /********************************************************************************************************/
 /************************************************Defines*************************************************/
 /********************************************************************************************************/
-#define PROTOBUFF_HEADER_LEN 10
+#define PROTOBUFF_HEADER_LEN Msg_Header_size
+/* Compact header is a varint tag ((ID + 1) << 3 | PB_WT_STRING) followed by a varint body length,
+ * the sequenced one a varint tag ((ID + 1) << 3 | PB_WT_VARINT), a varint sequence number and the length */
+#define PROTOBUFF_COMPACT_HEADER_MAX_LEN 10
+#define PROTOBUFF_RX_CHUNK_LEN 16
+/* Body of the largest request, see Proto_RequestSizes_t */
+#define PROTOBUFF_RX_BUFFER_LEN (sizeof(Proto_RequestSizes_t))
+/* Raw frames with a body up to this length are staged in Proto_Rx_Buffer and queued, longer ones
+ * are decoded straight from the Rx queue, see Proto_DispatchStream */
+#define PROTOBUFF_RX_STAGE_LEN 32
+/* A streamed frame is given up after this long without a byte */
+#define PROTOBUFF_RX_STREAM_TIMEOUT_MS 100
+/* Optional CRC-32/MPEG-2 trailer of a COBS frame, over header and body, least significant byte first */
+#define PROTOBUFF_CRC_LEN 4
+/* Frames waiting for decode, a chunk can complete at most one frame per 2 bytes. Power of two */
+#define PROTOBUFF_FRAME_QUEUE_DEPTH 8
+
+/* Where queued frames are decoded and handled */
+#define PROTO_DISPATCH_MAIN_LOOP 0
+#define PROTO_DISPATCH_SWI       1
+#ifndef PROTO_DISPATCH_MODE
+#define PROTO_DISPATCH_MODE PROTO_DISPATCH_SWI
+#endif
+/* Unused peripheral vector pended by software, lowest priority so USART and DMA preempt decoding */
+#define PROTO_DISPATCH_IRQ          SPI4_IRQ
+#define PROTO_DISPATCH_IRQ_PRIORITY 15
+
+/* nanopb only checks that an enum value fits its byte, not that it is a declared value, so the
+ * port and pin of every request are checked before they index the GPIO driver tables */
+#define PROTO_PORT_VALID(Port)     ((uint32_t)(Port) <= (uint32_t)_Gpio_Port_MAX)
+#define PROTO_PIN_VALID(Port, Pin) (PROTO_PORT_VALID(Port) && ((uint32_t)(Pin) <= (uint32_t)_Gpio_Pin_MAX))
+
+/* Latency counters count SysTick ticks at the AHB clock, SysTick wraps every PROTO_TICK_MASK + 1 */
+#define PROTO_TICK_MASK 0x7FFFFF
+
+/* Rate of USART1 at start up, see USART_Cfg.c, and the one the link returns to */
+#define LINK_DEFAULT_BAUD_RATE 9600
+/* A link running at a negotiated rate falls back to LINK_DEFAULT_BAUD_RATE after this long without
+ * a valid frame, the host does the same, see LINK_SPEED_TIMEOUT in Request_Services.py */
+#define LINK_IDLE_TIMEOUT_MS 2000
+
+#if PROTOBUFF_FRAME_QUEUE_DEPTH < (PROTOBUFF_RX_CHUNK_LEN / 2)
+#error "The frame queue must hold every frame a single Rx chunk can complete"
+#endif
+
+/* Largest reply frame before COBS: header, body and CRC trailer */
+#define PROTOBUFF_TX_FRAME_MAX_LEN (PROTOBUFF_HEADER_LEN + MESSAGE_PB_H_MAX_SIZE + PROTOBUFF_CRC_LEN)
+/* A COBS frame carries the header, the body and the CRC trailer, encoded between two delimiters */
+#define PROTOBUFF_COBS_FRAME_MAX_LEN (COBS_ENCODED_MAX(PROTOBUFF_TX_FRAME_MAX_LEN) + 2)
+/* Start of the plain reply frame in Proto_Tx_Frame, far enough for COBS to encode it in place */
+#define PROTOBUFF_TX_FRAME_OFFSET (1 + COBS_INPLACE_OFFSET(PROTOBUFF_TX_FRAME_MAX_LEN))
+
+#if PROTOBUFF_COBS_FRAME_MAX_LEN > HUART_TX_QUEUE_SIZE
+#error "The Tx queue must hold the largest reply frame"
+#endif
+
+#ifdef PB_BUFFER_ONLY
+#error "Streamed frames are read and written through pb_istream_t and pb_ostream_t callbacks, build without PB_BUFFER_ONLY"
+#endif
 
 
 
@@ -28,48 +94,181 @@ typedef enum
 {
   HEADER_RECEIVE_STATE,
   MSG_RECEIVE_STATE,
+  COBS_RECEIVE_STATE,   /* Between the delimiters of a COBS frame */
 }ProtoBuf_Receive_State_t;
 
-/* Received Messages handlers */
+/* Frame header formats, detected per received frame from the wire type of the first byte */
 typedef enum
 {
-  MSG_RESETPIN_ID,
-  MSG_READPIN_ID,
-  MSG_SETPIN_ID,
-  MSG_TOGGLEPIN_ID,
-  MSG_PINVALUE_ID,
-}MessageID_t;
-/********************************************************************************************************/
-/*****************************************Static Functions Prototype*************************************/
-/********************************************************************************************************/
-static void ResetPinHandler(void);
-static void ReadPinHandler(void);
-static void SetPinHandler(void);
-static void TogglePinHandler(void);
-static void Proto_Send(MessageID_t MsgID);
+  FRAMING_LEGACY,     /* Msg_Header, two fixed32 fields (10 bytes) */
+  FRAMING_COMPACT,    /* Varint tag carrying the ID, varint length (2 bytes for small messages) */
+  FRAMING_SEQUENCED,  /* Compact plus a varint sequence number echoed by the reply, for pipelining hosts */
+}ProtoBuf_Framing_t;
 
-/********************************************************************************************************/
-/************************************************Variables***********************************************/
-/********************************************************************************************************/
+typedef enum
+{
+  HEADER_INCOMPLETE,
+  HEADER_INVALID,
+  HEADER_OK,
+}ProtoBuf_Header_Status_t;
 
-uint8_t Proto_Rx_Buffer[50] = {0};
-uint8_t Proto_Tx_Buffer[50] = {0};
+/* Message IDs, the request and reply lists and the handler of each request come from
+ * proto/message.services through the generated proto/message.services.h */
 
-HUSART_UserReq_t HUART_RxReq;
+/* Every message ID has its own handler probe */
+PB_STATIC_ASSERT(MSG_ID_NUM <= PROFILE_HANDLER_PROBES, PROFILE_HANDLER_PROBES_TOO_FEW)
 
-/* Global Received messages */
-Msg_ResetPin  ResetPinMsg;
-Msg_ReadPin   ReadPinMsg;
-Msg_SetPin    SetPinMsg;
-Msg_TogglePin TogglePinMsg;
+/* Encoded size of the largest request, Proto_Rx_Buffer holds any of them */
+#define PROTO_SIZE_MEMBER(Name, MaxSize) uint8_t Name[MaxSize];
+typedef union
+{
+  PROTO_REQUEST_MESSAGES(PROTO_SIZE_MEMBER)
+}Proto_RequestSizes_t;
 
-/* Global transmit messages */
-Msg_PinValue  PinValueMsg;
+typedef union
+{
+  PROTO_REPLY_MESSAGES(PROTO_SIZE_MEMBER)
+}Proto_ReplySizes_t;
 
+/* Complete frame waiting in the frame queue */
+typedef struct
+{
+  MessageID_t MessageID;
+  ProtoBuf_Framing_t Framing;
+  bool Cobs;        /* Received COBS encoded, the reply is encoded too */
+  bool Crc;         /* Followed by a CRC trailer, the reply gets one too */
+  uint32_t Seq;     /* Sequence number of a FRAMING_SEQUENCED frame */
+  uint32_t Len;
+  uint32_t Offset;  /* Start of the body in Data, COBS frames are decoded with their header */
+  uint32_t Stamp;   /* SysTick value when the frame was queued */
+  uint8_t Data[PROTOBUFF_HEADER_LEN + PROTOBUFF_RX_BUFFER_LEN + PROTOBUFF_CRC_LEN];
+}ProtoBuf_Frame_t;
+
+/* Only one request is decoded and handled at a time, all of them share the same storage.
+ * Replies are built while their request is still in use, so they get a union of their own */
+#define PROTO_UNION_MEMBER(Name, MaxSize) Msg_##Name Name;
+typedef union
+{
+  PROTO_REQUEST_MESSAGES(PROTO_UNION_MEMBER)
+}Proto_Request_t;
+
+typedef union
+{
+  PROTO_REPLY_MESSAGES(PROTO_UNION_MEMBER)
+}Proto_Reply_t;
+
+/* Receive path stages timed by the latency counters */
+typedef enum
+{
+  PROTO_STAGE_FRAMING,  /* Header parsing and frame assembly of one Rx chunk */
+  PROTO_STAGE_QUEUE,    /* Time a frame waited in the frame queue */
+  PROTO_STAGE_DECODE,   /* pb_decode of the frame body */
+  PROTO_STAGE_HANDLER,  /* Message handler, including its reply */
+  PROTO_STAGE_NUM,
+}Proto_Stage_t;
+
+typedef struct
+{
+  uint32_t Count;
+  uint32_t Last;
+  uint32_t Max;
+  uint32_t Total;
+}Proto_StageStats_t;
+
+/* Raw frame too long for Proto_Rx_Buffer, its body is read from the Rx queue while it is decoded */
+typedef struct
+{
+  bool Pending;         /* Header received, the body waits in the Rx queue */
+  MessageID_t MessageID;
+  ProtoBuf_Framing_t Framing;
+  uint32_t Seq;
+  uint32_t Len;
+  uint32_t Staged;      /* Body bytes received with the header, left in Proto_Rx_Buffer */
+  uint32_t StagedRead;  /* Staged bytes already read */
+  uint32_t Read;        /* Body bytes handed to the decoder or skipped, staged ones included */
+  bool TimedOut;        /* The link went quiet, the rest of the body is not waited for again */
+  uint32_t LastTick;    /* SysTick value of the last Proto_TickCount of the frame */
+  uint32_t Ticks;       /* Ticks spent on the frame so far */
+}ProtoBuf_RxStream_t;
+/********************************************************************************************************/
+/*****************************************Static Functions Prototype*************************************/
+/********************************************************************************************************/
+static bool Proto_Send(MessageID_t MsgID);
 
+/********************************************************************************************************/
+/************************************************Variables***********************************************/
+/********************************************************************************************************/
 
+/* Frame assembly buffer, holds the header then the body of a short raw frame */
+uint8_t Proto_Rx_Buffer[PROTOBUFF_RX_STAGE_LEN] = {0};
+/* Reply frame, built at PROTOBUFF_TX_FRAME_OFFSET and COBS encoded in place between its delimiters */
+static uint8_t Proto_Tx_Frame[PROTOBUFF_COBS_FRAME_MAX_LEN];
+
+/* Every header format fits in the room left for a legacy header */
+PB_STATIC_ASSERT(PROTOBUFF_COMPACT_HEADER_MAX_LEN <= PROTOBUFF_HEADER_LEN, COMPACT_HEADER_TOO_LONG)
+/* Every reply fits in a frame, whatever the schema grows into */
+PB_STATIC_ASSERT(sizeof(Proto_ReplySizes_t) <= MESSAGE_PB_H_MAX_SIZE, REPLY_LARGER_THAN_TX_FRAME)
+PB_STATIC_ASSERT(PROTOBUFF_TX_FRAME_OFFSET + PROTOBUFF_TX_FRAME_MAX_LEN <= sizeof(Proto_Tx_Frame), TX_FRAME_TOO_SMALL)
+/* A whole Rx chunk can be held while the header is parsed */
+PB_STATIC_ASSERT(PROTOBUFF_RX_CHUNK_LEN <= PROTOBUFF_RX_STAGE_LEN, RX_BUFFER_SMALLER_THAN_CHUNK)
+PB_STATIC_ASSERT(PROTOBUFF_HEADER_LEN <= PROTOBUFF_RX_STAGE_LEN, RX_BUFFER_SMALLER_THAN_HEADER)
+
+/* Replies use the framing of the frame being handled, old hosts keep getting Msg_Header */
+static ProtoBuf_Framing_t Proto_Framing = FRAMING_LEGACY;
+static bool Proto_Cobs = false;
+static bool Proto_CrcTrailer = false;
+static uint32_t Proto_Seq = 0;
+
+/* COBS decoder, writes straight into the next free slot of the frame queue */
+static Cobs_Decoder_t Proto_CobsDecoder;
+/* Set by a valid COBS frame, the link then stays COBS until LINK_IDLE_TIMEOUT_MS without one */
+static volatile bool Proto_LinkCobs = false;
+
+/* Frames assembled by Proto_Receive, handled by Proto_ProcessFrames. Free running indices */
+static ProtoBuf_Frame_t Proto_FrameQueue[PROTOBUFF_FRAME_QUEUE_DEPTH];
+static uint32_t Proto_FrameHead = 0;
+static uint32_t Proto_FrameTail = 0;
+
+/* Frame whose header Proto_Receive stopped at, decoded by Proto_DispatchStream */
+static ProtoBuf_RxStream_t Proto_RxStream;
+
+/* Frames lost because the frame queue was full */
+uint32_t Proto_FrameDrops = 0;
+/* COBS frames dropped as malformed, cut short or too long */
+uint32_t Proto_CobsErrors = 0;
+/* Frames dropped because their CRC trailer did not match */
+uint32_t Proto_CrcErrors = 0;
+/* Per stage latency in SysTick ticks, read with the debugger */
+Proto_StageStats_t Proto_Stats[PROTO_STAGE_NUM];
+
+/* Rate USART1 runs at, and the rate to switch to once the ack has been sent (0 for none).
+ * Link_PendingBaudRate is set by the dispatch stage and applied from the main loop */
+static uint32_t Link_BaudRate = LINK_DEFAULT_BAUD_RATE;
+static volatile uint32_t Link_PendingBaudRate = 0;
+/* Set by the dispatch stage for every valid frame, restarts the idle timeout */
+static volatile bool Link_Traffic = false;
+/* Ticks without a valid frame, counted by Link_Poll and by Proto_RxStreamRead while it waits */
+static uint32_t Link_LastTick = 0;
+static uint32_t Link_IdleTicks = 0;
+
+
+/* Request being handled, decoded in place by Proto_Dispatch */
+static Proto_Request_t Proto_Request;
+/* Reply of the request being handled */
+static Proto_Reply_t Proto_Reply;
+
+/* A report carries every probe */
+PB_STATIC_ASSERT(_PROFILE_PROBE_NUM <= pb_arraysize(Msg_ProfileReport, Probes), PROFILE_REPORT_TOO_SMALL)
+/* Pin messages carry the GPIO driver values as they are */
+PB_STATIC_ASSERT(((int)Gpio_Port_PORT_A == (int)GPIO_GPIOA) && ((int)Gpio_Port_PORT_H == (int)GPIO_GPIOH),
+                 GPIO_PORT_VALUES_DIFFER)
+PB_STATIC_ASSERT(((int)Gpio_Pin_PIN_0 == (int)GPIO_PIN0) && ((int)Gpio_Pin_PIN_15 == (int)GPIO_PIN15),
+                 GPIO_PIN_VALUES_DIFFER)
+PB_STATIC_ASSERT(((int)Gpio_PinState_STATE_LOW == (int)GPIO_PINSTATE_RESET) &&
+                 ((int)Gpio_PinState_STATE_HIGH == (int)GPIO_PINSTATE_SET), GPIO_PINSTATE_VALUES_DIFFER)
+/* Every operation takes at least a tag and a length byte, Ops_Done counts all of them */
+PB_STATIC_ASSERT((MSG_BATCH_MAX_SIZE / 2) < (1UL << (8 * pb_membersize(Msg_BatchResult, Ops_Done))), OPS_DONE_TOO_SMALL)
 
-void (*messageHandlers[])(void) = {ResetPinHandler, ReadPinHandler, SetPinHandler, TogglePinHandler};
 
 
 
@@ -77,224 +276,1128 @@ void (*messageHandlers[])(void) = {ResetPinHandler, ReadPinHandler, SetPinHandle
 /********************************************************************************************************/
 /*********************************************APIs Implementation****************************************/
 /********************************************************************************************************/
+static bool ResetPin(const Msg_ResetPin *Request)
+{
+  bool status = PROTO_PIN_VALID(Request->Pin_Port, Request->Pin_Num);
+
+  if (status)
+  {
+    GPIO_setPinValue((GPIO_Port_t)Request->Pin_Port, (GPIO_Pin_t)Request->Pin_Num, GPIO_PINSTATE_RESET);
+  }
+
+  return status;
+}
 static void ResetPinHandler(void)
 {
-  GPIO_setPinValue(ResetPinMsg.Pin_Port, ResetPinMsg.Pin_Num, GPIO_PINSTATE_RESET);
+  ResetPin(&Proto_Request.ResetPin);
+}
+static bool ReadPin(const Msg_ReadPin *Request, Msg_PinValue *Value)
+{
+  bool status = PROTO_PIN_VALID(Request->Pin_Port, Request->Pin_Num);
+
+  if (status)
+  {
+    GPIO_PinState_t PinState = GPIO_getPinValue((GPIO_Port_t)Request->Pin_Port, (GPIO_Pin_t)Request->Pin_Num);
+    Value->Pin_Port = Request->Pin_Port;
+    Value->Pin_Num = Request->Pin_Num;
+    Value->Pin_Read = (Gpio_PinState)PinState;
+  }
+
+  return status;
 }
 static void ReadPinHandler(void)
 {
-  GPIO_PinState_t PinState = GPIO_getPinValue(ReadPinMsg.Pin_Port, ReadPinMsg.Pin_Num);
-  PinValueMsg.Pin_Port = ReadPinMsg.Pin_Port;
-  PinValueMsg.Pin_Num = ReadPinMsg.Pin_Num;
-  PinValueMsg.Pin_Read = PinState;
-  Proto_Send(MSG_PINVALUE_ID);
+  /* A pin that does not exist gets no reply, like a malformed request */
+  if (ReadPin(&Proto_Request.ReadPin, &Proto_Reply.PinValue))
+  {
+    Proto_Send(MSG_PINVALUE_ID);
+  }
+}
+static bool SetPin(const Msg_SetPin *Request)
+{
+  bool status = PROTO_PIN_VALID(Request->Pin_Port, Request->Pin_Num);
+
+  if (status)
+  {
+    GPIO_setPinValue((GPIO_Port_t)Request->Pin_Port, (GPIO_Pin_t)Request->Pin_Num, GPIO_PINSTATE_SET);
+  }
+
+  return status;
 }
 static void SetPinHandler(void)
 {
-  GPIO_setPinValue(SetPinMsg.Pin_Port, SetPinMsg.Pin_Num, GPIO_PINSTATE_SET);
+  SetPin(&Proto_Request.SetPin);
+}
+static bool TogglePin(const Msg_TogglePin *Request)
+{
+  bool status = PROTO_PIN_VALID(Request->Pin_Port, Request->Pin_Num);
 
+  if (status)
+  {
+    GPIO_PinState_t PinState = GPIO_getPinValue((GPIO_Port_t)Request->Pin_Port, (GPIO_Pin_t)Request->Pin_Num);
+    GPIO_setPinValue((GPIO_Port_t)Request->Pin_Port, (GPIO_Pin_t)Request->Pin_Num, !PinState);
+  }
+
+  return status;
 }
 static void TogglePinHandler(void)
 {
-  GPIO_PinState_t PinState = GPIO_getPinValue(TogglePinMsg.Pin_Port, TogglePinMsg.Pin_Num);
-  GPIO_setPinValue(TogglePinMsg.Pin_Port, TogglePinMsg.Pin_Num, !PinState);
+  TogglePin(&Proto_Request.TogglePin);
+}
+static void BatchHandler(void)
+{
+  Proto_Send(MSG_BATCHRESULT_ID);
+}
+static void WritePortHandler(void)
+{
+  if (PROTO_PORT_VALID(Proto_Request.WritePort.Port))
+  {
+    /* All the masked pins change together in one BSRR write */
+    GPIO_writePortMasked((GPIO_Port_t)Proto_Request.WritePort.Port, Proto_Request.WritePort.Set_Mask,
+                         Proto_Request.WritePort.Reset_Mask);
+  }
+}
+static void ReadPortHandler(void)
+{
+  if (PROTO_PORT_VALID(Proto_Request.ReadPort.Port))
+  {
+    Proto_Reply.PortValue.Port = Proto_Request.ReadPort.Port;
+    Proto_Reply.PortValue.Value = GPIO_readPort((GPIO_Port_t)Proto_Request.ReadPort.Port);
+    Proto_Send(MSG_PORTVALUE_ID);
+  }
+}
+static void GetProfileHandler(void)
+{
+  Msg_ProfileReport *reply = &Proto_Reply.ProfileReport;
+  Profile_Stats_t stats;
+
+  /* Probes never hit are left out, a build without PROFILE_ENABLE reports none */
+  reply->Core_Clock = RCC_Get_AHB_Frequency();
+  reply->Probes_count = 0;
+  for (uint32_t probe = 0; probe < _PROFILE_PROBE_NUM; probe++)
+  {
+    if ((Profile_GetStats(probe, &stats) == Status_enumOk) && (stats.Count != 0))
+    {
+      Msg_ProbeStats *report = &reply->Probes[reply->Probes_count++];
 
+      report->Probe = probe;
+      report->Count = stats.Count;
+      report->Min = stats.Min;
+      report->Max = stats.Max;
+      report->Mean = (uint32_t)(stats.Total / stats.Count);
+    }
+  }
+  if (Proto_Request.GetProfile.Reset)
+  {
+    Profile_Reset();
+  }
+  Proto_Send(MSG_PROFILEREPORT_ID);
 }
 
-void send_second(void)
+/**
+ * @brief Acknowledges a new link rate, USART1 switches to it after the ack has been sent.
+ *
+ * The ack goes out at the current rate and reports the rate USART1 will actually run at and its
+ * error. A rate USART1 can't reach is refused and the link stays as it is.
+ */
+static void SetLinkSpeedHandler(void)
 {
-      uint8_t messagebytes[20];
-    pb_ostream_t messageStream = pb_ostream_from_buffer(messagebytes, sizeof(messagebytes));
-    void * dest_struct = 0;
-    const pb_msgdesc_t* msg_fields = 0;
-
-        dest_struct = &PinValueMsg;
-        msg_fields = Msg_PinValue_fields;      
+  const Msg_SetLinkSpeed *request = &Proto_Request.SetLinkSpeed;
+  Msg_LinkSpeedAck *ack = &Proto_Reply.LinkSpeedAck;
+  /* Left untouched by a refused rate (0 or an unknown port), the ack then reports 0 and 0 */
+  USART_BaudInfo_t info = {0};
+
+  ack->Accepted = (USART_CheckBaudRate(USART1_ID, request->Baud_Rate, &info) == Status_enumOk);
+  ack->Baud_Rate = info.ActualBaudRate;
+  ack->Error_PPM = info.ErrorPPM;
+  /* The switch waits for the ack, a frame that can't be queued is not acknowledged at all */
+  if (Proto_Send(MSG_LINKSPEEDACK_ID) && ack->Accepted && (request->Baud_Rate != Link_BaudRate))
+  {
+    Link_PendingBaudRate = request->Baud_Rate;
+  }
+}
 
+/**
+ * @brief Decode callback of Msg_Batch.Ops, called by pb_decode once per operation.
+ *
+ * Each operation is executed as soon as it is decoded, so the batch needs no storage and
+ * operations run in the order they were sent. Read results are appended to the Msg_BatchResult reply.
+ *
+ * @param[in] stream Substream holding one Msg_BatchOp.
+ * @param[in] field  Field being decoded.
+ * @param[in] arg    Unused.
+ * @return false to stop decoding, when the operation is malformed, names a port or pin that does
+ *         not exist or the result is full. Ops_Done then tells the host where the batch stopped.
+ */
+static bool BatchOpDecode(pb_istream_t *stream, const pb_field_t *field, void **arg)
+{
+  Msg_BatchResult *result = &Proto_Reply.BatchResult;
+  Msg_BatchOp Op = Msg_BatchOp_init_zero;
+  bool status = pb_decode(stream, Msg_BatchOp_fields, &Op);
 
-        HUSART_UserReq_t HUART_TxReq =
+  if (status)
+  {
+    switch (Op.which_Op)
     {
-        .USART_ID = USART1_ID,
-        .Buff_cb = 0,
-    };
-    /* Encode the message to get its size*/
-    pb_encode(&messageStream, msg_fields, dest_struct);
-      /* Send message */
-   HUART_TxReq.Ptr_buffer= messagebytes;
-   HUART_TxReq.Buff_Len = messageStream.bytes_written;
-    for(volatile uint32_t i = 0; i < 200000; i++);
+    case Msg_BatchOp_Set_Pin_tag:
+      status = SetPin(&Op.Op.Set_Pin);
+      break;
+    case Msg_BatchOp_Reset_Pin_tag:
+      status = ResetPin(&Op.Op.Reset_Pin);
+      break;
+    case Msg_BatchOp_Toggle_Pin_tag:
+      status = TogglePin(&Op.Op.Toggle_Pin);
+      break;
+    case Msg_BatchOp_Read_Pin_tag:
+      status = (result->Reads_count < pb_arraysize(Msg_BatchResult, Reads)) &&
+               ReadPin(&Op.Op.Read_Pin, &result->Reads[result->Reads_count]);
+      if (status)
+      {
+        result->Reads_count++;
+      }
+      break;
+    default:
+      break;
+    }
+  }
+
+  if (status)
+  {
+    result->Ops_Done++;
+  }
 
-    HUART_SendBuffAsync(&HUART_TxReq);
+  return status;
 }
-void Proto_Send(MessageID_t MsgID)
+
+/**
+ * @brief Write callback of the Tx stream, queues the bytes behind the ones already queued.
+ *
+ * HUART_SendBuffAsync copies them into the Tx queue of the port and starts the transmitter
+ * if it is idle, so the first bytes of a frame go out while the rest is still being encoded.
+ *
+ * @param[in] stream Tx stream, its state holds the USART ID.
+ * @param[in] buf    Bytes written by the encoder.
+ * @param[in] count  Number of bytes.
+ * @return false if the Tx queue is full.
+ */
+static bool Proto_TxStreamWrite(pb_ostream_t *stream, const pb_byte_t *buf, size_t count)
 {
+  HUSART_UserReq_t HUART_TxReq =
+  {
+      .USART_ID = (uint8_t)(uintptr_t)stream->state,
+      .Ptr_buffer = (uint8_t *)buf,
+      .Buff_Len = count,
+      .Buff_cb = 0,
+  };
+
+  return (HUART_SendBuffAsync(&HUART_TxReq) == Status_enumOk);
+}
+
+/**
+ * @brief Builds a complete Tx frame (header followed by body) into a stream.
+ *
+ * The body size is computed by the caller with pb_get_encoded_size so the header, length
+ * prefix included, can be encoded first and the body appended right behind it, without
+ * intermediate scratch buffers. In compact framing the frame is the body encoded as a
+ * length-delimited field whose field number is the message ID + 1.
+ *
+ * @param[in]  Framing     Header format of the frame.
+ * @param[in]  Seq         Sequence number of a FRAMING_SEQUENCED frame.
+ * @param[in]  MsgID       ID of the message carried in the frame.
+ * @param[in]  fields      Descriptor of the body message.
+ * @param[in]  src         Pointer to the body message struct.
+ * @param[in]  bodySize    Encoded size of the body.
+ * @param[out] frameStream Destination of the frame, a buffer or the Tx queue.
+ * @return true if the frame was built successfully, false otherwise.
+ */
+static bool Proto_BuildFrame(ProtoBuf_Framing_t Framing, uint32_t Seq, MessageID_t MsgID, const pb_msgdesc_t *fields,
+                             const void *src, size_t bodySize, pb_ostream_t *frameStream)
+{
+  bool status = false;
+
+  if (Framing == FRAMING_LEGACY)
+  {
     Msg_Header HeaderMsg = Msg_Header_init_zero;
+
     HeaderMsg.msg_ID = MsgID;
+    HeaderMsg.msg_len = bodySize;
+    status = pb_encode(frameStream, Msg_Header_fields, &HeaderMsg);
+  }
+  else
+  {
+    status = pb_encode_tag(frameStream, (Framing == FRAMING_COMPACT) ? PB_WT_STRING : PB_WT_VARINT,
+                           (uint32_t)MsgID + 1) &&
+             ((Framing == FRAMING_COMPACT) || pb_encode_varint(frameStream, Seq)) &&
+             pb_encode_varint(frameStream, bodySize);
+  }
+
+  return status && pb_encode(frameStream, fields, src);
+}
 
-    uint8_t headerbytes[20];
-    uint8_t messagebytes[20];
+/**
+ * @brief Builds a Tx frame around a body written by the straight-line encoder of its message.
+ *
+ * The encoder gives the body length only once it is written. The legacy header has a fixed
+ * size, so the body goes behind it first. The compact headers end with a one byte length,
+ * the body of a message shorter than 128 bytes goes behind it and the length is filled in.
+ *
+ * @param[in]  Framing  Header format of the frame.
+ * @param[in]  Seq      Sequence number of a FRAMING_SEQUENCED frame.
+ * @param[in]  Service  Service table entry of the message, with a FastEncode and MaxSize below 128.
+ * @param[in]  src      Pointer to the body message struct.
+ * @param[out] frame    Destination frame buffer, PROTOBUFF_HEADER_LEN + MaxSize bytes at least.
+ * @param[out] frameLen Number of bytes written into the frame buffer.
+ * @return true if the frame was built successfully, false otherwise.
+ */
+static bool Proto_BuildFastFrame(ProtoBuf_Framing_t Framing, uint32_t Seq, const Proto_Service_t *Service,
+                                 const void *src, uint8_t *frame, size_t *frameLen)
+{
+  pb_ostream_t headerStream = pb_ostream_from_buffer(frame, PROTOBUFF_HEADER_LEN);
+  uint32_t bodyLen = 0;
+  bool status = false;
 
-    pb_ostream_t headerStream = pb_ostream_from_buffer(headerbytes, sizeof(headerbytes));
-    pb_ostream_t messageStream = pb_ostream_from_buffer(messagebytes, sizeof(messagebytes));
+  if (Framing == FRAMING_LEGACY)
+  {
+    Msg_Header HeaderMsg = Msg_Header_init_zero;
 
-    void * dest_struct = 0;
-    const pb_msgdesc_t* msg_fields = 0;
-    switch(MsgID)
+    bodyLen = Service->FastEncode(src, &frame[PROTOBUFF_HEADER_LEN]);
+    HeaderMsg.msg_ID = Service->Id;
+    HeaderMsg.msg_len = bodyLen;
+    status = pb_encode(&headerStream, Msg_Header_fields, &HeaderMsg);
+  }
+  else
+  {
+    status = pb_encode_tag(&headerStream, (Framing == FRAMING_COMPACT) ? PB_WT_STRING : PB_WT_VARINT,
+                           (uint32_t)Service->Id + 1) &&
+             ((Framing == FRAMING_COMPACT) || pb_encode_varint(&headerStream, Seq));
+    if (status)
     {
-      case MSG_PINVALUE_ID:
-        dest_struct = &PinValueMsg;
-        msg_fields = Msg_PinValue_fields;      
-      break;
-      default:
-      break;
+      bodyLen = Service->FastEncode(src, &frame[headerStream.bytes_written + 1]);
+      frame[headerStream.bytes_written] = (uint8_t)bodyLen;
+      headerStream.bytes_written++;
     }
-    /* Encode the message to get its size*/
-    pb_encode(&messageStream, msg_fields, dest_struct);
+  }
 
-    HeaderMsg.msg_len = messageStream.bytes_written;
+  *frameLen = headerStream.bytes_written + bodyLen;
 
-    /* Encode the header*/
-    pb_encode(&headerStream, Msg_Header_fields, &HeaderMsg);
+  return status;
+}
 
+/**
+ * @brief Computes the CRC trailer of a frame on the CRC unit.
+ *
+ * Only called from the dispatch stage, the CRC unit is not shared with another context.
+ *
+ * @param[in] frame    Header and body of the frame.
+ * @param[in] frameLen Number of bytes covered by the CRC.
+ * @return CRC-32/MPEG-2 of the bytes.
+ */
+static uint32_t Proto_FrameCrc(const uint8_t *frame, uint32_t frameLen)
+{
+  uint32_t crc = 0;
+  PROFILE_BEGIN(crcStart);
 
-    HUSART_UserReq_t HUART_TxReq =
-    {
-        .USART_ID = USART1_ID,
-        .Buff_cb = 0,
-    };
+  CRC_Calculate(frame, frameLen, &crc);
+  PROFILE_END(PROFILE_PROBE_CRC, crcStart);
 
-    /* Send Header*/
-    HUART_TxReq.Ptr_buffer= headerbytes,
-    HUART_TxReq.Buff_Len = headerStream.bytes_written;
+  return crc;
+}
 
-    USART_UserReq_t txreq = {.USART_ID = USART1_ID, .Ptr_buffer=  headerbytes, .Buff_Len = 1,.Buff_cb = 0};
+/**
+ * @brief Encodes the reply held in Proto_Reply and queues its frame for transmission.
+ *
+ * Every reply is a member of the Proto_Reply union, so the body always starts at &Proto_Reply
+ * and the service table only has to give its descriptor. Flat replies short enough for a one
+ * byte length go through their straight-line encoder, the others through pb_encode. A raw
+ * frame encoded by pb_encode goes straight into the Tx queue, the transmitter starts on its
+ * first bytes. A COBS frame is built in Proto_Tx_Frame, COBS and the CRC need all of it.
+ *
+ * @param[in] MsgID ID of the reply, a reply of the service table.
+ * @return false if the ID is not a reply, encoding failed or the Tx queue is full.
+ */
+static bool Proto_Send(MessageID_t MsgID)
+{
+  uint8_t *frame = &Proto_Tx_Frame[PROTOBUFF_TX_FRAME_OFFSET];
+  size_t frameLen = 0;
+  size_t bodySize = 0;
+  uint32_t txFree = 0;
+  bool status = false;
+  bool queued = false;
+
+  if ((MsgID < MSG_ID_NUM) && (Proto_Services[MsgID].Fields != NULL) && (Proto_Services[MsgID].Handler == NULL))
+  {
+    const Proto_Service_t *service = &Proto_Services[MsgID];
+    PROFILE_BEGIN(encodeStart);
 
-    for(int i = 0; i < headerStream.bytes_written; i++)
+    if ((service->FastEncode != NULL) && (service->MaxSize < 0x80))
     {
-      txreq.Ptr_buffer = &headerbytes[i];
-      USART_SendByte(&txreq);
+      status = Proto_BuildFastFrame(Proto_Framing, Proto_Seq, service, &Proto_Reply, frame, &frameLen);
     }
+    else if (pb_get_encoded_size(&bodySize, service->Fields, &Proto_Reply) &&
+             (bodySize <= MESSAGE_PB_H_MAX_SIZE))
+    {
+      if (Proto_Cobs)
+      {
+        pb_ostream_t frameStream = pb_ostream_from_buffer(frame, PROTOBUFF_TX_FRAME_MAX_LEN - PROTOBUFF_CRC_LEN);
+
+        status = Proto_BuildFrame(Proto_Framing, Proto_Seq, MsgID, service->Fields, &Proto_Reply, bodySize,
+                                  &frameStream);
+        frameLen = frameStream.bytes_written;
+      }
+      else if ((HUART_GetTxFree(USART1_ID, &txFree) == Status_enumOk) &&
+               (txFree >= PROTOBUFF_HEADER_LEN + bodySize))
+      {
+        /* Room for the whole frame is checked first, a full queue is still reported instead of
+         * sending part of a frame */
+        pb_ostream_t frameStream =
+        {
+            .callback = Proto_TxStreamWrite,
+            .state = (void *)(uintptr_t)USART1_ID,
+            .max_size = PROTOBUFF_HEADER_LEN + bodySize,
+        };
+
+        status = Proto_BuildFrame(Proto_Framing, Proto_Seq, MsgID, service->Fields, &Proto_Reply, bodySize,
+                                  &frameStream);
+        queued = true;
+      }
+    }
+    PROFILE_END(PROFILE_PROBE_PB_ENCODE, encodeStart);
 
+    if (status && !queued && Proto_CrcTrailer)
+    {
+      uint32_t crc = Proto_FrameCrc(frame, frameLen);
 
-    for(int i = 0; i < messageStream.bytes_written; i++)
+      for (uint32_t i = 0; i < PROTOBUFF_CRC_LEN; i++)
+      {
+        frame[frameLen++] = (uint8_t)(crc >> (8 * i));
+      }
+    }
+
+    if (status && !queued)
     {
-      txreq.Ptr_buffer = &messagebytes[i];
-      USART_SendByte(&txreq);
+      HUSART_UserReq_t HUART_TxReq =
+      {
+          .USART_ID = USART1_ID,
+          .Ptr_buffer = frame,
+          .Buff_Len = frameLen,
+          .Buff_cb = 0,
+      };
+
+      if (Proto_Cobs)
+      {
+        /* Encoded in place in front of the frame, leading delimiter too, the host resynchronizes
+         * on it if the previous frame was cut */
+        frameLen = Cobs_Encode(frame, frameLen, &Proto_Tx_Frame[1]);
+        Proto_Tx_Frame[0] = COBS_DELIMITER;
+        Proto_Tx_Frame[frameLen + 1] = COBS_DELIMITER;
+        HUART_TxReq.Ptr_buffer = Proto_Tx_Frame;
+        HUART_TxReq.Buff_Len = frameLen + 2;
+      }
+
+      /* The frame is copied into the Tx queue, a full queue is reported instead of dropped */
+      status = (HUART_SendBuffAsync(&HUART_TxReq) == Status_enumOk);
     }
-//for(volatile uint32_t x = 0-1; x > 1; x--);
-    /* Send message */
-  //  HUART_TxReq.Ptr_buffer= messagebytes,
-   // HUART_TxReq.Buff_Len = messageStream.bytes_written,
-    //HUART_SendBuffAsync(&HUART_TxReq);
+  }
 
+  return status;
+}
 
+/**
+ * @brief Adds the SysTick ticks elapsed since *LastTick to *Ticks and moves *LastTick to now.
+ *
+ * A wrap is only missed if two calls are more than a SysTick period apart, so a span of any
+ * length is measured by calling it at least that often.
+ *
+ * @param[in,out] LastTick SysTick value of the previous call.
+ * @param[in,out] Ticks    Ticks counted so far.
+ */
+static void Proto_TickCount(uint32_t *LastTick, uint32_t *Ticks)
+{
+  uint32_t now = SysTick_currentTick();
 
+  /* SysTick counts down */
+  *Ticks += (*LastTick - now) & PROTO_TICK_MASK;
+  *LastTick = now;
+}
+
+/**
+ * @brief Adds a duration to the latency counters of a stage.
+ *
+ * @param[in] Stage Stage being timed.
+ * @param[in] ticks Duration of the stage in SysTick ticks.
+ */
+static void Proto_StatsRecord(Proto_Stage_t Stage, uint32_t ticks)
+{
+  Proto_StageStats_t *stats = &Proto_Stats[Stage];
 
+  stats->Count++;
+  stats->Last = ticks;
+  stats->Total += ticks;
+  if (ticks > stats->Max)
+  {
+    stats->Max = ticks;
+  }
 }
-void Proto_Receive(void)
+
+/**
+ * @brief Adds the ticks elapsed since Start to the latency counters of a stage.
+ *
+ * Only for stages shorter than a SysTick period, see Proto_TickCount for longer ones.
+ *
+ * @param[in] Stage Stage being timed.
+ * @param[in] Start SysTick value at the start of the stage.
+ */
+static void Proto_StatsAdd(Proto_Stage_t Stage, uint32_t Start)
 {
-  static uint8_t state = 0;
+  /* SysTick counts down */
+  Proto_StatsRecord(Stage, (Start - SysTick_currentTick()) & PROTO_TICK_MASK);
+}
 
-  static MessageID_t MessageID = 0;
-  static uint32_t MessageLen = 0;
-  switch (state)
+/**
+ * @brief Service table entry of a received request.
+ *
+ * @param[in] MessageID ID of the received message.
+ * @param[in] Len       Length of its body.
+ * @return NULL for replies, unused IDs and bodies longer than any request of that ID.
+ */
+static const Proto_Service_t *Proto_RequestService(MessageID_t MessageID, uint32_t Len)
+{
+  return ((MessageID < MSG_ID_NUM) && (Proto_Services[MessageID].Handler != NULL) &&
+          (Len <= Proto_Services[MessageID].MaxSize)) ? &Proto_Services[MessageID] : NULL;
+}
+
+/**
+ * @brief Decodes a request body into Proto_Request.
+ *
+ * Every request is a member of the Proto_Request union and starts at its address. The
+ * straight-line decoder of a flat request falls back to pb_decode on its own.
+ *
+ * @param[in] Service Service table entry of the request.
+ * @param[in] Body    Body bytes for the straight-line decoder, NULL when the body is only in Stream.
+ * @param[in] Stream  Stream holding the body.
+ * @return true if the body was decoded.
+ */
+static bool Proto_Decode(const Proto_Service_t *Service, const uint8_t *Body, pb_istream_t *Stream)
+{
+  bool status = false;
+  PROFILE_BEGIN(decodeStart);
+
+  if (Service->Id == MSG_BATCH_ID)
   {
-  case HEADER_RECEIVE_STATE:
+    /* Operations are executed from the decode callback while the batch is decoded */
+    Proto_Reply.BatchResult.Ops_Done = 0;
+    Proto_Reply.BatchResult.Reads_count = 0;
+    Proto_Request.Batch.Ops.funcs.decode = BatchOpDecode;
+  }
+
+  if ((Body != NULL) && (Service->FastDecode != NULL))
   {
-    /* Allocate space for the decoded message. */
-    Msg_Header HeaderMsg = Msg_Header_init_zero;
+    status = Service->FastDecode(Body, Stream->bytes_left, &Proto_Request);
+  }
+  else
+  {
+    status = pb_decode(Stream, Service->Fields, &Proto_Request);
+  }
+  PROFILE_END(PROFILE_PROBE_PB_DECODE, decodeStart);
 
-    /* Create a stream that reads from the buffer. */
-    pb_istream_t instream;
-    instream = pb_istream_from_buffer(Proto_Rx_Buffer, PROTOBUFF_HEADER_LEN);
+  return status;
+}
 
-    /* Now we are ready to decode the message. */
-    bool status = false;
+/**
+ * @brief Calls the handler of a decoded request, its reply uses the framing of the request.
+ *
+ * @param[in] Service Service table entry of the request.
+ * @param[in] Framing Header format of the request frame.
+ * @param[in] Cobs    Request received COBS encoded.
+ * @param[in] Crc     Request followed by a CRC trailer.
+ * @param[in] Seq     Sequence number of a FRAMING_SEQUENCED request.
+ */
+static void Proto_Handle(const Proto_Service_t *Service, ProtoBuf_Framing_t Framing, bool Cobs, bool Crc, uint32_t Seq)
+{
+  /* Handlers never wait for the link, they end well within a SysTick period, streamed frames too */
+  uint32_t start = SysTick_currentTick();
+  PROFILE_BEGIN(handlerStart);
+
+  /* Any frame that made it through keeps the negotiated rate */
+  Link_Traffic = true;
+  Proto_Framing = Framing;
+  Proto_Cobs = Cobs;
+  Proto_CrcTrailer = Crc;
+  Proto_Seq = Seq;
+  Service->Handler();
+  PROFILE_END(PROFILE_PROBE_HANDLER_FIRST + Service->Id, handlerStart);
+  Proto_StatsAdd(PROTO_STAGE_HANDLER, start);
+}
 
-    status = pb_decode(&instream, Msg_Header_fields, &HeaderMsg);
+/**
+ * @brief Decodes the body of a queued frame and calls its handler.
+ *
+ * @param[in] Frame Frame taken from the frame queue.
+ */
+static void Proto_Dispatch(const ProtoBuf_Frame_t *Frame)
+{
+  MessageID_t MessageID = Frame->MessageID;
+  /* Replies, unused IDs and bodies longer than any request of that ID are dropped unread */
+  const Proto_Service_t *service = Proto_RequestService(MessageID, Frame->Len);
+  bool intact = true;
 
-    /* Check for errors... */
-    if (status)
+  if (Frame->Crc)
+  {
+    const uint8_t *trailer = &Frame->Data[Frame->Offset + Frame->Len];
+    uint32_t crc = 0;
+
+    for (uint32_t i = 0; i < PROTOBUFF_CRC_LEN; i++)
+    {
+      crc |= (uint32_t)trailer[i] << (8 * i);
+    }
+    intact = (Proto_FrameCrc(Frame->Data, Frame->Offset + Frame->Len) == crc);
+    if (!intact)
+    {
+      Proto_CrcErrors++;
+    }
+  }
+
+  if((service != NULL) && intact)
+  {
+    pb_istream_t instream = pb_istream_from_buffer(&Frame->Data[Frame->Offset], Frame->Len);
+    uint32_t start = SysTick_currentTick();
+    bool status = Proto_Decode(service, &Frame->Data[Frame->Offset], &instream);
+
+    Proto_StatsAdd(PROTO_STAGE_DECODE, start);
+
+    /* Check for errors... a batch is answered anyway, Ops_Done tells where it stopped */
+    if (status || (MessageID == MSG_BATCH_ID))
+    {
+      Proto_Handle(service, Frame->Framing, Frame->Cobs, Frame->Crc, Frame->Seq);
+    }
+  }
+}
+
+/**
+ * @brief pb_istream_t callback reading the body of a streamed frame from the USART1 Rx queue.
+ *
+ * The body bytes received with the header come first, then the Rx queue. Bytes still on the
+ * wire are waited for, up to PROTOBUFF_RX_STREAM_TIMEOUT_MS between two of them.
+ *
+ * @param[in]  stream Stream of the frame body, pb_decode keeps its bytes_left.
+ * @param[out] buf    Destination of the bytes, NULL to skip them.
+ * @param[in]  count  Number of bytes to read.
+ * @return false if the link went quiet before count bytes arrived, or did so earlier in the frame.
+ */
+static bool Proto_RxStreamRead(pb_istream_t *stream, pb_byte_t *buf, size_t count)
+{
+  ProtoBuf_RxStream_t *rx = &Proto_RxStream;
+  uint32_t timeoutTicks = (RCC_Get_AHB_Frequency() / 1000) * PROTOBUFF_RX_STREAM_TIMEOUT_MS;
+  uint32_t waitTicks = 0;
+
+  while ((count != 0) && !rx->TimedOut)
+  {
+    bool staged = (rx->StagedRead < rx->Staged);
+    uint8_t *chunk = &Proto_Rx_Buffer[rx->StagedRead];
+    uint32_t chunkLen = rx->Staged - rx->StagedRead;
+    uint32_t ticks = rx->Ticks;
+
+    /* Counted on every pass, the frame can hold the main loop for several SysTick periods */
+    Proto_TickCount(&rx->LastTick, &rx->Ticks);
+    Proto_TickCount(&Link_LastTick, &Link_IdleTicks);
+    if (!staged)
+    {
+      chunkLen = 0;
+      HUART_PeekRxQueue(USART1_ID, &chunk, &chunkLen);
+    }
+    if (chunkLen > count)
     {
-      /* Update the next message length and ID*/
-      MessageID = HeaderMsg.msg_ID;
-      MessageLen = HeaderMsg.msg_len;
-      HUART_RxReq.Buff_Len = MessageLen;
-      HUART_ReceiveBuffAsync(&HUART_RxReq);
+      chunkLen = count;
+    }
 
-      state++;
+    if (chunkLen != 0)
+    {
+      if (buf != NULL)
+      {
+        memcpy(buf, chunk, chunkLen);
+        buf += chunkLen;
+      }
+      if (staged)
+      {
+        rx->StagedRead += chunkLen;
+      }
+      else
+      {
+        HUART_ConsumeRxQueue(USART1_ID, chunkLen);
+      }
+      rx->Read += chunkLen;
+      count -= chunkLen;
+      waitTicks = 0;
     }
+    else
+    {
+      waitTicks += rx->Ticks - ticks;
+      rx->TimedOut = (waitTicks >= timeoutTicks);
+    }
+  }
 
+  return (count == 0);
+}
+
+/**
+ * @brief Decodes the body of a streamed frame straight from the Rx queue and calls its handler.
+ *
+ * Runs from the main loop, the context reading the Rx queue, once the frames received before
+ * it are handled and the Tx queue has room for the reply. pb_decode waits in Proto_RxStreamRead
+ * for the bytes still on the wire, so a batch runs its first operations while the rest arrives
+ * and no body needs a buffer of its own. Streamed frames are raw, without a CRC trailer to check
+ * first. The rest of the body is skipped, the next header follows it, unless the link went quiet
+ * in the middle of the frame. Its decode time is counted in chunks, it can be longer than the
+ * SysTick period.
+ */
+static void Proto_DispatchStream(void)
+{
+  const Proto_Service_t *service = Proto_RequestService(Proto_RxStream.MessageID, Proto_RxStream.Len);
+  pb_istream_t instream = {.callback = Proto_RxStreamRead, .state = NULL, .bytes_left = Proto_RxStream.Len};
+
+  Proto_RxStream.LastTick = SysTick_currentTick();
+  Proto_RxStream.Ticks = 0;
+  if (service != NULL)
+  {
+    bool status = Proto_Decode(service, NULL, &instream);
+
+    Proto_TickCount(&Proto_RxStream.LastTick, &Proto_RxStream.Ticks);
+    Proto_StatsRecord(PROTO_STAGE_DECODE, Proto_RxStream.Ticks);
+    if (status || (service->Id == MSG_BATCH_ID))
+    {
+      Proto_Handle(service, Proto_RxStream.Framing, false, false, Proto_RxStream.Seq);
+    }
+  }
+
+  /* The decoder's bytes_left misses nested fields it gave up in, they were taken off it whole when
+   * their substream was opened. What Proto_RxStreamRead delivered is the exact count */
+  Proto_RxStreamRead(&instream, NULL, Proto_RxStream.Len - Proto_RxStream.Read);
+  Proto_RxStream.Pending = false;
+}
+
+/**
+ * @brief Copies the frame body held in Proto_Rx_Buffer into the frame queue.
+ *
+ * @param[in] MessageID  ID of the received message.
+ * @param[in] Framing    Header format of the frame.
+ * @param[in] Seq        Sequence number of a FRAMING_SEQUENCED frame.
+ * @param[in] MessageLen Length of the message body.
+ * @return false if the queue is full and the frame was dropped.
+ */
+static bool Proto_EnqueueFrame(MessageID_t MessageID, ProtoBuf_Framing_t Framing, uint32_t Seq, uint32_t MessageLen)
+{
+  uint32_t head = Proto_FrameHead;
+  bool status = (head - RING_LOAD_ACQUIRE(&Proto_FrameTail)) < PROTOBUFF_FRAME_QUEUE_DEPTH;
+
+  if (status)
+  {
+    ProtoBuf_Frame_t *frame = &Proto_FrameQueue[head & (PROTOBUFF_FRAME_QUEUE_DEPTH - 1)];
+
+    frame->MessageID = MessageID;
+    frame->Framing = Framing;
+    frame->Cobs = false;
+    frame->Crc = false;
+    frame->Seq = Seq;
+    frame->Len = MessageLen;
+    frame->Offset = 0;
+    memcpy(frame->Data, Proto_Rx_Buffer, MessageLen);
+    frame->Stamp = SysTick_currentTick();
+    RING_STORE_RELEASE(&Proto_FrameHead, head + 1);
+  }
+  else
+  {
+    Proto_FrameDrops++;
+  }
+
+  return status;
+}
+
+/**
+ * @brief Decode and dispatch stage, handles the frames waiting in the frame queue.
+ *
+ * Runs from the main loop or from the PROTO_DISPATCH_IRQ software interrupt, never from the
+ * USART interrupt, so a long decode or handler cannot delay reception. A frame is only handled
+ * once the Tx queue has room for the largest reply, so pipelined requests wait in the frame
+ * queue, and then in the Rx queue, instead of losing their replies.
+ */
+static void Proto_ProcessFrames(void)
+{
+  uint32_t tail = Proto_FrameTail;
+  uint32_t txFree = 0;
+
+  while ((tail != RING_LOAD_ACQUIRE(&Proto_FrameHead)) &&
+         (HUART_GetTxFree(USART1_ID, &txFree) == Status_enumOk) && (txFree >= PROTOBUFF_COBS_FRAME_MAX_LEN))
+  {
+    ProtoBuf_Frame_t *frame = &Proto_FrameQueue[tail & (PROTOBUFF_FRAME_QUEUE_DEPTH - 1)];
+
+    Proto_StatsAdd(PROTO_STAGE_QUEUE, frame->Stamp);
+    Proto_Dispatch(frame);
+    tail++;
+    RING_STORE_RELEASE(&Proto_FrameTail, tail);
+  }
+}
+
+#if PROTO_DISPATCH_MODE == PROTO_DISPATCH_SWI
+void SPI4_IRQHandler(void)
+{
+  Proto_ProcessFrames();
+}
+#endif
+
+/**
+ * @brief Removes bytes from the front of Proto_Rx_Buffer.
+ *
+ * @param[in,out] RxCount Number of bytes held in the buffer.
+ * @param[in]     Count   Number of bytes to remove.
+ */
+static void Proto_RxDrop(uint32_t *RxCount, uint32_t Count)
+{
+  *RxCount -= Count;
+  memmove(Proto_Rx_Buffer, &Proto_Rx_Buffer[Count], *RxCount);
+}
+
+/**
+ * @brief Tries to decode a frame header from the start of a buffer.
+ *
+ * The wire type in the first header byte selects the framing: fixed32 for Msg_Header,
+ * length-delimited for the compact header, varint for the sequenced header.
+ *
+ * @param[in]  Buffer     Received bytes, Proto_Rx_Buffer or a decoded COBS frame.
+ * @param[in]  RxCount    Number of bytes held in the buffer.
+ * @param[out] Framing    Header format of the frame.
+ * @param[out] HeaderLen  Number of header bytes.
+ * @param[out] MessageID  ID of the message carried in the frame.
+ * @param[out] Seq        Sequence number, 0 unless the frame is sequenced.
+ * @param[out] MessageLen Length of the message body.
+ * @return HEADER_OK, HEADER_INCOMPLETE if more bytes are needed or HEADER_INVALID.
+ */
+static ProtoBuf_Header_Status_t Proto_ParseHeader(const uint8_t *Buffer, uint32_t RxCount, ProtoBuf_Framing_t *Framing, uint32_t *HeaderLen,
+                                                  MessageID_t *MessageID, uint32_t *Seq, uint32_t *MessageLen)
+{
+  ProtoBuf_Header_Status_t result = HEADER_INCOMPLETE;
+  bool status = false;
+
+  switch (Buffer[0] & 0x07)
+  {
+  case PB_WT_STRING:
+    *Framing = FRAMING_COMPACT;
+    break;
+  case PB_WT_VARINT:
+    *Framing = FRAMING_SEQUENCED;
     break;
+  default:
+    *Framing = FRAMING_LEGACY;
+    break;
+  }
+  *Seq = 0;
+
+  if (*Framing != FRAMING_LEGACY)
+  {
+    /* Tag and length, plus the sequence number in between for the sequenced header */
+    uint8_t needed = (*Framing == FRAMING_SEQUENCED) ? 3 : 2;
+    uint8_t varints = 0;
+
+    /* The header ends with the byte terminating its last varint */
+    *HeaderLen = 0;
+    for (uint32_t i = 0; (i < RxCount) && (varints < needed); i++)
+    {
+      varints += ((Buffer[i] & 0x80) == 0);
+      *HeaderLen = i + 1;
+    }
+    if (varints == needed)
+    {
+      pb_istream_t instream = pb_istream_from_buffer(Buffer, *HeaderLen);
+      pb_wire_type_t wireType;
+      uint32_t tag = 0;
+      bool eof = false;
+
+      status = pb_decode_tag(&instream, &wireType, &tag, &eof) && (tag != 0) &&
+               ((*Framing != FRAMING_SEQUENCED) || pb_decode_varint32(&instream, Seq)) &&
+               pb_decode_varint32(&instream, MessageLen);
+      *MessageID = (MessageID_t)(tag - 1);
+      result = HEADER_INVALID;
+    }
+    else if (RxCount >= PROTOBUFF_COMPACT_HEADER_MAX_LEN)
+    {
+      result = HEADER_INVALID;
+    }
   }
-  case MSG_RECEIVE_STATE:
+  else if (RxCount >= PROTOBUFF_HEADER_LEN)
   {
     /* Allocate space for the decoded message. */
+    Msg_Header HeaderMsg = Msg_Header_init_zero;
+
+    /* Create a stream that reads from the buffer. */
+    pb_istream_t instream = pb_istream_from_buffer(Buffer, PROTOBUFF_HEADER_LEN);
+
+    status = pb_decode(&instream, Msg_Header_fields, &HeaderMsg);
+    /* Update the next message length and ID*/
+    *HeaderLen = PROTOBUFF_HEADER_LEN;
+    *MessageID = HeaderMsg.msg_ID;
+    *MessageLen = HeaderMsg.msg_len;
+    result = HEADER_INVALID;
+  }
 
-    void * dest_struct = 0;
-    const pb_msgdesc_t* msg_fields = 0;
-    switch(MessageID)
+  /* No request is longer than PROTOBUFF_RX_BUFFER_LEN, the length of anything else is garbage */
+  if ((result == HEADER_INVALID) && status && (*MessageLen <= PROTOBUFF_RX_BUFFER_LEN))
+  {
+    result = HEADER_OK;
+  }
+
+  return result;
+}
+
+/**
+ * @brief Points the COBS decoder at the next free slot of the frame queue.
+ *
+ * A full queue leaves the decoder no room, the frame is then counted in Proto_CobsErrors.
+ */
+static void Proto_CobsStart(void)
+{
+  uint32_t head = Proto_FrameHead;
+  ProtoBuf_Frame_t *frame = &Proto_FrameQueue[head & (PROTOBUFF_FRAME_QUEUE_DEPTH - 1)];
+  bool room = (head - RING_LOAD_ACQUIRE(&Proto_FrameTail)) < PROTOBUFF_FRAME_QUEUE_DEPTH;
+
+  Cobs_DecoderStart(&Proto_CobsDecoder, frame->Data, room ? sizeof(frame->Data) : 0);
+}
+
+/**
+ * @brief Queues the COBS frame decoded in place in the next free slot of the frame queue.
+ *
+ * The decoded frame must be exactly one header and the body it announces, optionally followed
+ * by a CRC trailer. The trailer is checked by the dispatch stage, owner of the CRC unit.
+ *
+ * @return false if the frame is not a valid one.
+ */
+static bool Proto_CobsPublish(void)
+{
+  uint32_t head = Proto_FrameHead;
+  ProtoBuf_Frame_t *frame = &Proto_FrameQueue[head & (PROTOBUFF_FRAME_QUEUE_DEPTH - 1)];
+  ProtoBuf_Framing_t Framing = FRAMING_LEGACY;
+  MessageID_t MessageID = 0;
+  uint32_t headerLen = 0;
+  uint32_t Seq = 0;
+  uint32_t MessageLen = 0;
+  bool status = (Proto_ParseHeader(frame->Data, Proto_CobsDecoder.Len, &Framing, &headerLen,
+                                   &MessageID, &Seq, &MessageLen) == HEADER_OK);
+  bool crc = status && ((headerLen + MessageLen + PROTOBUFF_CRC_LEN) == Proto_CobsDecoder.Len);
+
+  status = crc || (status && ((headerLen + MessageLen) == Proto_CobsDecoder.Len));
+  if (status)
+  {
+    frame->MessageID = MessageID;
+    frame->Framing = Framing;
+    frame->Cobs = true;
+    frame->Crc = crc;
+    frame->Seq = Seq;
+    frame->Len = MessageLen;
+    frame->Offset = headerLen;
+    frame->Stamp = SysTick_currentTick();
+    RING_STORE_RELEASE(&Proto_FrameHead, head + 1);
+  }
+
+  return status;
+}
+
+/**
+ * @brief Frame parser fed with the bytes read from the Rx queue.
+ *
+ * Bytes are collected into Proto_Rx_Buffer, first the header and then the body length it
+ * announces. The receiver is never re-armed, so a frame may arrive split over several
+ * chunks and a chunk may carry several frames. Complete frames are only queued here,
+ * decoding is left to Proto_ProcessFrames. A body too long for Proto_Rx_Buffer is left in
+ * the Rx queue: parsing stops after its header and Proto_DispatchStream reads it from there.
+ *
+ * A delimiter where a frame should start opens a COBS frame instead, decoded byte by byte
+ * into the frame queue. Every delimiter closes the frame in progress, so a lost or corrupted
+ * byte costs that frame only. Once a valid COBS frame is seen every byte goes through the
+ * decoder, until the link goes idle; before that a bad COBS frame returns to raw framing.
+ *
+ * @param[in] data Received bytes.
+ * @param[in] len  Number of received bytes.
+ * @return Number of bytes parsed, less than len when a streamed frame header ends the parsing.
+ */
+uint32_t Proto_Receive(const uint8_t *data, uint32_t len)
+{
+  static uint8_t state = HEADER_RECEIVE_STATE;
+  static uint32_t RxCount = 0;
+
+  static MessageID_t MessageID = 0;
+  static uint32_t Seq = 0;
+  static uint32_t MessageLen = 0;
+  static ProtoBuf_Framing_t Framing = FRAMING_LEGACY;
+  uint32_t i = 0;
+
+  for (i = 0; (i < len) && !Proto_RxStream.Pending; i++)
+  {
+    bool progress = true;
+
+    if (state == COBS_RECEIVE_STATE)
     {
-      case MSG_RESETPIN_ID:
-        dest_struct = &ResetPinMsg;
-        msg_fields = Msg_ResetPin_fields;
+      bool valid = true;
+
+      switch (Cobs_DecodeByte(&Proto_CobsDecoder, data[i]))
+      {
+      case COBS_DECODE_FRAME:
+        valid = Proto_CobsPublish();
+        Proto_LinkCobs = Proto_LinkCobs || valid;
+        Proto_CobsStart();
+        break;
+      case COBS_DECODE_ERROR:
+        valid = false;
         break;
-      case MSG_READPIN_ID:
-        dest_struct = &ReadPinMsg;
-        msg_fields = Msg_ReadPin_fields;      
-      break;
-      case MSG_SETPIN_ID:
-        dest_struct = &SetPinMsg;
-        msg_fields = Msg_SetPin_fields;      
-      break;
-      case MSG_TOGGLEPIN_ID:
-        dest_struct = &TogglePinMsg;
-        msg_fields = Msg_TogglePin_fields;      
-      break;
       default:
-      break;
-    }
+        break;
+      }
 
-    if(dest_struct != 0)
+      if (valid == false)
+      {
+        Proto_CobsErrors++;
+        /* A stray delimiter in a raw stream, the rest of it is parsed as raw frames */
+        if (Proto_LinkCobs == false)
+        {
+          state = HEADER_RECEIVE_STATE;
+        }
+      }
+      continue;
+    }
+    if ((state == HEADER_RECEIVE_STATE) && (RxCount == 0) && (data[i] == COBS_DELIMITER))
     {
-      /* Create a stream that reads from the buffer. */
-      pb_istream_t instream;
-      instream = pb_istream_from_buffer(Proto_Rx_Buffer, MessageLen);
+      state = COBS_RECEIVE_STATE;
+      Proto_CobsStart();
+      continue;
+    }
 
-      /* Now we are ready to decode the message. */
-      bool status = false;
+    Proto_Rx_Buffer[RxCount++] = data[i];
 
-      status = pb_decode(&instream, msg_fields, dest_struct);
+    while (progress)
+    {
+      progress = false;
 
-      /* Check for errors... */
-      if (status)
+      switch (state)
       {
-        /* Call message handler */
-        messageHandlers[MessageID]();
-        HUART_RxReq.Buff_Len = PROTOBUFF_HEADER_LEN;
-        HUART_ReceiveBuffAsync(&HUART_RxReq);
-
-      }   
+      case HEADER_RECEIVE_STATE:
+      {
+        uint32_t headerLen = 0;
+
+        switch (Proto_ParseHeader(Proto_Rx_Buffer, RxCount, &Framing, &headerLen, &MessageID, &Seq, &MessageLen))
+        {
+        case HEADER_OK:
+          Proto_RxDrop(&RxCount, headerLen);
+          state = MSG_RECEIVE_STATE;
+          progress = true;
+          break;
+        case HEADER_INVALID:
+          /* Not a header, drop the oldest byte and resynchronize on the next one */
+          Proto_RxDrop(&RxCount, 1);
+          progress = true;
+          break;
+        default:
+          break;
+        }
+        break;
+      }
+      case MSG_RECEIVE_STATE:
+      {
+        if (MessageLen > sizeof(Proto_Rx_Buffer))
+        {
+          /* Bytes after the header are the start of the body */
+          Proto_RxStream.MessageID = MessageID;
+          Proto_RxStream.Framing = Framing;
+          Proto_RxStream.Seq = Seq;
+          Proto_RxStream.Len = MessageLen;
+          Proto_RxStream.Staged = RxCount;
+          Proto_RxStream.StagedRead = 0;
+          Proto_RxStream.Read = 0;
+          Proto_RxStream.TimedOut = false;
+          Proto_RxStream.Pending = true;
+          RxCount = 0;
+          state = HEADER_RECEIVE_STATE;
+        }
+        else if (RxCount >= MessageLen)
+        {
+          Proto_EnqueueFrame(MessageID, Framing, Seq, MessageLen);
+          Proto_RxDrop(&RxCount, MessageLen);
+          state = HEADER_RECEIVE_STATE;
+          progress = true;
+        }
+        break;
+      }
+      default:
+        break;
+      }
     }
-    state = 0;
-  }
-    break;
   }
+
+  return i;
 }
 
 
-void on_UART_Receive(void)
+/**
+ * @brief Link speed stage of the main loop, switches USART1 to a new rate and back.
+ *
+ * A pending rate is applied once its ack has fully left the shift register, until then
+ * HUART_SetBaudRate reports busy and the switch is retried on the next call. Away from
+ * LINK_DEFAULT_BAUD_RATE, LINK_IDLE_TIMEOUT_MS without a valid frame returns the link to it,
+ * so a host that lost the new rate, or was restarted, finds the board at the default rate.
+ * The same timeout lets a raw framing host follow a COBS one.
+ */
+static void Link_Poll(void)
 {
-  Proto_Receive();
-}
+  uint32_t pending = Link_PendingBaudRate;
+  bool idle = false;
+
+  /* Called once per main loop pass, and counted by Proto_RxStreamRead while a streamed frame holds
+   * the main loop, so no SysTick wrap is missed */
+  Proto_TickCount(&Link_LastTick, &Link_IdleTicks);
+  if (Link_Traffic)
+  {
+    Link_Traffic = false;
+    Link_IdleTicks = 0;
+  }
+
+  idle = (Link_IdleTicks / (RCC_Get_AHB_Frequency() / 1000) >= LINK_IDLE_TIMEOUT_MS);
+  if (idle)
+  {
+    Proto_LinkCobs = false;
+  }
 
+  if ((pending == 0) && (Link_BaudRate != LINK_DEFAULT_BAUD_RATE) && idle)
+  {
+    pending = LINK_DEFAULT_BAUD_RATE;
+  }
+
+  if (pending != 0)
+  {
+    Error_enumStatus_t status = HUART_SetBaudRate(USART1_ID, pending);
+
+    if (status != Status_enumBusyState)
+    {
+      /* A refused rate leaves USART1 as it was */
+      if (status == Status_enumOk)
+      {
+        Link_BaudRate = pending;
+      }
+      /* A rate requested in the meantime stays pending */
+      __atomic_compare_exchange_n(&Link_PendingBaudRate, &pending, 0, false, __ATOMIC_RELAXED, __ATOMIC_RELAXED);
+      Link_IdleTicks = 0;
+    }
+  }
+}
 
 int main(void)
 {
+  /* 84 MHz from the PLL, every driver below derives its timing from the resulting bus clocks */
+  Init_System_Clock();
+
   /* Enable clock for GPIOA */
   Set_Clock_ON(GPIOA);
   Set_Clock_ON(GPIOB);
   Set_Clock_ON(USART1);
+  /* USART1 Tx/Rx DMA streams live on DMA2 */
+  Set_Clock_ON(DMA2);
+  /* CRC unit for the frame checks */
+  Set_Clock_ON(CRC);
 
   /* Init Pins */
   /* Input pins*/
@@ -318,18 +1421,30 @@ int main(void)
     GPIO_initPin(&pin);
   }  
 
-  /* Initialize hardware UART */
-  HUART_Init();
+  /* Cycle counter of the PROFILE_ probes, a no-op unless built with PROFILE_ENABLE */
+  Profile_Init();
 
-  HUART_RxReq = (HUSART_UserReq_t){
-      .USART_ID = USART1_ID,
-      .Ptr_buffer = Proto_Rx_Buffer,
-      .Buff_Len = PROTOBUFF_HEADER_LEN,
-      .Buff_cb = on_UART_Receive,
+  /* Free running SysTick at the AHB clock for the latency counters */
+  SysTick_Config_t TickConfig =
+  {
+      .ClockSource = SYSTICK_CLK_AHB,
+      .ExceptionState = SYSTICK_EXCEPTION_DISABLED,
+      .CallbackFunction = 0,
   };
+  SysTick_init(&TickConfig);
+  SysTick_startTickCounter(PROTO_TICK_MASK);
+
+#if PROTO_DISPATCH_MODE == PROTO_DISPATCH_SWI
+  /* Decode stage runs below every other interrupt */
+  Set_Interrupt_Priority(PROTO_DISPATCH_IRQ, PROTO_DISPATCH_IRQ_PRIORITY, 0, PRIORITY_GROUP0);
+  Enable_NVIC_IRQ(PROTO_DISPATCH_IRQ);
+#endif
 
+  /* Initialize hardware UART */
+  HUART_Init();
 
-  HUART_ReceiveBuffAsync(&HUART_RxReq);
+  /* Receive continuously into the USART1 Rx queue */
+  HUART_StartRxQueue(USART1_ID);
     HUSART_UserReq_t HUART_TxReq =
     {
         .USART_ID = USART1_ID,
@@ -344,7 +1459,52 @@ int main(void)
   // Main loop
   while (1)
   {
-    // Main application code
+    uint8_t *RxChunk = 0;
+    uint32_t RxLen = 0;
+    uint32_t TxFree = 0;
+
+    /* Frames are assembled here, outside the receive interrupt, straight from the Rx queue.
+     * Bytes stay in the Rx queue while the dispatch stage is held back by a full Tx queue */
+    if (Proto_FrameHead == RING_LOAD_ACQUIRE(&Proto_FrameTail))
+    {
+      if (!Proto_RxStream.Pending)
+      {
+        HUART_PeekRxQueue(USART1_ID, &RxChunk, &RxLen);
+      }
+      /* Frames before it are handled, a streamed frame is decoded once its reply has room */
+      else if ((HUART_GetTxFree(USART1_ID, &TxFree) == Status_enumOk) && (TxFree >= PROTOBUFF_COBS_FRAME_MAX_LEN))
+      {
+        Proto_DispatchStream();
+      }
+    }
+    if (RxLen != 0)
+    {
+      uint32_t start = SysTick_currentTick();
+      PROFILE_BEGIN(receiveStart);
+
+      /* Dispatch between chunks keeps room in the frame queue */
+      if (RxLen > PROTOBUFF_RX_CHUNK_LEN)
+      {
+        RxLen = PROTOBUFF_RX_CHUNK_LEN;
+      }
+      RxLen = Proto_Receive(RxChunk, RxLen);
+      HUART_ConsumeRxQueue(USART1_ID, RxLen);
+      PROFILE_END(PROFILE_PROBE_PROTO_RECEIVE, receiveStart);
+      Proto_StatsAdd(PROTO_STAGE_FRAMING, start);
+    }
+
+    /* Queued frames are decoded and handled by the dispatch stage */
+#if PROTO_DISPATCH_MODE == PROTO_DISPATCH_SWI
+    if (Proto_FrameTail != RING_LOAD_ACQUIRE(&Proto_FrameHead))
+    {
+      SET_Software_Interrupt(PROTO_DISPATCH_IRQ);
+    }
+#else
+    Proto_ProcessFrames();
+#endif
+
+    /* Rate changes requested with Msg_SetLinkSpeed and the idle fallback */
+    Link_Poll();
   }
 
 }
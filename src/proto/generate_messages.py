@@ -0,0 +1,67 @@
+import filecmp
+import os
+import shutil
+import subprocess
+import sys
+import tempfile
+
+Import('env')
+
+# PlatformIO pre script: runs the nanopb_generator.py of the Nanopb package of lib_deps on
+# message.proto and message.options and stops the build when its output differs from the checked-in
+# message.pb.h and message.pb.c, then regenerates message.services.h with services_generator.py.
+# A plain build never rewrites the nanopb files. Never edit them by hand, edit the .proto or .options
+# file and build once with NANOPB_REGENERATE=1 to write the new output, then commit it.
+
+Proto_Dir = os.path.join(env.subst('$PROJECT_DIR'), 'src', 'proto')
+Proto_Name = 'message'
+
+def find_generator():
+    # NANOPB_GENERATOR overrides the generator of the Nanopb package
+    Generator = os.environ.get('NANOPB_GENERATOR')
+    if Generator:
+        return Generator
+    Libdeps_Dir = env.subst('$PROJECT_LIBDEPS_DIR/$PIOENV')
+    for Package in sorted(os.listdir(Libdeps_Dir)) if os.path.isdir(Libdeps_Dir) else []:
+        Generator = os.path.join(Libdeps_Dir, Package, 'generator', 'nanopb_generator.py')
+        if Package.lower().startswith('nanopb') and os.path.isfile(Generator):
+            return Generator
+    sys.exit("generate_messages: nanopb_generator.py not found, install the Nanopb lib_deps or set NANOPB_GENERATOR")
+
+def ensure_generator_deps():
+    # The generator needs the protobuf runtime and, without a protoc on the PATH, grpcio-tools
+    try:
+        import google.protobuf
+        import grpc_tools
+    except ImportError:
+        sys.exit("generate_messages: the nanopb generator needs the protobuf and grpcio-tools packages, "
+                 "install them with: pip install protobuf grpcio-tools")
+
+def run(Args):
+    Result = subprocess.run([env.subst('$PYTHONEXE')] + Args, cwd=Proto_Dir)
+    if Result.returncode != 0:
+        sys.exit(f"generate_messages: {os.path.basename(Args[0])} failed")
+
+def generate_nanopb():
+    ensure_generator_deps()
+    Regenerate = os.environ.get('NANOPB_REGENERATE') == '1'
+    Stale = []
+    with tempfile.TemporaryDirectory() as Out_Dir:
+        run([find_generator(), '-I', '.', '-D', Out_Dir, '-f', f'{Proto_Name}.options', f'{Proto_Name}.proto'])
+        for Suffix in ('.pb.h', '.pb.c'):
+            Generated = os.path.join(Out_Dir, Proto_Name + Suffix)
+            Checked_In = os.path.join(Proto_Dir, Proto_Name + Suffix)
+            if os.path.exists(Checked_In) and filecmp.cmp(Generated, Checked_In, shallow=False):
+                continue
+            Name = os.path.relpath(Checked_In, env.subst('$PROJECT_DIR'))
+            if Regenerate:
+                print(f"Writing {Name}")
+                shutil.copyfile(Generated, Checked_In)
+            else:
+                Stale.append(Name)
+    if Stale:
+        sys.exit(f"generate_messages: {', '.join(Stale)} out of date with {Proto_Name}.proto and "
+                 f"{Proto_Name}.options, rebuild once with NANOPB_REGENERATE=1 and commit the result")
+
+generate_nanopb()
+run([os.path.join(Proto_Dir, 'services_generator.py'), f'{Proto_Name}.services'])
@@ -24,4 +24,37 @@ PB_BIND(Msg_TogglePin, Msg_TogglePin, AUTO)
 PB_BIND(Msg_Header, Msg_Header, AUTO)
 
 
+PB_BIND(Msg_BatchOp, Msg_BatchOp, AUTO)
+
+
+PB_BIND(Msg_Batch, Msg_Batch, AUTO)
+
+
+PB_BIND(Msg_BatchResult, Msg_BatchResult, AUTO)
+
+
+PB_BIND(Msg_WritePort, Msg_WritePort, AUTO)
+
+
+PB_BIND(Msg_ReadPort, Msg_ReadPort, AUTO)
+
+
+PB_BIND(Msg_PortValue, Msg_PortValue, AUTO)
+
+
+PB_BIND(Msg_GetProfile, Msg_GetProfile, AUTO)
+
+
+PB_BIND(Msg_ProbeStats, Msg_ProbeStats, AUTO)
+
+
+PB_BIND(Msg_ProfileReport, Msg_ProfileReport, 2)
+
+
+PB_BIND(Msg_SetLinkSpeed, Msg_SetLinkSpeed, AUTO)
+
+
+PB_BIND(Msg_LinkSpeedAck, Msg_LinkSpeedAck, AUTO)
+
+
 
@@ -9,31 +9,66 @@
 #error Regenerate this file with the current version of nanopb generator.
 #endif
 
+/* Enum definitions */
+/* Same values as GPIO_Port_t, GPIO_Pin_t and GPIO_PinState_t of the firmware */
+typedef enum _Gpio_Port {
+    Gpio_Port_PORT_A = 0,
+    Gpio_Port_PORT_B = 1,
+    Gpio_Port_PORT_C = 2,
+    Gpio_Port_PORT_D = 3,
+    Gpio_Port_PORT_E = 4,
+    Gpio_Port_PORT_H = 5
+} pb_packed Gpio_Port;
+
+typedef enum _Gpio_Pin {
+    Gpio_Pin_PIN_0 = 0,
+    Gpio_Pin_PIN_1 = 1,
+    Gpio_Pin_PIN_2 = 2,
+    Gpio_Pin_PIN_3 = 3,
+    Gpio_Pin_PIN_4 = 4,
+    Gpio_Pin_PIN_5 = 5,
+    Gpio_Pin_PIN_6 = 6,
+    Gpio_Pin_PIN_7 = 7,
+    Gpio_Pin_PIN_8 = 8,
+    Gpio_Pin_PIN_9 = 9,
+    Gpio_Pin_PIN_10 = 10,
+    Gpio_Pin_PIN_11 = 11,
+    Gpio_Pin_PIN_12 = 12,
+    Gpio_Pin_PIN_13 = 13,
+    Gpio_Pin_PIN_14 = 14,
+    Gpio_Pin_PIN_15 = 15
+} pb_packed Gpio_Pin;
+
+typedef enum _Gpio_PinState {
+    Gpio_PinState_STATE_LOW = 0,
+    Gpio_PinState_STATE_HIGH = 1
+} pb_packed Gpio_PinState;
+
 /* Struct definitions */
 typedef struct _Msg_ResetPin {
-    uint32_t Pin_Port;
-    uint32_t Pin_Num;
+    Gpio_Port Pin_Port;
+    Gpio_Pin Pin_Num;
 } Msg_ResetPin;
 
 typedef struct _Msg_ReadPin {
-    uint32_t Pin_Port;
-    uint32_t Pin_Num;
+    Gpio_Port Pin_Port;
+    Gpio_Pin Pin_Num;
 } Msg_ReadPin;
 
 typedef struct _Msg_PinValue {
-    uint32_t Pin_Port;
-    uint32_t Pin_Num;
-    uint32_t Pin_Read;
+    Gpio_Port Pin_Port;
+    Gpio_Pin Pin_Num;
+    Gpio_PinState Pin_Read;
 } Msg_PinValue;
 
 typedef struct _Msg_SetPin {
-    uint32_t Pin_Port;
-    uint32_t Pin_Num;
+    Gpio_Port Pin_Port;
+    Gpio_Pin Pin_Num;
 } Msg_SetPin;
 
 typedef struct _Msg_TogglePin {
-    uint32_t Pin_Port;
-    uint32_t Pin_Num;
+    Gpio_Port Pin_Port;
+    Gpio_Pin Pin_Num;
 } Msg_TogglePin;
 
 typedef struct _Msg_Header {
@@ -41,24 +76,154 @@ typedef struct _Msg_Header {
     uint32_t msg_len;
 } Msg_Header;
 
+typedef struct _Msg_BatchOp {
+    pb_size_t which_Op;
+    union {
+        Msg_SetPin Set_Pin;
+        Msg_ResetPin Reset_Pin;
+        Msg_TogglePin Toggle_Pin;
+        Msg_ReadPin Read_Pin;
+    } Op;
+} Msg_BatchOp;
+
+typedef struct _Msg_Batch {
+    pb_callback_t Ops;
+} Msg_Batch;
+
+typedef struct _Msg_BatchResult {
+    uint8_t Ops_Done;
+    pb_size_t Reads_count;
+    Msg_PinValue Reads[16];
+} Msg_BatchResult;
+
+typedef struct _Msg_WritePort {
+    Gpio_Port Port;
+    uint16_t Set_Mask;
+    uint16_t Reset_Mask;
+} Msg_WritePort;
+
+typedef struct _Msg_ReadPort {
+    Gpio_Port Port;
+} Msg_ReadPort;
+
+typedef struct _Msg_PortValue {
+    Gpio_Port Port;
+    uint16_t Value;
+} Msg_PortValue;
+
+typedef struct _Msg_GetProfile {
+    bool Reset;
+} Msg_GetProfile;
+
+typedef struct _Msg_ProbeStats {
+    uint32_t Probe;
+    uint32_t Count;
+    uint32_t Min;
+    uint32_t Max;
+    uint32_t Mean;
+} Msg_ProbeStats;
+
+typedef struct _Msg_ProfileReport {
+    uint32_t Core_Clock;
+    pb_size_t Probes_count;
+    Msg_ProbeStats Probes[24];
+} Msg_ProfileReport;
+
+typedef struct _Msg_SetLinkSpeed {
+    uint32_t Baud_Rate;
+} Msg_SetLinkSpeed;
+
+typedef struct _Msg_LinkSpeedAck {
+    bool Accepted;
+    uint32_t Baud_Rate;
+    int32_t Error_PPM;
+} Msg_LinkSpeedAck;
+
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/* Helper constants for enums */
+#define _Gpio_Port_MIN Gpio_Port_PORT_A
+#define _Gpio_Port_MAX Gpio_Port_PORT_H
+#define _Gpio_Port_ARRAYSIZE ((Gpio_Port)(Gpio_Port_PORT_H+1))
+
+#define _Gpio_Pin_MIN Gpio_Pin_PIN_0
+#define _Gpio_Pin_MAX Gpio_Pin_PIN_15
+#define _Gpio_Pin_ARRAYSIZE ((Gpio_Pin)(Gpio_Pin_PIN_15+1))
+
+#define _Gpio_PinState_MIN Gpio_PinState_STATE_LOW
+#define _Gpio_PinState_MAX Gpio_PinState_STATE_HIGH
+#define _Gpio_PinState_ARRAYSIZE ((Gpio_PinState)(Gpio_PinState_STATE_HIGH+1))
+
+#define Msg_ResetPin_Pin_Port_ENUMTYPE Gpio_Port
+#define Msg_ResetPin_Pin_Num_ENUMTYPE Gpio_Pin
+
+#define Msg_ReadPin_Pin_Port_ENUMTYPE Gpio_Port
+#define Msg_ReadPin_Pin_Num_ENUMTYPE Gpio_Pin
+
+#define Msg_PinValue_Pin_Port_ENUMTYPE Gpio_Port
+#define Msg_PinValue_Pin_Num_ENUMTYPE Gpio_Pin
+#define Msg_PinValue_Pin_Read_ENUMTYPE Gpio_PinState
+
+#define Msg_SetPin_Pin_Port_ENUMTYPE Gpio_Port
+#define Msg_SetPin_Pin_Num_ENUMTYPE Gpio_Pin
+
+#define Msg_TogglePin_Pin_Port_ENUMTYPE Gpio_Port
+#define Msg_TogglePin_Pin_Num_ENUMTYPE Gpio_Pin
+
+
+
+
+
+#define Msg_WritePort_Port_ENUMTYPE Gpio_Port
+
+#define Msg_ReadPort_Port_ENUMTYPE Gpio_Port
+
+#define Msg_PortValue_Port_ENUMTYPE Gpio_Port
+
+
+
+
+
+
+
 /* Initializer values for message structs */
-#define Msg_ResetPin_init_default                {0, 0}
-#define Msg_ReadPin_init_default                 {0, 0}
-#define Msg_PinValue_init_default                {0, 0, 0}
-#define Msg_SetPin_init_default                  {0, 0}
-#define Msg_TogglePin_init_default               {0, 0}
+#define Msg_ResetPin_init_default                {_Gpio_Port_MIN, _Gpio_Pin_MIN}
+#define Msg_ReadPin_init_default                 {_Gpio_Port_MIN, _Gpio_Pin_MIN}
+#define Msg_PinValue_init_default                {_Gpio_Port_MIN, _Gpio_Pin_MIN, _Gpio_PinState_MIN}
+#define Msg_SetPin_init_default                  {_Gpio_Port_MIN, _Gpio_Pin_MIN}
+#define Msg_TogglePin_init_default               {_Gpio_Port_MIN, _Gpio_Pin_MIN}
 #define Msg_Header_init_default                  {0, 0}
-#define Msg_ResetPin_init_zero                   {0, 0}
-#define Msg_ReadPin_init_zero                    {0, 0}
-#define Msg_PinValue_init_zero                   {0, 0, 0}
-#define Msg_SetPin_init_zero                     {0, 0}
-#define Msg_TogglePin_init_zero                  {0, 0}
+#define Msg_BatchOp_init_default                 {0, {Msg_SetPin_init_default}}
+#define Msg_Batch_init_default                   {{{NULL}, NULL}}
+#define Msg_BatchResult_init_default             {0, 0, {Msg_PinValue_init_default, Msg_PinValue_init_default, Msg_PinValue_init_default, Msg_PinValue_init_default, Msg_PinValue_init_default, Msg_PinValue_init_default, Msg_PinValue_init_default, Msg_PinValue_init_default, Msg_PinValue_init_default, Msg_PinValue_init_default, Msg_PinValue_init_default, Msg_PinValue_init_default, Msg_PinValue_init_default, Msg_PinValue_init_default, Msg_PinValue_init_default, Msg_PinValue_init_default}}
+#define Msg_WritePort_init_default               {_Gpio_Port_MIN, 0, 0}
+#define Msg_ReadPort_init_default                {_Gpio_Port_MIN}
+#define Msg_PortValue_init_default               {_Gpio_Port_MIN, 0}
+#define Msg_GetProfile_init_default              {0}
+#define Msg_ProbeStats_init_default              {0, 0, 0, 0, 0}
+#define Msg_ProfileReport_init_default           {0, 0, {Msg_ProbeStats_init_default, Msg_ProbeStats_init_default, Msg_ProbeStats_init_default, Msg_ProbeStats_init_default, Msg_ProbeStats_init_default, Msg_ProbeStats_init_default, Msg_ProbeStats_init_default, Msg_ProbeStats_init_default, Msg_ProbeStats_init_default, Msg_ProbeStats_init_default, Msg_ProbeStats_init_default, Msg_ProbeStats_init_default, Msg_ProbeStats_init_default, Msg_ProbeStats_init_default, Msg_ProbeStats_init_default, Msg_ProbeStats_init_default, Msg_ProbeStats_init_default, Msg_ProbeStats_init_default, Msg_ProbeStats_init_default, Msg_ProbeStats_init_default, Msg_ProbeStats_init_default, Msg_ProbeStats_init_default, Msg_ProbeStats_init_default, Msg_ProbeStats_init_default}}
+#define Msg_SetLinkSpeed_init_default            {0}
+#define Msg_LinkSpeedAck_init_default            {0, 0, 0}
+#define Msg_ResetPin_init_zero                   {_Gpio_Port_MIN, _Gpio_Pin_MIN}
+#define Msg_ReadPin_init_zero                    {_Gpio_Port_MIN, _Gpio_Pin_MIN}
+#define Msg_PinValue_init_zero                   {_Gpio_Port_MIN, _Gpio_Pin_MIN, _Gpio_PinState_MIN}
+#define Msg_SetPin_init_zero                     {_Gpio_Port_MIN, _Gpio_Pin_MIN}
+#define Msg_TogglePin_init_zero                  {_Gpio_Port_MIN, _Gpio_Pin_MIN}
 #define Msg_Header_init_zero                     {0, 0}
+#define Msg_BatchOp_init_zero                    {0, {Msg_SetPin_init_zero}}
+#define Msg_Batch_init_zero                      {{{NULL}, NULL}}
+#define Msg_BatchResult_init_zero                {0, 0, {Msg_PinValue_init_zero, Msg_PinValue_init_zero, Msg_PinValue_init_zero, Msg_PinValue_init_zero, Msg_PinValue_init_zero, Msg_PinValue_init_zero, Msg_PinValue_init_zero, Msg_PinValue_init_zero, Msg_PinValue_init_zero, Msg_PinValue_init_zero, Msg_PinValue_init_zero, Msg_PinValue_init_zero, Msg_PinValue_init_zero, Msg_PinValue_init_zero, Msg_PinValue_init_zero, Msg_PinValue_init_zero}}
+#define Msg_WritePort_init_zero                  {_Gpio_Port_MIN, 0, 0}
+#define Msg_ReadPort_init_zero                   {_Gpio_Port_MIN}
+#define Msg_PortValue_init_zero                  {_Gpio_Port_MIN, 0}
+#define Msg_GetProfile_init_zero                 {0}
+#define Msg_ProbeStats_init_zero                 {0, 0, 0, 0, 0}
+#define Msg_ProfileReport_init_zero              {0, 0, {Msg_ProbeStats_init_zero, Msg_ProbeStats_init_zero, Msg_ProbeStats_init_zero, Msg_ProbeStats_init_zero, Msg_ProbeStats_init_zero, Msg_ProbeStats_init_zero, Msg_ProbeStats_init_zero, Msg_ProbeStats_init_zero, Msg_ProbeStats_init_zero, Msg_ProbeStats_init_zero, Msg_ProbeStats_init_zero, Msg_ProbeStats_init_zero, Msg_ProbeStats_init_zero, Msg_ProbeStats_init_zero, Msg_ProbeStats_init_zero, Msg_ProbeStats_init_zero, Msg_ProbeStats_init_zero, Msg_ProbeStats_init_zero, Msg_ProbeStats_init_zero, Msg_ProbeStats_init_zero, Msg_ProbeStats_init_zero, Msg_ProbeStats_init_zero, Msg_ProbeStats_init_zero, Msg_ProbeStats_init_zero}}
+#define Msg_SetLinkSpeed_init_zero               {0}
+#define Msg_LinkSpeedAck_init_zero               {0, 0, 0}
 
 /* Field tags (for use in manual encoding/decoding) */
 #define Msg_ResetPin_Pin_Port_tag                1
@@ -74,36 +239,61 @@ extern "C" {
 #define Msg_TogglePin_Pin_Num_tag                2
 #define Msg_Header_msg_ID_tag                    1
 #define Msg_Header_msg_len_tag                   2
+#define Msg_BatchOp_Set_Pin_tag                  1
+#define Msg_BatchOp_Reset_Pin_tag                2
+#define Msg_BatchOp_Toggle_Pin_tag               3
+#define Msg_BatchOp_Read_Pin_tag                 4
+#define Msg_Batch_Ops_tag                        1
+#define Msg_BatchResult_Ops_Done_tag             1
+#define Msg_BatchResult_Reads_tag                2
+#define Msg_WritePort_Port_tag                   1
+#define Msg_WritePort_Set_Mask_tag               2
+#define Msg_WritePort_Reset_Mask_tag             3
+#define Msg_ReadPort_Port_tag                    1
+#define Msg_PortValue_Port_tag                   1
+#define Msg_PortValue_Value_tag                  2
+#define Msg_GetProfile_Reset_tag                 1
+#define Msg_ProbeStats_Probe_tag                 1
+#define Msg_ProbeStats_Count_tag                 2
+#define Msg_ProbeStats_Min_tag                   3
+#define Msg_ProbeStats_Max_tag                   4
+#define Msg_ProbeStats_Mean_tag                  5
+#define Msg_ProfileReport_Core_Clock_tag         1
+#define Msg_ProfileReport_Probes_tag             2
+#define Msg_SetLinkSpeed_Baud_Rate_tag           1
+#define Msg_LinkSpeedAck_Accepted_tag            1
+#define Msg_LinkSpeedAck_Baud_Rate_tag           2
+#define Msg_LinkSpeedAck_Error_PPM_tag           3
 
 /* Struct field encoding specification for nanopb */
 #define Msg_ResetPin_FIELDLIST(X, a) \
-X(a, STATIC,   REQUIRED, UINT32,   Pin_Port,          1) \
-X(a, STATIC,   REQUIRED, UINT32,   Pin_Num,           2)
+X(a, STATIC,   REQUIRED, UENUM,    Pin_Port,          1) \
+X(a, STATIC,   REQUIRED, UENUM,    Pin_Num,           2)
 #define Msg_ResetPin_CALLBACK NULL
 #define Msg_ResetPin_DEFAULT NULL
 
 #define Msg_ReadPin_FIELDLIST(X, a) \
-X(a, STATIC,   REQUIRED, UINT32,   Pin_Port,          1) \
-X(a, STATIC,   REQUIRED, UINT32,   Pin_Num,           2)
+X(a, STATIC,   REQUIRED, UENUM,    Pin_Port,          1) \
+X(a, STATIC,   REQUIRED, UENUM,    Pin_Num,           2)
 #define Msg_ReadPin_CALLBACK NULL
 #define Msg_ReadPin_DEFAULT NULL
 
 #define Msg_PinValue_FIELDLIST(X, a) \
-X(a, STATIC,   REQUIRED, UINT32,   Pin_Port,          1) \
-X(a, STATIC,   REQUIRED, UINT32,   Pin_Num,           2) \
-X(a, STATIC,   REQUIRED, UINT32,   Pin_Read,          3)
+X(a, STATIC,   REQUIRED, UENUM,    Pin_Port,          1) \
+X(a, STATIC,   REQUIRED, UENUM,    Pin_Num,           2) \
+X(a, STATIC,   REQUIRED, UENUM,    Pin_Read,          3)
 #define Msg_PinValue_CALLBACK NULL
 #define Msg_PinValue_DEFAULT NULL
 
 #define Msg_SetPin_FIELDLIST(X, a) \
-X(a, STATIC,   REQUIRED, UINT32,   Pin_Port,          1) \
-X(a, STATIC,   REQUIRED, UINT32,   Pin_Num,           2)
+X(a, STATIC,   REQUIRED, UENUM,    Pin_Port,          1) \
+X(a, STATIC,   REQUIRED, UENUM,    Pin_Num,           2)
 #define Msg_SetPin_CALLBACK NULL
 #define Msg_SetPin_DEFAULT NULL
 
 #define Msg_TogglePin_FIELDLIST(X, a) \
-X(a, STATIC,   REQUIRED, UINT32,   Pin_Port,          1) \
-X(a, STATIC,   REQUIRED, UINT32,   Pin_Num,           2)
+X(a, STATIC,   REQUIRED, UENUM,    Pin_Port,          1) \
+X(a, STATIC,   REQUIRED, UENUM,    Pin_Num,           2)
 #define Msg_TogglePin_CALLBACK NULL
 #define Msg_TogglePin_DEFAULT NULL
 
@@ -113,12 +303,99 @@ X(a, STATIC,   REQUIRED, FIXED32,  msg_len,           2)
 #define Msg_Header_CALLBACK NULL
 #define Msg_Header_DEFAULT NULL
 
+#define Msg_BatchOp_FIELDLIST(X, a) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (Op,Set_Pin,Op.Set_Pin),   1) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (Op,Reset_Pin,Op.Reset_Pin),   2) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (Op,Toggle_Pin,Op.Toggle_Pin),   3) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (Op,Read_Pin,Op.Read_Pin),   4)
+#define Msg_BatchOp_CALLBACK NULL
+#define Msg_BatchOp_DEFAULT NULL
+#define Msg_BatchOp_Op_Set_Pin_MSGTYPE Msg_SetPin
+#define Msg_BatchOp_Op_Reset_Pin_MSGTYPE Msg_ResetPin
+#define Msg_BatchOp_Op_Toggle_Pin_MSGTYPE Msg_TogglePin
+#define Msg_BatchOp_Op_Read_Pin_MSGTYPE Msg_ReadPin
+
+#define Msg_Batch_FIELDLIST(X, a) \
+X(a, CALLBACK, REPEATED, MESSAGE,  Ops,               1)
+#define Msg_Batch_CALLBACK pb_default_field_callback
+#define Msg_Batch_DEFAULT NULL
+#define Msg_Batch_Ops_MSGTYPE Msg_BatchOp
+
+#define Msg_BatchResult_FIELDLIST(X, a) \
+X(a, STATIC,   REQUIRED, UINT32,   Ops_Done,          1) \
+X(a, STATIC,   REPEATED, MESSAGE,  Reads,             2)
+#define Msg_BatchResult_CALLBACK NULL
+#define Msg_BatchResult_DEFAULT NULL
+#define Msg_BatchResult_Reads_MSGTYPE Msg_PinValue
+
+#define Msg_WritePort_FIELDLIST(X, a) \
+X(a, STATIC,   REQUIRED, UENUM,    Port,              1) \
+X(a, STATIC,   REQUIRED, UINT32,   Set_Mask,          2) \
+X(a, STATIC,   REQUIRED, UINT32,   Reset_Mask,        3)
+#define Msg_WritePort_CALLBACK NULL
+#define Msg_WritePort_DEFAULT NULL
+
+#define Msg_ReadPort_FIELDLIST(X, a) \
+X(a, STATIC,   REQUIRED, UENUM,    Port,              1)
+#define Msg_ReadPort_CALLBACK NULL
+#define Msg_ReadPort_DEFAULT NULL
+
+#define Msg_PortValue_FIELDLIST(X, a) \
+X(a, STATIC,   REQUIRED, UENUM,    Port,              1) \
+X(a, STATIC,   REQUIRED, UINT32,   Value,             2)
+#define Msg_PortValue_CALLBACK NULL
+#define Msg_PortValue_DEFAULT NULL
+
+#define Msg_GetProfile_FIELDLIST(X, a) \
+X(a, STATIC,   REQUIRED, BOOL,     Reset,             1)
+#define Msg_GetProfile_CALLBACK NULL
+#define Msg_GetProfile_DEFAULT NULL
+
+#define Msg_ProbeStats_FIELDLIST(X, a) \
+X(a, STATIC,   REQUIRED, UINT32,   Probe,             1) \
+X(a, STATIC,   REQUIRED, UINT32,   Count,             2) \
+X(a, STATIC,   REQUIRED, UINT32,   Min,               3) \
+X(a, STATIC,   REQUIRED, UINT32,   Max,               4) \
+X(a, STATIC,   REQUIRED, UINT32,   Mean,              5)
+#define Msg_ProbeStats_CALLBACK NULL
+#define Msg_ProbeStats_DEFAULT NULL
+
+#define Msg_ProfileReport_FIELDLIST(X, a) \
+X(a, STATIC,   REQUIRED, UINT32,   Core_Clock,        1) \
+X(a, STATIC,   REPEATED, MESSAGE,  Probes,            2)
+#define Msg_ProfileReport_CALLBACK NULL
+#define Msg_ProfileReport_DEFAULT NULL
+#define Msg_ProfileReport_Probes_MSGTYPE Msg_ProbeStats
+
+#define Msg_SetLinkSpeed_FIELDLIST(X, a) \
+X(a, STATIC,   REQUIRED, UINT32,   Baud_Rate,         1)
+#define Msg_SetLinkSpeed_CALLBACK NULL
+#define Msg_SetLinkSpeed_DEFAULT NULL
+
+#define Msg_LinkSpeedAck_FIELDLIST(X, a) \
+X(a, STATIC,   REQUIRED, BOOL,     Accepted,          1) \
+X(a, STATIC,   REQUIRED, UINT32,   Baud_Rate,         2) \
+X(a, STATIC,   REQUIRED, SINT32,   Error_PPM,         3)
+#define Msg_LinkSpeedAck_CALLBACK NULL
+#define Msg_LinkSpeedAck_DEFAULT NULL
+
 extern const pb_msgdesc_t Msg_ResetPin_msg;
 extern const pb_msgdesc_t Msg_ReadPin_msg;
 extern const pb_msgdesc_t Msg_PinValue_msg;
 extern const pb_msgdesc_t Msg_SetPin_msg;
 extern const pb_msgdesc_t Msg_TogglePin_msg;
 extern const pb_msgdesc_t Msg_Header_msg;
+extern const pb_msgdesc_t Msg_BatchOp_msg;
+extern const pb_msgdesc_t Msg_Batch_msg;
+extern const pb_msgdesc_t Msg_BatchResult_msg;
+extern const pb_msgdesc_t Msg_WritePort_msg;
+extern const pb_msgdesc_t Msg_ReadPort_msg;
+extern const pb_msgdesc_t Msg_PortValue_msg;
+extern const pb_msgdesc_t Msg_GetProfile_msg;
+extern const pb_msgdesc_t Msg_ProbeStats_msg;
+extern const pb_msgdesc_t Msg_ProfileReport_msg;
+extern const pb_msgdesc_t Msg_SetLinkSpeed_msg;
+extern const pb_msgdesc_t Msg_LinkSpeedAck_msg;
 
 /* Defines for backwards compatibility with code written before nanopb-0.4.0 */
 #define Msg_ResetPin_fields &Msg_ResetPin_msg
@@ -127,15 +404,37 @@ extern const pb_msgdesc_t Msg_Header_msg;
 #define Msg_SetPin_fields &Msg_SetPin_msg
 #define Msg_TogglePin_fields &Msg_TogglePin_msg
 #define Msg_Header_fields &Msg_Header_msg
+#define Msg_BatchOp_fields &Msg_BatchOp_msg
+#define Msg_Batch_fields &Msg_Batch_msg
+#define Msg_BatchResult_fields &Msg_BatchResult_msg
+#define Msg_WritePort_fields &Msg_WritePort_msg
+#define Msg_ReadPort_fields &Msg_ReadPort_msg
+#define Msg_PortValue_fields &Msg_PortValue_msg
+#define Msg_GetProfile_fields &Msg_GetProfile_msg
+#define Msg_ProbeStats_fields &Msg_ProbeStats_msg
+#define Msg_ProfileReport_fields &Msg_ProfileReport_msg
+#define Msg_SetLinkSpeed_fields &Msg_SetLinkSpeed_msg
+#define Msg_LinkSpeedAck_fields &Msg_LinkSpeedAck_msg
 
 /* Maximum encoded size of messages (where known) */
-#define MESSAGE_PB_H_MAX_SIZE                    Msg_PinValue_size
+/* Msg_Batch_size depends on runtime parameters */
+#define MESSAGE_PB_H_MAX_SIZE                    Msg_ProfileReport_size
+#define Msg_BatchOp_size                         6
+#define Msg_BatchResult_size                     131
+#define Msg_GetProfile_size                      2
 #define Msg_Header_size                          10
-#define Msg_PinValue_size                        18
-#define Msg_ReadPin_size                         12
-#define Msg_ResetPin_size                        12
-#define Msg_SetPin_size                          12
-#define Msg_TogglePin_size                       12
+#define Msg_LinkSpeedAck_size                    14
+#define Msg_PinValue_size                        6
+#define Msg_PortValue_size                       6
+#define Msg_ProbeStats_size                      30
+#define Msg_ProfileReport_size                   774
+#define Msg_ReadPin_size                         4
+#define Msg_ReadPort_size                        2
+#define Msg_ResetPin_size                        4
+#define Msg_SetLinkSpeed_size                    6
+#define Msg_SetPin_size                          4
+#define Msg_TogglePin_size                       4
+#define Msg_WritePort_size                       10
 
 #ifdef __cplusplus
 } /* extern "C" */
@@ -0,0 +1,145 @@
+/* Automatically generated by services_generator.py from message.services, do not edit */
+
+#ifndef MESSAGE_SERVICES_H_INCLUDED
+#define MESSAGE_SERVICES_H_INCLUDED
+#include <pb.h>
+#include "message.pb.h"
+#include "LIB/PbFastCodec.h"
+
+/* Flat messages go through the straight-line codec, build with -D PROTO_FAST_CODEC=0 to send
+ * every message through pb_decode and pb_encode */
+#ifndef PROTO_FAST_CODEC
+#define PROTO_FAST_CODEC 1
+#endif
+
+/* Message IDs carried by the frame header */
+typedef enum
+{
+  MSG_RESETPIN_ID = 0,
+  MSG_READPIN_ID = 1,
+  MSG_SETPIN_ID = 2,
+  MSG_TOGGLEPIN_ID = 3,
+  MSG_PINVALUE_ID = 4,
+  MSG_BATCH_ID = 5,
+  MSG_BATCHRESULT_ID = 6,
+  MSG_WRITEPORT_ID = 7,
+  MSG_READPORT_ID = 8,
+  MSG_PORTVALUE_ID = 9,
+  MSG_GETPROFILE_ID = 10,
+  MSG_PROFILEREPORT_ID = 11,
+  MSG_SETLINKSPEED_ID = 12,
+  MSG_LINKSPEEDACK_ID = 13,
+  MSG_ID_NUM = 14,
+}MessageID_t;
+
+/* Largest encoded body of each message */
+#define MSG_RESETPIN_MAX_SIZE            Msg_ResetPin_size
+#define MSG_READPIN_MAX_SIZE             Msg_ReadPin_size
+#define MSG_SETPIN_MAX_SIZE              Msg_SetPin_size
+#define MSG_TOGGLEPIN_MAX_SIZE           Msg_TogglePin_size
+#define MSG_PINVALUE_MAX_SIZE            Msg_PinValue_size
+#define MSG_BATCH_MAX_SIZE               256
+#define MSG_BATCHRESULT_MAX_SIZE         Msg_BatchResult_size
+#define MSG_WRITEPORT_MAX_SIZE           Msg_WritePort_size
+#define MSG_READPORT_MAX_SIZE            Msg_ReadPort_size
+#define MSG_PORTVALUE_MAX_SIZE           Msg_PortValue_size
+#define MSG_GETPROFILE_MAX_SIZE          Msg_GetProfile_size
+#define MSG_PROFILEREPORT_MAX_SIZE       Msg_ProfileReport_size
+#define MSG_SETLINKSPEED_MAX_SIZE        Msg_SetLinkSpeed_size
+#define MSG_LINKSPEEDACK_MAX_SIZE        Msg_LinkSpeedAck_size
+
+/* Requests, X(Name, MaxSize) with Name the message type without its Msg_ prefix */
+#define PROTO_REQUEST_MESSAGES(X)               \
+  X(ResetPin, MSG_RESETPIN_MAX_SIZE)            \
+  X(ReadPin, MSG_READPIN_MAX_SIZE)              \
+  X(SetPin, MSG_SETPIN_MAX_SIZE)                \
+  X(TogglePin, MSG_TOGGLEPIN_MAX_SIZE)          \
+  X(Batch, MSG_BATCH_MAX_SIZE)                  \
+  X(WritePort, MSG_WRITEPORT_MAX_SIZE)          \
+  X(ReadPort, MSG_READPORT_MAX_SIZE)            \
+  X(GetProfile, MSG_GETPROFILE_MAX_SIZE)        \
+  X(SetLinkSpeed, MSG_SETLINKSPEED_MAX_SIZE)
+
+/* Replies, X(Name, MaxSize) with Name the message type without its Msg_ prefix */
+#define PROTO_REPLY_MESSAGES(X)                 \
+  X(PinValue, MSG_PINVALUE_MAX_SIZE)            \
+  X(BatchResult, MSG_BATCHRESULT_MAX_SIZE)      \
+  X(PortValue, MSG_PORTVALUE_MAX_SIZE)          \
+  X(ProfileReport, MSG_PROFILEREPORT_MAX_SIZE)  \
+  X(LinkSpeedAck, MSG_LINKSPEEDACK_MAX_SIZE)
+
+/* Entry of the service table, the table is indexed by message ID */
+typedef struct
+{
+  uint8_t Id;
+  const pb_msgdesc_t *Fields;
+  void (*Handler)(void);  /* Runs a decoded request, NULL for replies and unused IDs */
+  uint16_t MaxSize;       /* Largest encoded body */
+  /* Straight-line codec of a flat request or reply, NULL for pb_decode and pb_encode */
+  bool (*FastDecode)(const uint8_t *Ptr_Buffer, uint32_t Len, void *Ptr_Msg);
+  uint32_t (*FastEncode)(const void *Ptr_Msg, uint8_t *Ptr_Buffer);
+}Proto_Service_t;
+
+/* Request handlers, defined by the file including this header */
+static void ResetPinHandler(void);
+static void ReadPinHandler(void);
+static void SetPinHandler(void);
+static void TogglePinHandler(void);
+static void BatchHandler(void);
+static void WritePortHandler(void);
+static void ReadPortHandler(void);
+static void GetProfileHandler(void);
+static void SetLinkSpeedHandler(void);
+
+/* Straight-line codec of the flat messages */
+#if PROTO_FAST_CODEC
+PB_FAST_CODEC_DEFINE(Msg_ResetPin)
+PB_FAST_CODEC_DEFINE(Msg_ReadPin)
+PB_FAST_CODEC_DEFINE(Msg_SetPin)
+PB_FAST_CODEC_DEFINE(Msg_TogglePin)
+PB_FAST_CODEC_DEFINE(Msg_PinValue)
+PB_FAST_CODEC_DEFINE(Msg_WritePort)
+PB_FAST_CODEC_DEFINE(Msg_ReadPort)
+PB_FAST_CODEC_DEFINE(Msg_PortValue)
+PB_FAST_CODEC_DEFINE(Msg_GetProfile)
+PB_FAST_CODEC_DEFINE(Msg_SetLinkSpeed)
+PB_FAST_CODEC_DEFINE(Msg_LinkSpeedAck)
+#define PROTO_FAST_CODEC_OF(Function) Function
+#else
+#define PROTO_FAST_CODEC_OF(Function) NULL
+#endif
+
+/* Service table, const so that it stays in flash */
+static const Proto_Service_t Proto_Services[MSG_ID_NUM] =
+{
+  [MSG_RESETPIN_ID] = {MSG_RESETPIN_ID, Msg_ResetPin_fields, ResetPinHandler, MSG_RESETPIN_MAX_SIZE,
+    PROTO_FAST_CODEC_OF(PbFast_Decode_Msg_ResetPin), NULL},
+  [MSG_READPIN_ID] = {MSG_READPIN_ID, Msg_ReadPin_fields, ReadPinHandler, MSG_READPIN_MAX_SIZE,
+    PROTO_FAST_CODEC_OF(PbFast_Decode_Msg_ReadPin), NULL},
+  [MSG_SETPIN_ID] = {MSG_SETPIN_ID, Msg_SetPin_fields, SetPinHandler, MSG_SETPIN_MAX_SIZE,
+    PROTO_FAST_CODEC_OF(PbFast_Decode_Msg_SetPin), NULL},
+  [MSG_TOGGLEPIN_ID] = {MSG_TOGGLEPIN_ID, Msg_TogglePin_fields, TogglePinHandler, MSG_TOGGLEPIN_MAX_SIZE,
+    PROTO_FAST_CODEC_OF(PbFast_Decode_Msg_TogglePin), NULL},
+  [MSG_PINVALUE_ID] = {MSG_PINVALUE_ID, Msg_PinValue_fields, NULL, MSG_PINVALUE_MAX_SIZE,
+    NULL, PROTO_FAST_CODEC_OF(PbFast_Encode_Msg_PinValue)},
+  [MSG_BATCH_ID] = {MSG_BATCH_ID, Msg_Batch_fields, BatchHandler, MSG_BATCH_MAX_SIZE,
+    NULL, NULL},
+  [MSG_BATCHRESULT_ID] = {MSG_BATCHRESULT_ID, Msg_BatchResult_fields, NULL, MSG_BATCHRESULT_MAX_SIZE,
+    NULL, NULL},
+  [MSG_WRITEPORT_ID] = {MSG_WRITEPORT_ID, Msg_WritePort_fields, WritePortHandler, MSG_WRITEPORT_MAX_SIZE,
+    PROTO_FAST_CODEC_OF(PbFast_Decode_Msg_WritePort), NULL},
+  [MSG_READPORT_ID] = {MSG_READPORT_ID, Msg_ReadPort_fields, ReadPortHandler, MSG_READPORT_MAX_SIZE,
+    PROTO_FAST_CODEC_OF(PbFast_Decode_Msg_ReadPort), NULL},
+  [MSG_PORTVALUE_ID] = {MSG_PORTVALUE_ID, Msg_PortValue_fields, NULL, MSG_PORTVALUE_MAX_SIZE,
+    NULL, PROTO_FAST_CODEC_OF(PbFast_Encode_Msg_PortValue)},
+  [MSG_GETPROFILE_ID] = {MSG_GETPROFILE_ID, Msg_GetProfile_fields, GetProfileHandler, MSG_GETPROFILE_MAX_SIZE,
+    PROTO_FAST_CODEC_OF(PbFast_Decode_Msg_GetProfile), NULL},
+  [MSG_PROFILEREPORT_ID] = {MSG_PROFILEREPORT_ID, Msg_ProfileReport_fields, NULL, MSG_PROFILEREPORT_MAX_SIZE,
+    NULL, NULL},
+  [MSG_SETLINKSPEED_ID] = {MSG_SETLINKSPEED_ID, Msg_SetLinkSpeed_fields, SetLinkSpeedHandler, MSG_SETLINKSPEED_MAX_SIZE,
+    PROTO_FAST_CODEC_OF(PbFast_Decode_Msg_SetLinkSpeed), NULL},
+  [MSG_LINKSPEEDACK_ID] = {MSG_LINKSPEEDACK_ID, Msg_LinkSpeedAck_fields, NULL, MSG_LINKSPEEDACK_MAX_SIZE,
+    NULL, PROTO_FAST_CODEC_OF(PbFast_Encode_Msg_LinkSpeedAck)},
+};
+
+#endif /* MESSAGE_SERVICES_H_INCLUDED */
@@ -14,15 +14,51 @@ _sym_db = _symbol_database.Default()
 
 
 
-DESCRIPTOR = _descriptor_pool.Default().AddSerializedFile(b'\n\rmessage.proto\"-\n\nMsg_Header\x12\x0e\n\x06msg_id\x18\x01 \x02(\x07\x12\x0f\n\x07msg_len\x18\x02 \x02(\x07\"+\n\x07\x45xample\x12\x11\n\x06msg_id\x18\x01 \x02(\r:\x01\x30\x12\r\n\x05value\x18\x17 \x02(\r')
+DESCRIPTOR = _descriptor_pool.Default().AddSerializedFile(b'\n\rmessage.proto\"H\n\x0cMsg_ResetPin\x12\x1c\n\x08Pin_Port\x18\x01 \x02(\x0e2\n.Gpio_Port\x12\x1a\n\x07Pin_Num\x18\x02 \x02(\x0e2\t.Gpio_Pin\"G\n\x0bMsg_ReadPin\x12\x1c\n\x08Pin_Port\x18\x01 \x02(\x0e2\n.Gpio_Port\x12\x1a\n\x07Pin_Num\x18\x02 \x02(\x0e2\t.Gpio_Pin\"j\n\x0cMsg_PinValue\x12\x1c\n\x08Pin_Port\x18\x01 \x02(\x0e2\n.Gpio_Port\x12\x1a\n\x07Pin_Num\x18\x02 \x02(\x0e2\t.Gpio_Pin\x12 \n\x08Pin_Read\x18\x03 \x02(\x0e2\x0e.Gpio_PinState\"F\n\nMsg_SetPin\x12\x1c\n\x08Pin_Port\x18\x01 \x02(\x0e2\n.Gpio_Port\x12\x1a\n\x07Pin_Num\x18\x02 \x02(\x0e2\t.Gpio_Pin\"I\n\rMsg_TogglePin\x12\x1c\n\x08Pin_Port\x18\x01 \x02(\x0e2\n.Gpio_Port\x12\x1a\n\x07Pin_Num\x18\x02 \x02(\x0e2\t.Gpio_Pin\"-\n\nMsg_Header\x12\x0e\n\x06msg_ID\x18\x01 \x02(\x07\x12\x0f\n\x07msg_len\x18\x02 \x02(\x07\"\x9f\x01\n\x0bMsg_BatchOp\x12\x1e\n\x07Set_Pin\x18\x01 \x01(\x0b2\x0b.Msg_SetPinH\x00\x12\"\n\tReset_Pin\x18\x02 \x01(\x0b2\r.Msg_ResetPinH\x00\x12$\n\nToggle_Pin\x18\x03 \x01(\x0b2\x0e.Msg_TogglePinH\x00\x12 \n\x08Read_Pin\x18\x04 \x01(\x0b2\x0c.Msg_ReadPinH\x00B\x04\n\x02Op\"&\n\tMsg_Batch\x12\x19\n\x03Ops\x18\x01 \x03(\x0b2\x0c.Msg_BatchOp\"A\n\x0fMsg_BatchResult\x12\x10\n\x08Ops_Done\x18\x01 \x02(\r\x12\x1c\n\x05Reads\x18\x02 \x03(\x0b2\r.Msg_PinValue\"O\n\rMsg_WritePort\x12\x18\n\x04Port\x18\x01 \x02(\x0e2\n.Gpio_Port\x12\x10\n\x08Set_Mask\x18\x02 \x02(\r\x12\x12\n\nReset_Mask\x18\x03 \x02(\r\"(\n\x0cMsg_ReadPort\x12\x18\n\x04Port\x18\x01 \x02(\x0e2\n.Gpio_Port\"8\n\rMsg_PortValue\x12\x18\n\x04Port\x18\x01 \x02(\x0e2\n.Gpio_Port\x12\r\n\x05Value\x18\x02 \x02(\r\"\x1f\n\x0eMsg_GetProfile\x12\r\n\x05Reset\x18\x01 \x02(\x08\"V\n\x0eMsg_ProbeStats\x12\r\n\x05Probe\x18\x01 \x02(\r\x12\r\n\x05Count\x18\x02 \x02(\r\x12\x0b\n\x03Min\x18\x03 \x02(\r\x12\x0b\n\x03Max\x18\x04 \x02(\r\x12\x0c\n\x04Mean\x18\x05 \x02(\r\"H\n\x11Msg_ProfileReport\x12\x12\n\nCore_Clock\x18\x01 \x02(\r\x12\x1f\n\x06Probes\x18\x02 \x03(\x0b2\x0f.Msg_ProbeStats\"%\n\x10Msg_SetLinkSpeed\x12\x11\n\tBaud_Rate\x18\x01 \x02(\r\"J\n\x10Msg_LinkSpeedAck\x12\x10\n\x08Accepted\x18\x01 \x02(\x08\x12\x11\n\tBaud_Rate\x18\x02 \x02(\r\x12\x11\n\tError_PPM\x18\x03 \x02(\x11*S\n\tGpio_Port\x12\n\n\x06PORT_A\x10\x00\x12\n\n\x06PORT_B\x10\x01\x12\n\n\x06PORT_C\x10\x02\x12\n\n\x06PORT_D\x10\x03\x12\n\n\x06PORT_E\x10\x04\x12\n\n\x06PORT_H\x10\x05*\xc0\x01\n\x08Gpio_Pin\x12\t\n\x05PIN_0\x10\x00\x12\t\n\x05PIN_1\x10\x01\x12\t\n\x05PIN_2\x10\x02\x12\t\n\x05PIN_3\x10\x03\x12\t\n\x05PIN_4\x10\x04\x12\t\n\x05PIN_5\x10\x05\x12\t\n\x05PIN_6\x10\x06\x12\t\n\x05PIN_7\x10\x07\x12\t\n\x05PIN_8\x10\x08\x12\t\n\x05PIN_9\x10\t\x12\n\n\x06PIN_10\x10\n\x12\n\n\x06PIN_11\x10\x0b\x12\n\n\x06PIN_12\x10\x0c\x12\n\n\x06PIN_13\x10\r\x12\n\n\x06PIN_14\x10\x0e\x12\n\n\x06PIN_15\x10\x0f*.\n\rGpio_PinState\x12\r\n\tSTATE_LOW\x10\x00\x12\x0e\n\nSTATE_HIGH\x10\x01')
 
 _globals = globals()
 _builder.BuildMessageAndEnumDescriptors(DESCRIPTOR, _globals)
 _builder.BuildTopDescriptorsAndMessages(DESCRIPTOR, 'message_pb2', _globals)
 if not _descriptor._USE_C_DESCRIPTORS:
   DESCRIPTOR._loaded_options = None
-  _globals['_MSG_HEADER']._serialized_start=17
-  _globals['_MSG_HEADER']._serialized_end=62
-  _globals['_EXAMPLE']._serialized_start=64
-  _globals['_EXAMPLE']._serialized_end=107
+  _globals['_GPIO_PORT']._serialized_start=1226
+  _globals['_GPIO_PORT']._serialized_end=1309
+  _globals['_GPIO_PIN']._serialized_start=1312
+  _globals['_GPIO_PIN']._serialized_end=1504
+  _globals['_GPIO_PINSTATE']._serialized_start=1506
+  _globals['_GPIO_PINSTATE']._serialized_end=1552
+  _globals['_MSG_RESETPIN']._serialized_start=17
+  _globals['_MSG_RESETPIN']._serialized_end=89
+  _globals['_MSG_READPIN']._serialized_start=91
+  _globals['_MSG_READPIN']._serialized_end=162
+  _globals['_MSG_PINVALUE']._serialized_start=164
+  _globals['_MSG_PINVALUE']._serialized_end=270
+  _globals['_MSG_SETPIN']._serialized_start=272
+  _globals['_MSG_SETPIN']._serialized_end=342
+  _globals['_MSG_TOGGLEPIN']._serialized_start=344
+  _globals['_MSG_TOGGLEPIN']._serialized_end=417
+  _globals['_MSG_HEADER']._serialized_start=419
+  _globals['_MSG_HEADER']._serialized_end=464
+  _globals['_MSG_BATCHOP']._serialized_start=467
+  _globals['_MSG_BATCHOP']._serialized_end=626
+  _globals['_MSG_BATCH']._serialized_start=628
+  _globals['_MSG_BATCH']._serialized_end=666
+  _globals['_MSG_BATCHRESULT']._serialized_start=668
+  _globals['_MSG_BATCHRESULT']._serialized_end=733
+  _globals['_MSG_WRITEPORT']._serialized_start=735
+  _globals['_MSG_WRITEPORT']._serialized_end=814
+  _globals['_MSG_READPORT']._serialized_start=816
+  _globals['_MSG_READPORT']._serialized_end=856
+  _globals['_MSG_PORTVALUE']._serialized_start=858
+  _globals['_MSG_PORTVALUE']._serialized_end=914
+  _globals['_MSG_GETPROFILE']._serialized_start=916
+  _globals['_MSG_GETPROFILE']._serialized_end=947
+  _globals['_MSG_PROBESTATS']._serialized_start=949
+  _globals['_MSG_PROBESTATS']._serialized_end=1035
+  _globals['_MSG_PROFILEREPORT']._serialized_start=1037
+  _globals['_MSG_PROFILEREPORT']._serialized_end=1109
+  _globals['_MSG_SETLINKSPEED']._serialized_start=1111
+  _globals['_MSG_SETLINKSPEED']._serialized_end=1148
+  _globals['_MSG_LINKSPEEDACK']._serialized_start=1150
+  _globals['_MSG_LINKSPEEDACK']._serialized_end=1224
 # @@protoc_insertion_point(module_scope)
@@ -0,0 +1,222 @@
+import argparse
+import os
+import re
+import sys
+
+# Turns message.services, the list of messages sent on the link, into:
+#   message.services.h         : MessageID_t, the request and reply lists, the straight-line codec of
+#                                every flat message (LIB/PbFastCodec.h) and the const service table
+#                                Proto_Services[ID] = {ID, fields, handler, max size, codec} of main.c
+#   Message_Services.py        : the same IDs as Service_* constants and the Services table of the host
+# generate_messages.py runs it before every PlatformIO build. By hand, run it after nanopb_generator.py,
+# the max sizes are read from message.pb.h:
+#
+#     python services_generator.py message.services
+
+Script_Dir = os.path.dirname(os.path.abspath(__file__))
+
+class Service_Error(Exception):
+    pass
+
+def camel_to_words(Name):
+    # ResetPin -> Reset_Pin, the naming of the host Service_* constants
+    return re.sub(r'(?<=[a-z0-9])(?=[A-Z])', '_', Name)
+
+# Field types PB_FAST_CODEC_DEFINE handles, see LIB/PbFastCodec.h
+Fast_Codec_Types = {'BOOL', 'UINT32', 'UENUM', 'SINT32', 'FIXED32'}
+
+def read_pb_header(Path):
+    # Messages declared by the nanopb header as {name: (size or None when it depends on callbacks,
+    # True when every field of its FIELDLIST is a STATIC REQUIRED field of Fast_Codec_Types)}
+    with open(Path) as File:
+        Text = File.read()
+    Sizes = {Name: None for Name in re.findall(r'^extern const pb_msgdesc_t (\w+)_msg;', Text, re.M)}
+    for Name, Size in re.findall(r'^#define (\w+)_size\s+(\d+)\s*$', Text, re.M):
+        if Name in Sizes:
+            Sizes[Name] = int(Size)
+    Flat = {}
+    for Name, Body in re.findall(r'^#define (\w+)_FIELDLIST\(X, a\) \\\n((?:.*\\\n)*.*)$', Text, re.M):
+        Fields = [Field.split(',') for Field in re.findall(r'X\(a,([^)]*)\)', Body)]
+        Flat[Name] = bool(Fields) and all([Kind.strip() for Kind in Field[:3]] in
+                                          (['STATIC', 'REQUIRED', Type] for Type in Fast_Codec_Types)
+                                          for Field in Fields)
+    return {Name: (Size, Flat.get(Name, False)) for Name, Size in Sizes.items()}
+
+def read_services(Path, Messages):
+    # Returns [(ID, Message, Handler or None, Size macro, Max size, Flat)] sorted by ID
+    Services = []
+    Ids = set()
+    with open(Path) as File:
+        for Line_Num, Line in enumerate(File, 1):
+            Columns = Line.split('#', 1)[0].split()
+            if not Columns:
+                continue
+            Where = f"{Path}:{Line_Num}"
+            if len(Columns) != 4:
+                raise Service_Error(f"{Where}: expected ID, message, handler and max size")
+            Id, Message, Handler, Size = Columns
+            if not Id.isdigit() or int(Id) > 0xFF:
+                raise Service_Error(f"{Where}: ID {Id} is not between 0 and 255")
+            Id = int(Id)
+            if Id in Ids:
+                raise Service_Error(f"{Where}: ID {Id} used twice")
+            if Message not in Messages:
+                raise Service_Error(f"{Where}: {Message} is not a message of the nanopb header")
+            if not Message.startswith('Msg_'):
+                raise Service_Error(f"{Where}: {Message} does not start with Msg_")
+            if Handler == '-':
+                Handler = None
+            elif not re.fullmatch(r'[A-Za-z_]\w*', Handler):
+                raise Service_Error(f"{Where}: handler {Handler} is not a C identifier")
+            if Size == '-':
+                if Messages[Message][0] is None:
+                    raise Service_Error(f"{Where}: {Message} has no size in the schema, give one")
+                Size_Macro = f"{Message}_size"
+                Size = Messages[Message][0]
+            elif Size.isdigit():
+                Size_Macro = Size
+                Size = int(Size)
+            else:
+                raise Service_Error(f"{Where}: max size {Size} is not a number")
+            if Size > 0xFFFF:
+                raise Service_Error(f"{Where}: max size {Size} does not fit the service table")
+            Ids.add(Id)
+            Services.append((Id, Message, Handler, Size_Macro, Size, Messages[Message][1]))
+    if not Services:
+        raise Service_Error(f"{Path}: no message")
+    return sorted(Services)
+
+def id_name(Message):
+    return f"MSG_{Message[len('Msg_'):].upper()}_ID"
+
+def max_size_name(Message):
+    return f"MSG_{Message[len('Msg_'):].upper()}_MAX_SIZE"
+
+def generate_header(Services, Source, Pb_Header):
+    Guard = "MESSAGE_SERVICES_H_INCLUDED"
+    Id_Num = Services[-1][0] + 1
+    Out = [f"/* Automatically generated by services_generator.py from {Source}, do not edit */",
+           "",
+           f"#ifndef {Guard}",
+           f"#define {Guard}",
+           "#include <pb.h>",
+           f"#include \"{Pb_Header}\"",
+           "#include \"LIB/PbFastCodec.h\"",
+           "",
+           "/* Flat messages go through the straight-line codec, build with -D PROTO_FAST_CODEC=0 to send",
+           " * every message through pb_decode and pb_encode */",
+           "#ifndef PROTO_FAST_CODEC",
+           "#define PROTO_FAST_CODEC 1",
+           "#endif",
+           "",
+           "/* Message IDs carried by the frame header */",
+           "typedef enum",
+           "{"]
+    Out += [f"  {id_name(Message)} = {Id}," for Id, Message, Handler, Size_Macro, Size, Flat in Services]
+    Out += [f"  MSG_ID_NUM = {Id_Num},",
+            "}MessageID_t;",
+            "",
+            "/* Largest encoded body of each message */"]
+    Out += [f"#define {max_size_name(Message):<32} {Size_Macro}" for Id, Message, Handler, Size_Macro, Size, Flat in Services]
+    for Title, Macro, Is_Request in (("Requests", "PROTO_REQUEST_MESSAGES", True),
+                                     ("Replies", "PROTO_REPLY_MESSAGES", False)):
+        Members = [f"  X({Message[len('Msg_'):]}, {max_size_name(Message)})"
+                   for Id, Message, Handler, Size_Macro, Size, Flat in Services if (Handler is not None) == Is_Request]
+        Lines = [f"#define {Macro}(X)"] + Members
+        Out += ["",
+                f"/* {Title}, X(Name, MaxSize) with Name the message type without its Msg_ prefix */"]
+        Out += [f"{Line:<48}\\" for Line in Lines[:-1]] + Lines[-1:]
+    Out += ["",
+            "/* Entry of the service table, the table is indexed by message ID */",
+            "typedef struct",
+            "{",
+            "  uint8_t Id;",
+            "  const pb_msgdesc_t *Fields;",
+            "  void (*Handler)(void);  /* Runs a decoded request, NULL for replies and unused IDs */",
+            "  uint16_t MaxSize;       /* Largest encoded body */",
+            "  /* Straight-line codec of a flat request or reply, NULL for pb_decode and pb_encode */",
+            "  bool (*FastDecode)(const uint8_t *Ptr_Buffer, uint32_t Len, void *Ptr_Msg);",
+            "  uint32_t (*FastEncode)(const void *Ptr_Msg, uint8_t *Ptr_Buffer);",
+            "}Proto_Service_t;",
+            "",
+            "/* Request handlers, defined by the file including this header */"]
+    Out += [f"static void {Handler}(void);" for Id, Message, Handler, Size_Macro, Size, Flat in Services if Handler is not None]
+    Out += ["",
+            "/* Straight-line codec of the flat messages */",
+            "#if PROTO_FAST_CODEC"]
+    Out += [f"PB_FAST_CODEC_DEFINE({Message})" for Id, Message, Handler, Size_Macro, Size, Flat in Services if Flat]
+    Out += ["#define PROTO_FAST_CODEC_OF(Function) Function",
+            "#else",
+            "#define PROTO_FAST_CODEC_OF(Function) NULL",
+            "#endif",
+            "",
+            "/* Service table, const so that it stays in flash */",
+            "static const Proto_Service_t Proto_Services[MSG_ID_NUM] =",
+            "{"]
+    for Id, Message, Handler, Size_Macro, Size, Flat in Services:
+        Decode = f"PROTO_FAST_CODEC_OF(PbFast_Decode_{Message})" if Flat and Handler else "NULL"
+        Encode = f"PROTO_FAST_CODEC_OF(PbFast_Encode_{Message})" if Flat and not Handler else "NULL"
+        Out += [f"  [{id_name(Message)}] = {{{id_name(Message)}, {Message}_fields, {Handler or 'NULL'}, {max_size_name(Message)},",
+                f"    {Decode}, {Encode}}},"]
+    Out += ["};",
+            "",
+            f"#endif /* {Guard} */",
+            ""]
+    return "\n".join(Out)
+
+def generate_python(Services, Source):
+    Out = [f"# Automatically generated by services_generator.py from {Source}, do not edit",
+           "import collections",
+           "import message_pb2",
+           "",
+           "# Message of the link: ID of the frame header, name without Msg_, message_pb2 class, True for",
+           "# a request run by the firmware, largest encoded body",
+           "Message_Service = collections.namedtuple('Message_Service', 'Id Name Msg_Type Is_Request Max_Size')",
+           ""]
+    for Id, Message, Handler, Size_Macro, Size, Flat in Services:
+        Out.append(f"Service_{camel_to_words(Message[len('Msg_'):])} = 0x{Id:X}")
+    Out += ["",
+            "# Every message of the link by ID, in ID order",
+            "Services = {"]
+    for Id, Message, Handler, Size_Macro, Size, Flat in Services:
+        Name = Message[len('Msg_'):]
+        Out.append(f"    Service_{camel_to_words(Name)}: Message_Service(Service_{camel_to_words(Name)}, "
+                   f"\"{Name}\", message_pb2.{Message}, {Handler is not None}, {Size}),")
+    Out += ["}",
+            ""]
+    return "\n".join(Out)
+
+def write_if_changed(Path, Text):
+    # Leaves the file and its timestamp alone when nothing changed, no needless rebuild
+    if os.path.exists(Path):
+        with open(Path) as File:
+            if File.read() == Text:
+                return False
+    with open(Path, 'w', newline='\n') as File:
+        File.write(Text)
+    return True
+
+def main():
+    Parser = argparse.ArgumentParser(description="Generates the message ID and service tables from message.services")
+    Parser.add_argument('services', nargs='?', default=os.path.join(Script_Dir, 'message.services'))
+    Parser.add_argument('--pb-header', help="nanopb header of the messages, default next to the services file")
+    Parser.add_argument('--header', help="C header to write, default <name>.services.h next to the services file")
+    Parser.add_argument('--python', default=os.path.join(Script_Dir, '..', '..', 'nanopbsender', 'Message_Services.py'),
+                        help="Python module to write")
+    Args = Parser.parse_args()
+
+    Directory, Source = os.path.split(os.path.abspath(Args.services))
+    Base = Source.split('.')[0]
+    Pb_Header = Args.pb_header or os.path.join(Directory, f"{Base}.pb.h")
+    Header = Args.header or os.path.join(Directory, f"{Base}.services.h")
+    try:
+        Services = read_services(Args.services, read_pb_header(Pb_Header))
+    except (OSError, Service_Error) as Error:
+        sys.exit(f"services_generator: {Error}")
+
+    for Path, Text in ((Header, generate_header(Services, Source, os.path.basename(Pb_Header))),
+                       (Args.python, generate_python(Services, Source))):
+        print(f"{'Writing' if write_if_changed(Path, Text) else 'Unchanged'} {os.path.normpath(Path)}")
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,15 @@
+/*
+ ============================================================================
+ Name        : SimRegisters.c
+ Description : Simulated peripheral register block of the native test builds,
+               shared by every suite. The test runner builds the sources of the
+               test folder root into each suite, and native_test links the MCAL
+               drivers into all of them, library only suites included. Suites
+               that drive registers clear the block in setUp
+ ============================================================================
+ */
+#ifdef NATIVE_BUILD
+#include "LIB/Stm32F401cc.h"
+
+uint32_t Sim_PeripheralMemory[PERIPHERAL_REGION_SIZE / 4];
+#endif
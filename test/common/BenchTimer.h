@@ -0,0 +1,32 @@
+/*
+ ============================================================================
+ Name        : BenchTimer.h
+ Description : Host wall clock timing shared by the throughput reports of the
+               native tests
+ ============================================================================
+ */
+#ifndef BENCHTIMER_H_
+#define BENCHTIMER_H_
+
+#include <stdint.h>
+#include <time.h>
+
+/* Results of the timed loops are added here, so the compiler keeps the work being timed */
+static volatile uint32_t BenchTimer_Sink;
+
+/* Starts a measurement in Ptr_Start */
+static inline void BenchTimer_Start(struct timespec *Ptr_Start)
+{
+    clock_gettime(CLOCK_MONOTONIC, Ptr_Start);
+}
+
+/* Seconds elapsed since BenchTimer_Start */
+static inline double BenchTimer_Elapsed(const struct timespec *Ptr_Start)
+{
+    struct timespec End;
+
+    clock_gettime(CLOCK_MONOTONIC, &End);
+    return (double)(End.tv_sec - Ptr_Start->tv_sec) + ((double)(End.tv_nsec - Ptr_Start->tv_nsec) / 1e9);
+}
+
+#endif /* BENCHTIMER_H_ */
@@ -0,0 +1,356 @@
+/*
+ ============================================================================
+ Name        : test_main.c
+ Description : Native tests for the COBS encoder and streaming decoder, including
+               resynchronisation after lost or corrupted bytes and a throughput
+               report against a plain copy
+ ============================================================================
+ */
+#include <unity.h>
+#include <stdio.h>
+#include <string.h>
+#include "common/BenchTimer.h"
+#include "LIB/Cobs.h"
+
+#define FRAME_MAX        1024
+#define BENCH_FRAME_LEN  64
+#define BENCH_FRAMES     (256UL * 1024UL)
+
+static Cobs_Decoder_t Decoder;
+static uint8_t Decoded[FRAME_MAX];
+/* Length of the last frame Feed got */
+static uint32_t FrameLen;
+
+void setUp(void)
+{
+    Cobs_DecoderStart(&Decoder, Decoded, sizeof(Decoded));
+}
+
+void tearDown(void)
+{
+}
+
+/* Feeds bytes to the decoder, counts the frames and errors it reports. Decoded holds the last frame */
+static void Feed(const uint8_t *Ptr_Bytes, uint32_t Len, uint32_t *Ptr_Frames, uint32_t *Ptr_Errors)
+{
+    uint32_t Loc_idx;
+
+    for (Loc_idx = 0; Loc_idx < Len; Loc_idx++)
+    {
+        switch (Cobs_DecodeByte(&Decoder, Ptr_Bytes[Loc_idx]))
+        {
+        case COBS_DECODE_FRAME:
+            (*Ptr_Frames)++;
+            FrameLen = Decoder.Len;
+            Cobs_DecoderStart(&Decoder, Decoder.Buffer, Decoder.Size);
+            break;
+        case COBS_DECODE_ERROR:
+            (*Ptr_Errors)++;
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+/* Encodes Src between two delimiters, returns the number of bytes on the wire */
+static uint32_t Frame(const uint8_t *Ptr_Src, uint32_t Len, uint8_t *Ptr_Wire)
+{
+    uint32_t Loc_Len = Cobs_Encode(Ptr_Src, Len, &Ptr_Wire[1]);
+
+    Ptr_Wire[0] = COBS_DELIMITER;
+    Ptr_Wire[Loc_Len + 1] = COBS_DELIMITER;
+
+    return Loc_Len + 2;
+}
+
+static void RoundTrip(const uint8_t *Ptr_Src, uint32_t Len)
+{
+    static uint8_t Wire[COBS_ENCODED_MAX(FRAME_MAX) + 2];
+    uint32_t Loc_WireLen = Frame(Ptr_Src, Len, Wire);
+    uint32_t Loc_Frames = 0;
+    uint32_t Loc_Errors = 0;
+    uint32_t Loc_idx;
+
+    TEST_ASSERT_TRUE(Loc_WireLen - 2 <= COBS_ENCODED_MAX(Len));
+    for (Loc_idx = 1; Loc_idx < Loc_WireLen - 1; Loc_idx++)
+    {
+        TEST_ASSERT_NOT_EQUAL(COBS_DELIMITER, Wire[Loc_idx]);
+    }
+
+    Cobs_DecoderStart(&Decoder, Decoded, sizeof(Decoded));
+    Feed(Wire, Loc_WireLen, &Loc_Frames, &Loc_Errors);
+    TEST_ASSERT_EQUAL_UINT32(1, Loc_Frames);
+    TEST_ASSERT_EQUAL_UINT32(0, Loc_Errors);
+    TEST_ASSERT_EQUAL_UINT32(Len, FrameLen);
+    if (Len != 0)
+    {
+        TEST_ASSERT_EQUAL_MEMORY(Ptr_Src, Decoded, Len);
+    }
+}
+
+void test_RoundTrip_BlockBoundariesAndZeros(void)
+{
+    static uint8_t Src[FRAME_MAX];
+    const uint32_t Lens[] = {1, 2, 253, 254, 255, 256, 508, 509, FRAME_MAX};
+    uint32_t Loc_Len;
+    uint32_t Loc_idx;
+
+    for (Loc_Len = 0; Loc_Len < sizeof(Lens) / sizeof(Lens[0]); Loc_Len++)
+    {
+        /* No zero at all, full blocks only */
+        for (Loc_idx = 0; Loc_idx < Lens[Loc_Len]; Loc_idx++)
+        {
+            Src[Loc_idx] = (uint8_t)((Loc_idx % 255) + 1);
+        }
+        RoundTrip(Src, Lens[Loc_Len]);
+
+        /* Only zeros */
+        memset(Src, 0, Lens[Loc_Len]);
+        RoundTrip(Src, Lens[Loc_Len]);
+
+        /* Zeros right after and right before a full block */
+        for (Loc_idx = 0; Loc_idx < Lens[Loc_Len]; Loc_idx++)
+        {
+            Src[Loc_idx] = ((Loc_idx % 254) == 0) ? 0 : 0x55;
+        }
+        RoundTrip(Src, Lens[Loc_Len]);
+    }
+}
+
+void test_RoundTrip_SingleZeroIsNotAnEmptyFrame(void)
+{
+    const uint8_t Src[1] = {0};
+    uint8_t Wire[4];
+
+    TEST_ASSERT_EQUAL_UINT32(4, Frame(Src, 1, Wire));
+    TEST_ASSERT_EQUAL_HEX8(0x01, Wire[1]);
+    TEST_ASSERT_EQUAL_HEX8(0x01, Wire[2]);
+    RoundTrip(Src, 1);
+}
+
+void test_Encode_InPlaceMatchesSeparateBuffers(void)
+{
+    static uint8_t Src[FRAME_MAX];
+    static uint8_t Expected[COBS_ENCODED_MAX(FRAME_MAX)];
+    static uint8_t Shared[COBS_ENCODED_MAX(FRAME_MAX)];
+    const uint32_t Lens[] = {0, 1, 253, 254, 255, 508, 509, 762, FRAME_MAX};
+    uint32_t Loc_Seed = 0x2468ACE1;
+    uint32_t Loc_Len;
+    uint32_t Loc_Pattern;
+    uint32_t Loc_idx;
+
+    for (Loc_Len = 0; Loc_Len < sizeof(Lens) / sizeof(Lens[0]); Loc_Len++)
+    {
+        const uint32_t Len = Lens[Loc_Len];
+        const uint32_t Offset = COBS_INPLACE_OFFSET(Len);
+
+        for (Loc_Pattern = 0; Loc_Pattern < 3; Loc_Pattern++)
+        {
+            /* No zero, random with a few zeros, random with many zeros */
+            for (Loc_idx = 0; Loc_idx < Len; Loc_idx++)
+            {
+                Loc_Seed = (Loc_Seed * 1103515245UL) + 12345UL;
+                Src[Loc_idx] = (Loc_Pattern == 0) ? (uint8_t)((Loc_idx % 255) + 1) :
+                               (uint8_t)(Loc_Seed >> (16 + (Loc_Pattern * 3)));
+            }
+            TEST_ASSERT_EQUAL_UINT32(COBS_ENCODED_MAX(Len), Len + Offset);
+
+            /* The source sits at the end of the destination, as in the Tx frame buffer */
+            memcpy(&Shared[Offset], Src, Len);
+            TEST_ASSERT_EQUAL_UINT32(Cobs_Encode(Src, Len, Expected), Cobs_Encode(&Shared[Offset], Len, Shared));
+            TEST_ASSERT_EQUAL_MEMORY(Expected, Shared, Cobs_Encode(Src, Len, Expected));
+        }
+    }
+}
+
+void test_Decode_IgnoresEmptyFrames(void)
+{
+    const uint8_t Wire[] = {0x00, 0x00, 0x00, 0x03, 0x11, 0x22, 0x00, 0x00};
+    uint32_t Loc_Frames = 0;
+    uint32_t Loc_Errors = 0;
+
+    Feed(Wire, sizeof(Wire), &Loc_Frames, &Loc_Errors);
+    TEST_ASSERT_EQUAL_UINT32(1, Loc_Frames);
+    TEST_ASSERT_EQUAL_UINT32(0, Loc_Errors);
+}
+
+/* Three frames on the wire with one of them damaged by Damage, the other two must come out intact */
+static void CheckResync(void (*Damage)(uint8_t *Ptr_Wire, uint32_t *Ptr_Len, uint32_t Start, uint32_t End),
+                        uint32_t ExpectedFrames)
+{
+    const uint8_t Src[3][6] = {{0x0D, 0x00, 0x01, 0x02, 0x00, 0x03},
+                               {0x2A, 0x04, 0x08, 0x00, 0x10, 0x20},
+                               {0x00, 0x00, 0x7F, 0x80, 0xFF, 0x01}};
+    uint8_t Wire[3 * (COBS_ENCODED_MAX(6) + 2)];
+    uint32_t Loc_Len = 0;
+    uint32_t Loc_Start = 0;
+    uint32_t Loc_End = 0;
+    uint32_t Loc_Frames = 0;
+    uint32_t Loc_Errors = 0;
+    uint32_t Loc_Good = 0;
+    uint32_t Loc_idx;
+
+    Loc_Len += Frame(Src[0], 6, &Wire[Loc_Len]);
+    Loc_Start = Loc_Len;
+    Loc_Len += Frame(Src[1], 6, &Wire[Loc_Len]);
+    Loc_End = Loc_Len;
+    Loc_Len += Frame(Src[2], 6, &Wire[Loc_Len]);
+    Damage(Wire, &Loc_Len, Loc_Start, Loc_End);
+
+    for (Loc_idx = 0; Loc_idx < Loc_Len; Loc_idx++)
+    {
+        Cobs_DecodeStatus_t Loc_Status = Cobs_DecodeByte(&Decoder, Wire[Loc_idx]);
+
+        if (Loc_Status == COBS_DECODE_FRAME)
+        {
+            Loc_Frames++;
+            /* Intact frames decode to their source, the damaged one may decode to anything */
+            Loc_Good += ((Decoder.Len == 6) && ((memcmp(Decoded, Src[0], 6) == 0) ||
+                                                 (memcmp(Decoded, Src[2], 6) == 0)));
+            Cobs_DecoderStart(&Decoder, Decoded, sizeof(Decoded));
+        }
+        else if (Loc_Status == COBS_DECODE_ERROR)
+        {
+            Loc_Errors++;
+        }
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(2, Loc_Good);
+    TEST_ASSERT_EQUAL_UINT32(ExpectedFrames, Loc_Frames);
+    TEST_ASSERT_EQUAL_UINT32(3 - ExpectedFrames, Loc_Errors);
+}
+
+static void DropDataByte(uint8_t *Ptr_Wire, uint32_t *Ptr_Len, uint32_t Start, uint32_t End)
+{
+    /* Last data byte of the middle frame, its last block comes up short */
+    memmove(&Ptr_Wire[End - 2], &Ptr_Wire[End - 1], *Ptr_Len - (End - 1));
+    (*Ptr_Len)--;
+}
+
+static void DropDelimiter(uint8_t *Ptr_Wire, uint32_t *Ptr_Len, uint32_t Start, uint32_t End)
+{
+    /* Trailing delimiter of the first frame, the leading one of the middle frame ends it */
+    memmove(&Ptr_Wire[Start - 1], &Ptr_Wire[Start], *Ptr_Len - Start);
+    (*Ptr_Len)--;
+}
+
+static void CorruptCode(uint8_t *Ptr_Wire, uint32_t *Ptr_Len, uint32_t Start, uint32_t End)
+{
+    /* First code byte of the middle frame points past its end */
+    Ptr_Wire[Start + 1] = 0xF0;
+}
+
+void test_Resync_AfterDroppedDataByte(void)
+{
+    CheckResync(DropDataByte, 2);
+}
+
+void test_Resync_AfterDroppedDelimiter(void)
+{
+    CheckResync(DropDelimiter, 3);
+}
+
+void test_Resync_AfterCorruptedCodeByte(void)
+{
+    CheckResync(CorruptCode, 2);
+}
+
+void test_Overflow_IsReportedOnceAndSkipped(void)
+{
+    static uint8_t Src[300];
+    static uint8_t Wire[COBS_ENCODED_MAX(300) + 2];
+    const uint8_t Small[3] = {0x01, 0x00, 0x02};
+    uint8_t SmallWire[COBS_ENCODED_MAX(3) + 2];
+    uint32_t Loc_Frames = 0;
+    uint32_t Loc_Errors = 0;
+
+    memset(Src, 0x33, sizeof(Src));
+    Cobs_DecoderStart(&Decoder, Decoded, 16);
+    Feed(Wire, Frame(Src, sizeof(Src), Wire), &Loc_Frames, &Loc_Errors);
+    TEST_ASSERT_EQUAL_UINT32(0, Loc_Frames);
+    TEST_ASSERT_EQUAL_UINT32(1, Loc_Errors);
+
+    Feed(SmallWire, Frame(Small, sizeof(Small), SmallWire), &Loc_Frames, &Loc_Errors);
+    TEST_ASSERT_EQUAL_UINT32(1, Loc_Frames);
+    TEST_ASSERT_EQUAL_UINT32(1, Loc_Errors);
+    TEST_ASSERT_EQUAL_UINT32(3, FrameLen);
+    TEST_ASSERT_EQUAL_MEMORY(Small, Decoded, 3);
+}
+
+void test_Benchmark_EncodeAndStreamingDecode(void)
+{
+    /* A protobuf like frame, a few zeros among small values */
+    static uint8_t Src[BENCH_FRAME_LEN];
+    static uint8_t Wire[COBS_ENCODED_MAX(BENCH_FRAME_LEN) + 2];
+    static uint8_t Copy[BENCH_FRAME_LEN];
+    struct timespec Start;
+    double Loc_Copy;
+    double Loc_Encode;
+    double Loc_Decode;
+    uint32_t Loc_WireLen = 0;
+    uint32_t Loc_Frames = 0;
+    uint32_t Loc_Errors = 0;
+    unsigned long Loc_Round;
+    char Report[128];
+    uint32_t Loc_idx;
+
+    for (Loc_idx = 0; Loc_idx < BENCH_FRAME_LEN; Loc_idx++)
+    {
+        Src[Loc_idx] = ((Loc_idx % 5) == 1) ? 0 : (uint8_t)(Loc_idx * 7 + 1);
+    }
+
+    BenchTimer_Start(&Start);
+    for (Loc_Round = 0; Loc_Round < BENCH_FRAMES; Loc_Round++)
+    {
+        Src[0] = (uint8_t)Loc_Round | 1;
+        memcpy(Copy, Src, sizeof(Src));
+        BenchTimer_Sink += Copy[BENCH_FRAME_LEN - 1];
+    }
+    Loc_Copy = BenchTimer_Elapsed(&Start);
+
+    BenchTimer_Start(&Start);
+    for (Loc_Round = 0; Loc_Round < BENCH_FRAMES; Loc_Round++)
+    {
+        Src[0] = (uint8_t)Loc_Round | 1;
+        Loc_WireLen = Frame(Src, sizeof(Src), Wire);
+        BenchTimer_Sink += Wire[1];
+    }
+    Loc_Encode = BenchTimer_Elapsed(&Start);
+
+    BenchTimer_Start(&Start);
+    for (Loc_Round = 0; Loc_Round < BENCH_FRAMES; Loc_Round++)
+    {
+        Feed(Wire, Loc_WireLen, &Loc_Frames, &Loc_Errors);
+    }
+    Loc_Decode = BenchTimer_Elapsed(&Start);
+
+    snprintf(Report, sizeof(Report), "COBS %u byte frames: copy %.1f MB/s, encode %.1f MB/s, decode %.1f MB/s",
+             BENCH_FRAME_LEN, ((double)(BENCH_FRAMES * BENCH_FRAME_LEN) / 1e6) / Loc_Copy,
+             ((double)(BENCH_FRAMES * BENCH_FRAME_LEN) / 1e6) / Loc_Encode,
+             ((double)(BENCH_FRAMES * BENCH_FRAME_LEN) / 1e6) / Loc_Decode);
+    TEST_MESSAGE(Report);
+    snprintf(Report, sizeof(Report), "COBS wire overhead: %u bytes per %u byte frame (%.1f %%)",
+             (unsigned)(Loc_WireLen - BENCH_FRAME_LEN), BENCH_FRAME_LEN,
+             100.0 * (double)(Loc_WireLen - BENCH_FRAME_LEN) / BENCH_FRAME_LEN);
+    TEST_MESSAGE(Report);
+
+    TEST_ASSERT_EQUAL_UINT32(BENCH_FRAMES, Loc_Frames);
+    TEST_ASSERT_EQUAL_UINT32(0, Loc_Errors);
+    TEST_ASSERT_EQUAL_UINT32(BENCH_FRAME_LEN + 3, Loc_WireLen);
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_RoundTrip_BlockBoundariesAndZeros);
+    RUN_TEST(test_RoundTrip_SingleZeroIsNotAnEmptyFrame);
+    RUN_TEST(test_Encode_InPlaceMatchesSeparateBuffers);
+    RUN_TEST(test_Decode_IgnoresEmptyFrames);
+    RUN_TEST(test_Resync_AfterDroppedDataByte);
+    RUN_TEST(test_Resync_AfterDroppedDelimiter);
+    RUN_TEST(test_Resync_AfterCorruptedCodeByte);
+    RUN_TEST(test_Overflow_IsReportedOnceAndSkipped);
+    RUN_TEST(test_Benchmark_EncodeAndStreamingDecode);
+    return UNITY_END();
+}
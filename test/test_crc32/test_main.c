@@ -0,0 +1,156 @@
+/*
+ ============================================================================
+ Name        : test_main.c
+ Description : Native tests for the software CRC-32/MPEG-2 variants used by the
+               host, checked against each other and the CRC unit check value,
+               with a throughput report of each variant
+ ============================================================================
+ */
+#include <unity.h>
+#include <stdio.h>
+#include <string.h>
+#include "common/BenchTimer.h"
+#include "LIB/Crc32.h"
+
+#define BUFFER_LEN      4096
+#define BENCH_TOTAL     (64UL * 1024UL * 1024UL)
+#define BENCH_FRAME_LEN 64
+
+static Crc32_Tables_t Tables;
+static uint8_t Buffer[BUFFER_LEN];
+
+void setUp(void)
+{
+    uint32_t Loc_idx;
+    uint32_t Loc_Seed = 0x12345678;
+
+    Crc32_InitTables(&Tables);
+    for (Loc_idx = 0; Loc_idx < BUFFER_LEN; Loc_idx++)
+    {
+        Loc_Seed = (Loc_Seed * 1103515245UL) + 12345UL;
+        Buffer[Loc_idx] = (uint8_t)(Loc_Seed >> 16);
+    }
+}
+
+void tearDown(void)
+{
+}
+
+void test_CheckValue_MatchesTheCrcUnit(void)
+{
+    const uint8_t Check[] = "123456789";
+
+    TEST_ASSERT_EQUAL_HEX32(CRC32_CHECK, Crc32_Bitwise(CRC32_INITIAL, Check, 9));
+    TEST_ASSERT_EQUAL_HEX32(CRC32_CHECK, Crc32_Bytewise(&Tables, CRC32_INITIAL, Check, 9));
+    TEST_ASSERT_EQUAL_HEX32(CRC32_CHECK, Crc32_SliceBy8(&Tables, CRC32_INITIAL, Check, 9));
+}
+
+void test_WordOfZeros_GivesTheResetValueOfTheUnit(void)
+{
+    /* Known value of the unit after a reset and one write of 0x00000000 */
+    const uint8_t Zeros[4] = {0};
+
+    TEST_ASSERT_EQUAL_HEX32(0xC704DD7BUL, Crc32_Bitwise(CRC32_INITIAL, Zeros, 4));
+}
+
+void test_Variants_AgreeOnEveryLengthAndAlignment(void)
+{
+    uint32_t Loc_Len;
+    uint32_t Loc_Offset;
+
+    for (Loc_Offset = 0; Loc_Offset < 8; Loc_Offset++)
+    {
+        for (Loc_Len = 0; Loc_Len < 300; Loc_Len++)
+        {
+            uint32_t Loc_Expected = Crc32_Bitwise(CRC32_INITIAL, &Buffer[Loc_Offset], Loc_Len);
+
+            TEST_ASSERT_EQUAL_HEX32(Loc_Expected, Crc32_Bytewise(&Tables, CRC32_INITIAL, &Buffer[Loc_Offset], Loc_Len));
+            TEST_ASSERT_EQUAL_HEX32(Loc_Expected, Crc32_SliceBy8(&Tables, CRC32_INITIAL, &Buffer[Loc_Offset], Loc_Len));
+        }
+    }
+}
+
+void test_Update_CanBeSplitAnywhere(void)
+{
+    uint32_t Loc_Whole = Crc32_SliceBy8(&Tables, CRC32_INITIAL, Buffer, 1000);
+    uint32_t Loc_Split;
+
+    for (Loc_Split = 0; Loc_Split <= 1000; Loc_Split += 37)
+    {
+        uint32_t Loc_Crc = Crc32_SliceBy8(&Tables, CRC32_INITIAL, Buffer, Loc_Split);
+
+        TEST_ASSERT_EQUAL_HEX32(Loc_Whole, Crc32_Bitwise(Loc_Crc, &Buffer[Loc_Split], 1000 - Loc_Split));
+    }
+}
+
+void test_SingleBitError_IsDetected(void)
+{
+    uint32_t Loc_Good = Crc32_SliceBy8(&Tables, CRC32_INITIAL, Buffer, BENCH_FRAME_LEN);
+    uint32_t Loc_Bit;
+
+    for (Loc_Bit = 0; Loc_Bit < (BENCH_FRAME_LEN * 8); Loc_Bit++)
+    {
+        Buffer[Loc_Bit / 8] ^= (uint8_t)(1U << (Loc_Bit % 8));
+        TEST_ASSERT_NOT_EQUAL(Loc_Good, Crc32_SliceBy8(&Tables, CRC32_INITIAL, Buffer, BENCH_FRAME_LEN));
+        Buffer[Loc_Bit / 8] ^= (uint8_t)(1U << (Loc_Bit % 8));
+    }
+}
+
+/* Runs one variant over BENCH_TOTAL bytes in Len byte frames, reports MB/s */
+static void Bench(const char *Ptr_Name, int Variant, uint32_t Len)
+{
+    struct timespec Start;
+    unsigned long Loc_Done;
+    double Loc_Seconds;
+    char Report[96];
+
+    BenchTimer_Start(&Start);
+    for (Loc_Done = 0; Loc_Done < BENCH_TOTAL; Loc_Done += Len)
+    {
+        switch (Variant)
+        {
+        case 0:
+            BenchTimer_Sink += Crc32_Bitwise(CRC32_INITIAL, Buffer, Len);
+            break;
+        case 1:
+            BenchTimer_Sink += Crc32_Bytewise(&Tables, CRC32_INITIAL, Buffer, Len);
+            break;
+        default:
+            BenchTimer_Sink += Crc32_SliceBy8(&Tables, CRC32_INITIAL, Buffer, Len);
+            break;
+        }
+        /* Keeps the frames from being hoisted out of the loop */
+        Buffer[0] = (uint8_t)Loc_Done;
+    }
+    Loc_Seconds = BenchTimer_Elapsed(&Start);
+
+    snprintf(Report, sizeof(Report), "CRC32 %-11s %4u byte frames: %8.1f MB/s",
+             Ptr_Name, (unsigned)Len, ((double)BENCH_TOTAL / 1e6) / Loc_Seconds);
+    TEST_MESSAGE(Report);
+}
+
+void test_Benchmark_SoftwareVariants(void)
+{
+    /* Protocol sized frames, where the per call cost shows, and long blocks */
+    const uint32_t Lens[] = {BENCH_FRAME_LEN, BUFFER_LEN};
+    uint32_t Loc_idx;
+
+    for (Loc_idx = 0; Loc_idx < sizeof(Lens) / sizeof(Lens[0]); Loc_idx++)
+    {
+        Bench("bitwise", 0, Lens[Loc_idx]);
+        Bench("bytewise", 1, Lens[Loc_idx]);
+        Bench("slice-by-8", 2, Lens[Loc_idx]);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_CheckValue_MatchesTheCrcUnit);
+    RUN_TEST(test_WordOfZeros_GivesTheResetValueOfTheUnit);
+    RUN_TEST(test_Variants_AgreeOnEveryLengthAndAlignment);
+    RUN_TEST(test_Update_CanBeSplitAnywhere);
+    RUN_TEST(test_SingleBitError_IsDetected);
+    RUN_TEST(test_Benchmark_SoftwareVariants);
+    return UNITY_END();
+}
@@ -0,0 +1,248 @@
+/*
+ ============================================================================
+ Name        : test_main.c
+ Description : Native tests of the straight-line codec of flat messages
+               against pb_encode and pb_decode, every input must give the
+               result of nanopb, with a ns/message report of both codecs
+ ============================================================================
+ */
+#include <unity.h>
+#include <stdio.h>
+#include <string.h>
+#include <pb_encode.h>
+#include <pb_decode.h>
+#include "common/BenchTimer.h"
+#include "proto/message.pb.h"
+#include "LIB/PbFastCodec.h"
+
+#define BENCH_MESSAGES  2000000UL
+
+PB_FAST_CODEC_DEFINE(Msg_SetPin)
+PB_FAST_CODEC_DEFINE(Msg_WritePort)
+PB_FAST_CODEC_DEFINE(Msg_LinkSpeedAck)
+PB_FAST_CODEC_DEFINE(Msg_Header)
+
+static uint8_t Buffer[64];
+
+void setUp(void)
+{
+    memset(Buffer, 0xA5, sizeof(Buffer));
+}
+
+void tearDown(void)
+{
+}
+
+/* Encodes Ptr_Msg with pb_encode into Ptr_Out, returns the length */
+static uint32_t Reference_Encode(const pb_msgdesc_t *Fields, const void *Ptr_Msg, uint8_t *Ptr_Out)
+{
+    pb_ostream_t Loc_Stream = pb_ostream_from_buffer(Ptr_Out, 32);
+
+    TEST_ASSERT_TRUE(pb_encode(&Loc_Stream, Fields, Ptr_Msg));
+    return (uint32_t)Loc_Stream.bytes_written;
+}
+
+static bool Reference_Decode(const pb_msgdesc_t *Fields, const uint8_t *Ptr_In, uint32_t Len, void *Ptr_Msg)
+{
+    pb_istream_t Loc_Stream = pb_istream_from_buffer(Ptr_In, Len);
+
+    return pb_decode(&Loc_Stream, Fields, Ptr_Msg);
+}
+
+void test_Encode_GivesTheBytesOfPbEncode(void)
+{
+    /* Bytes of message_pb2 for the same values */
+    const uint8_t Ack_Bytes[] = {0x08, 0x01, 0x10, 0x80, 0xA0, 0x38, 0x18, 0xA3, 0x13};
+    const uint8_t Port_Bytes[] = {0x08, 0x05, 0x10, 0xFF, 0xFF, 0x03, 0x18, 0xB4, 0x24};
+    const uint8_t Header_Bytes[] = {0x0D, 0x05, 0x00, 0x00, 0x00, 0x15, 0x4D, 0x00, 0x00, 0x00};
+    Msg_LinkSpeedAck Ack = {true, 921600, -1234};
+    Msg_WritePort Port = {Gpio_Port_PORT_H, 0xFFFF, 0x1234};
+    Msg_Header Header = {5, 77};
+    uint8_t Expected[32];
+
+    TEST_ASSERT_EQUAL_UINT32(sizeof(Ack_Bytes), PbFast_Encode_Msg_LinkSpeedAck(&Ack, Buffer));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(Ack_Bytes, Buffer, sizeof(Ack_Bytes));
+    TEST_ASSERT_EQUAL_UINT32(sizeof(Port_Bytes), PbFast_Encode_Msg_WritePort(&Port, Buffer));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(Port_Bytes, Buffer, sizeof(Port_Bytes));
+    TEST_ASSERT_EQUAL_UINT32(sizeof(Header_Bytes), PbFast_Encode_Msg_Header(&Header, Buffer));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(Header_Bytes, Buffer, sizeof(Header_Bytes));
+
+    TEST_ASSERT_EQUAL_UINT32(Reference_Encode(Msg_LinkSpeedAck_fields, &Ack, Expected),
+                             PbFast_Encode_Msg_LinkSpeedAck(&Ack, Buffer));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(Expected, Buffer, sizeof(Ack_Bytes));
+}
+
+void test_Encode_EdgeValues_MatchPbEncode(void)
+{
+    const int32_t Ppm[] = {0, -1, 1, -64, 63, -65, 64, INT32_MIN, INT32_MAX};
+    const uint32_t Baud[] = {0, 0x7F, 0x80, 0x3FFF, 0x4000, UINT32_MAX};
+    uint8_t Expected[32];
+    uint32_t Loc_i;
+    uint32_t Loc_j;
+
+    for (Loc_i = 0; Loc_i < sizeof(Ppm) / sizeof(Ppm[0]); Loc_i++)
+    {
+        for (Loc_j = 0; Loc_j < sizeof(Baud) / sizeof(Baud[0]); Loc_j++)
+        {
+            Msg_LinkSpeedAck Ack = {(Loc_j & 1) != 0, Baud[Loc_j], Ppm[Loc_i]};
+            uint32_t Loc_Len = Reference_Encode(Msg_LinkSpeedAck_fields, &Ack, Expected);
+
+            TEST_ASSERT_TRUE(Loc_Len <= Msg_LinkSpeedAck_size);
+            TEST_ASSERT_EQUAL_UINT32(Loc_Len, PbFast_Encode_Msg_LinkSpeedAck(&Ack, Buffer));
+            TEST_ASSERT_EQUAL_HEX8_ARRAY(Expected, Buffer, Loc_Len);
+        }
+    }
+}
+
+void test_Decode_RoundTripsTheEncoder(void)
+{
+    Msg_LinkSpeedAck Ack = {true, 115200, -42};
+    Msg_LinkSpeedAck Ack_Out = {0};
+    Msg_WritePort Port = {Gpio_Port_PORT_C, 0x8001, 0x00F0};
+    Msg_WritePort Port_Out = {0};
+    Msg_SetPin Pin = {Gpio_Port_PORT_B, Gpio_Pin_PIN_15};
+    Msg_SetPin Pin_Out = {0};
+    uint32_t Loc_Len;
+
+    Loc_Len = PbFast_Encode_Msg_LinkSpeedAck(&Ack, Buffer);
+    TEST_ASSERT_TRUE(PbFast_Decode_Msg_LinkSpeedAck(Buffer, Loc_Len, &Ack_Out));
+    TEST_ASSERT_EQUAL(Ack.Accepted, Ack_Out.Accepted);
+    TEST_ASSERT_EQUAL_UINT32(Ack.Baud_Rate, Ack_Out.Baud_Rate);
+    TEST_ASSERT_EQUAL_INT32(Ack.Error_PPM, Ack_Out.Error_PPM);
+
+    Loc_Len = PbFast_Encode_Msg_WritePort(&Port, Buffer);
+    TEST_ASSERT_TRUE(PbFast_Decode_Msg_WritePort(Buffer, Loc_Len, &Port_Out));
+    TEST_ASSERT_EQUAL(Port.Port, Port_Out.Port);
+    TEST_ASSERT_EQUAL_HEX16(Port.Set_Mask, Port_Out.Set_Mask);
+    TEST_ASSERT_EQUAL_HEX16(Port.Reset_Mask, Port_Out.Reset_Mask);
+
+    Loc_Len = PbFast_Encode_Msg_SetPin(&Pin, Buffer);
+    TEST_ASSERT_EQUAL_UINT32(4, Loc_Len);
+    TEST_ASSERT_TRUE(PbFast_Decode_Msg_SetPin(Buffer, Loc_Len, &Pin_Out));
+    TEST_ASSERT_EQUAL(Pin.Pin_Port, Pin_Out.Pin_Port);
+    TEST_ASSERT_EQUAL(Pin.Pin_Num, Pin_Out.Pin_Num);
+}
+
+/* Decodes Len bytes with both codecs, the status and the message must be the same */
+static void Check_WritePort(const uint8_t *Ptr_In, uint32_t Len, bool Expected_Ok)
+{
+    Msg_WritePort Fast = {0};
+    Msg_WritePort Reference = {0};
+    bool Loc_Ok = Reference_Decode(Msg_WritePort_fields, Ptr_In, Len, &Reference);
+
+    TEST_ASSERT_EQUAL(Expected_Ok, Loc_Ok);
+    TEST_ASSERT_EQUAL(Loc_Ok, PbFast_Decode_Msg_WritePort(Ptr_In, Len, &Fast));
+    if (Loc_Ok)
+    {
+        TEST_ASSERT_EQUAL(Reference.Port, Fast.Port);
+        TEST_ASSERT_EQUAL_HEX16(Reference.Set_Mask, Fast.Set_Mask);
+        TEST_ASSERT_EQUAL_HEX16(Reference.Reset_Mask, Fast.Reset_Mask);
+    }
+}
+
+void test_Decode_UnexpectedInput_GivesTheResultOfPbDecode(void)
+{
+    /* Fields in another order */
+    const uint8_t Reordered[] = {0x18, 0x0F, 0x08, 0x02, 0x10, 0xF0, 0x01};
+    /* Unknown field 4 between two known ones */
+    const uint8_t Unknown[] = {0x08, 0x02, 0x20, 0x07, 0x10, 0xF0, 0x01, 0x18, 0x0F};
+    /* Field 2 sent twice, the last one wins */
+    const uint8_t Repeated[] = {0x08, 0x02, 0x10, 0x01, 0x10, 0x02, 0x18, 0x0F};
+    /* Zero written on two bytes */
+    const uint8_t Long_Varint[] = {0x08, 0x82, 0x00, 0x10, 0x01, 0x18, 0x0F};
+    /* Reset_Mask missing */
+    const uint8_t Missing[] = {0x08, 0x02, 0x10, 0x01};
+    /* Set_Mask of 0x10000 in a uint16_t field */
+    const uint8_t Too_Large[] = {0x08, 0x02, 0x10, 0x80, 0x80, 0x04, 0x18, 0x0F};
+    /* Port of 0x100 in a byte-sized enum */
+    const uint8_t Port_Too_Large[] = {0x08, 0x80, 0x02, 0x10, 0x01, 0x18, 0x0F};
+    /* Message cut inside the last varint */
+    const uint8_t Truncated[] = {0x08, 0x02, 0x10, 0x01, 0x18, 0x8F};
+
+    Check_WritePort(Reordered, sizeof(Reordered), true);
+    Check_WritePort(Unknown, sizeof(Unknown), true);
+    Check_WritePort(Repeated, sizeof(Repeated), true);
+    Check_WritePort(Long_Varint, sizeof(Long_Varint), true);
+    Check_WritePort(Missing, sizeof(Missing), false);
+    Check_WritePort(Too_Large, sizeof(Too_Large), false);
+    Check_WritePort(Port_Too_Large, sizeof(Port_Too_Large), false);
+    Check_WritePort(Truncated, sizeof(Truncated), false);
+}
+
+void test_Decode_EveryPrefix_GivesTheResultOfPbDecode(void)
+{
+    Msg_WritePort Port = {Gpio_Port_PORT_H, 0xFFFF, 0x1234};
+    uint32_t Loc_Len = PbFast_Encode_Msg_WritePort(&Port, Buffer);
+    uint32_t Loc_Cut;
+
+    for (Loc_Cut = 0; Loc_Cut < Loc_Len; Loc_Cut++)
+    {
+        Check_WritePort(Buffer, Loc_Cut, false);
+    }
+    Check_WritePort(Buffer, Loc_Len, true);
+}
+
+/* Runs one codec BENCH_MESSAGES times, reports ns/message */
+static void Bench(const char *Ptr_Name, int Variant)
+{
+    struct timespec Start;
+    Msg_WritePort Port = {Gpio_Port_PORT_A, 0x00F0, 0x000F};
+    Msg_WritePort Port_Out;
+    uint8_t Encoded[Msg_WritePort_size];
+    uint32_t Loc_Len = PbFast_Encode_Msg_WritePort(&Port, Encoded);
+    unsigned long Loc_Done;
+    double Loc_Seconds;
+    char Report[96];
+
+    BenchTimer_Start(&Start);
+    for (Loc_Done = 0; Loc_Done < BENCH_MESSAGES; Loc_Done++)
+    {
+        switch (Variant)
+        {
+        case 0:
+            BenchTimer_Sink += Reference_Decode(Msg_WritePort_fields, Encoded, Loc_Len, &Port_Out) ? Port_Out.Set_Mask : 0;
+            break;
+        case 1:
+            BenchTimer_Sink += PbFast_Decode_Msg_WritePort(Encoded, Loc_Len, &Port_Out) ? Port_Out.Set_Mask : 0;
+            break;
+        case 2:
+            {
+                pb_ostream_t Loc_Stream = pb_ostream_from_buffer(Buffer, sizeof(Buffer));
+
+                BenchTimer_Sink += pb_encode(&Loc_Stream, Msg_WritePort_fields, &Port) ? (uint32_t)Loc_Stream.bytes_written : 0;
+            }
+            break;
+        default:
+            BenchTimer_Sink += PbFast_Encode_Msg_WritePort(&Port, Buffer);
+            break;
+        }
+        /* Keeps the message from being hoisted out of the loop */
+        Port.Set_Mask = (uint16_t)Loc_Done;
+        Encoded[4] = (uint8_t)(Loc_Done & 0x7F);
+    }
+    Loc_Seconds = BenchTimer_Elapsed(&Start);
+
+    snprintf(Report, sizeof(Report), "Msg_WritePort %-16s %8.1f ns/message",
+             Ptr_Name, (Loc_Seconds * 1e9) / (double)BENCH_MESSAGES);
+    TEST_MESSAGE(Report);
+}
+
+void test_Benchmark_FastCodecAgainstNanopb(void)
+{
+    Bench("pb_decode", 0);
+    Bench("PbFast_Decode", 1);
+    Bench("pb_encode", 2);
+    Bench("PbFast_Encode", 3);
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_Encode_GivesTheBytesOfPbEncode);
+    RUN_TEST(test_Encode_EdgeValues_MatchPbEncode);
+    RUN_TEST(test_Decode_RoundTripsTheEncoder);
+    RUN_TEST(test_Decode_UnexpectedInput_GivesTheResultOfPbDecode);
+    RUN_TEST(test_Decode_EveryPrefix_GivesTheResultOfPbDecode);
+    RUN_TEST(test_Benchmark_FastCodecAgainstNanopb);
+    return UNITY_END();
+}
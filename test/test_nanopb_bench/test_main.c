@@ -0,0 +1,369 @@
+/*
+ ============================================================================
+ Name        : test_main.c
+ Description : Native nanopb benchmark of every message of message.proto:
+               encode, decode, encoded size and header + body framing, in
+               ns/message, written as JSON for the build variant under test
+ ============================================================================
+ */
+#include <unity.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pb_encode.h>
+#include <pb_decode.h>
+#include "common/BenchTimer.h"
+#include "proto/message.pb.h"
+
+/* Every message of message.pb.h, X(Name, MaxSize) with MaxSize 0 when the schema has no bound */
+#define BENCH_MESSAGES(X)                    \
+    X(ResetPin, Msg_ResetPin_size)           \
+    X(ReadPin, Msg_ReadPin_size)             \
+    X(PinValue, Msg_PinValue_size)           \
+    X(SetPin, Msg_SetPin_size)               \
+    X(TogglePin, Msg_TogglePin_size)         \
+    X(Header, Msg_Header_size)               \
+    X(BatchOp, Msg_BatchOp_size)             \
+    X(Batch, 0)                              \
+    X(BatchResult, Msg_BatchResult_size)     \
+    X(WritePort, Msg_WritePort_size)         \
+    X(ReadPort, Msg_ReadPort_size)           \
+    X(PortValue, Msg_PortValue_size)         \
+    X(GetProfile, Msg_GetProfile_size)       \
+    X(ProbeStats, Msg_ProbeStats_size)       \
+    X(ProfileReport, Msg_ProfileReport_size) \
+    X(SetLinkSpeed, Msg_SetLinkSpeed_size)   \
+    X(LinkSpeedAck, Msg_LinkSpeedAck_size)
+
+/* nanopb options of the build, set for the library and this file alike by the bench envs */
+#ifdef PB_BUFFER_ONLY
+#define BENCH_PB_BUFFER_ONLY    1
+#else
+#define BENCH_PB_BUFFER_ONLY    0
+#endif
+#ifdef PB_NO_ERRMSG
+#define BENCH_PB_NO_ERRMSG      1
+#else
+#define BENCH_PB_NO_ERRMSG      0
+#endif
+#ifdef PB_WITHOUT_64BIT
+#define BENCH_PB_WITHOUT_64BIT  1
+#else
+#define BENCH_PB_WITHOUT_64BIT  0
+#endif
+
+#define BENCH_FRAME_MAX_LEN     1024
+#define BENCH_BATCH_OPS         30      /* About the Msg_Batch of 256 bytes the firmware takes */
+#define BENCH_MIN_RUN_SECONDS   0.02    /* Calibrated run length */
+#define BENCH_RUNS              5       /* The best run is reported */
+#define BENCH_MSG_ID            5       /* Any ID, only the header bytes change */
+
+typedef enum
+{
+    BENCH_ENCODE,
+    BENCH_DECODE,
+    BENCH_ENCODED_SIZE,
+    BENCH_FRAME_LEGACY,   /* Msg_Header then body, sized first with pb_get_encoded_size */
+    BENCH_FRAME_COMPACT,  /* Tag then body as a length-delimited field */
+    BENCH_OP_NUM
+}Bench_Op_t;
+
+static const char *const Bench_Op_Names[BENCH_OP_NUM] =
+{
+    "encode_ns", "decode_ns", "encoded_size_ns", "frame_legacy_ns", "frame_compact_ns"
+};
+
+typedef struct
+{
+    const char *Name;
+    const pb_msgdesc_t *Fields;
+    const void *Sample;
+    uint32_t MaxSize;
+    uint8_t Encoded[BENCH_FRAME_MAX_LEN];
+    size_t EncodedLen;
+}Bench_Case_t;
+
+/* Decode destination of every message */
+static union
+{
+#define X(Name, MaxSize) Msg_##Name Name;
+    BENCH_MESSAGES(X)
+#undef X
+}Decoded;
+
+static uint32_t Batch_OpsDecoded;
+
+/*******************************************************************************
+ *                              Sample messages                                *
+ *******************************************************************************/
+static bool Batch_EncodeOps(pb_ostream_t *stream, const pb_field_t *field, void * const *arg)
+{
+    bool Loc_Status = true;
+    uint32_t Loc_idx;
+
+    for (Loc_idx = 0; (Loc_idx < BENCH_BATCH_OPS) && Loc_Status; Loc_idx++)
+    {
+        Msg_BatchOp Loc_Op = Msg_BatchOp_init_zero;
+
+        Loc_Op.which_Op = (pb_size_t)(Msg_BatchOp_Set_Pin_tag + (Loc_idx % 4));
+        Loc_Op.Op.Set_Pin.Pin_Port = (Gpio_Port)(Loc_idx % 6);
+        Loc_Op.Op.Set_Pin.Pin_Num = (Gpio_Pin)(Loc_idx % 16);
+        Loc_Status = pb_encode_tag_for_field(stream, field) && pb_encode_submessage(stream, Msg_BatchOp_fields, &Loc_Op);
+    }
+
+    return Loc_Status;
+}
+
+static bool Batch_DecodeOp(pb_istream_t *stream, const pb_field_t *field, void **arg)
+{
+    Msg_BatchOp Loc_Op = Msg_BatchOp_init_zero;
+
+    Batch_OpsDecoded++;
+    return pb_decode(stream, Msg_BatchOp_fields, &Loc_Op);
+}
+
+static Msg_ResetPin Sample_ResetPin = {Gpio_Port_PORT_C, Gpio_Pin_PIN_13};
+static Msg_ReadPin Sample_ReadPin = {Gpio_Port_PORT_A, Gpio_Pin_PIN_0};
+static Msg_PinValue Sample_PinValue = {Gpio_Port_PORT_A, Gpio_Pin_PIN_0, Gpio_PinState_STATE_HIGH};
+static Msg_SetPin Sample_SetPin = {Gpio_Port_PORT_C, Gpio_Pin_PIN_13};
+static Msg_TogglePin Sample_TogglePin = {Gpio_Port_PORT_B, Gpio_Pin_PIN_5};
+static Msg_Header Sample_Header = {BENCH_MSG_ID, 6};
+static Msg_BatchOp Sample_BatchOp = {Msg_BatchOp_Toggle_Pin_tag, {{Gpio_Port_PORT_B, Gpio_Pin_PIN_5}}};
+static Msg_Batch Sample_Batch = {{{.encode = Batch_EncodeOps}, NULL}};
+static Msg_BatchResult Sample_BatchResult;
+static Msg_WritePort Sample_WritePort = {Gpio_Port_PORT_B, 0x00F0, 0x000F};
+static Msg_ReadPort Sample_ReadPort = {Gpio_Port_PORT_A};
+static Msg_PortValue Sample_PortValue = {Gpio_Port_PORT_A, 0x8421};
+static Msg_GetProfile Sample_GetProfile = {true};
+static Msg_ProbeStats Sample_ProbeStats = {3, 1200, 180, 2400, 310};
+static Msg_ProfileReport Sample_ProfileReport;
+static Msg_SetLinkSpeed Sample_SetLinkSpeed = {921600};
+static Msg_LinkSpeedAck Sample_LinkSpeedAck = {true, 921600, -1234};
+
+static Bench_Case_t Cases[] =
+{
+#define X(Name, MaxSize) {"Msg_" #Name, Msg_##Name##_fields, &Sample_##Name, MaxSize, {0}, 0},
+    BENCH_MESSAGES(X)
+#undef X
+};
+
+#define BENCH_CASE_NUM (sizeof(Cases) / sizeof(Cases[0]))
+
+static void Samples_Init(void)
+{
+    uint32_t Loc_idx;
+
+    /* Full repeated fields, the largest reply of each kind */
+    Sample_BatchResult.Ops_Done = BENCH_BATCH_OPS;
+    Sample_BatchResult.Reads_count = pb_arraysize(Msg_BatchResult, Reads);
+    for (Loc_idx = 0; Loc_idx < Sample_BatchResult.Reads_count; Loc_idx++)
+    {
+        Sample_BatchResult.Reads[Loc_idx].Pin_Port = (Gpio_Port)(Loc_idx % 6);
+        Sample_BatchResult.Reads[Loc_idx].Pin_Num = (Gpio_Pin)Loc_idx;
+        Sample_BatchResult.Reads[Loc_idx].Pin_Read = (Gpio_PinState)(Loc_idx & 1);
+    }
+    Sample_ProfileReport.Core_Clock = 84000000;
+    Sample_ProfileReport.Probes_count = pb_arraysize(Msg_ProfileReport, Probes);
+    for (Loc_idx = 0; Loc_idx < Sample_ProfileReport.Probes_count; Loc_idx++)
+    {
+        Sample_ProfileReport.Probes[Loc_idx].Probe = Loc_idx;
+        Sample_ProfileReport.Probes[Loc_idx].Count = 1000 + (Loc_idx * 37);
+        Sample_ProfileReport.Probes[Loc_idx].Min = 90 + Loc_idx;
+        Sample_ProfileReport.Probes[Loc_idx].Max = 40000 + (Loc_idx * 1000);
+        Sample_ProfileReport.Probes[Loc_idx].Mean = 400 + (Loc_idx * 10);
+    }
+}
+
+/*******************************************************************************
+ *                                 Benchmark                                   *
+ *******************************************************************************/
+/* Runs Op once on Case, returns a value depending on the result so that it is not optimised away */
+static uint32_t Bench_Once(Bench_Op_t Op, const Bench_Case_t *Ptr_Case)
+{
+    static uint8_t Frame[BENCH_FRAME_MAX_LEN];
+    pb_ostream_t Loc_Out = pb_ostream_from_buffer(Frame, sizeof(Frame));
+    uint32_t Loc_Result = 0;
+
+    switch (Op)
+    {
+    case BENCH_ENCODE:
+        Loc_Result = pb_encode(&Loc_Out, Ptr_Case->Fields, Ptr_Case->Sample) ? (uint32_t)Loc_Out.bytes_written : 0;
+        break;
+    case BENCH_DECODE:
+        {
+            pb_istream_t Loc_In = pb_istream_from_buffer(Ptr_Case->Encoded, Ptr_Case->EncodedLen);
+
+            /* pb_decode keeps the callbacks of the destination */
+            Decoded.Batch.Ops.funcs.decode = Batch_DecodeOp;
+            Loc_Result = pb_decode(&Loc_In, Ptr_Case->Fields, &Decoded) ? 1U : 0U;
+        }
+        break;
+    case BENCH_ENCODED_SIZE:
+        {
+            size_t Loc_Size = 0;
+
+            Loc_Result = pb_get_encoded_size(&Loc_Size, Ptr_Case->Fields, Ptr_Case->Sample) ? (uint32_t)Loc_Size : 0;
+        }
+        break;
+    case BENCH_FRAME_LEGACY:
+        {
+            Msg_Header Loc_Header = {BENCH_MSG_ID, 0};
+            size_t Loc_Size = 0;
+
+            if (pb_get_encoded_size(&Loc_Size, Ptr_Case->Fields, Ptr_Case->Sample))
+            {
+                Loc_Header.msg_len = (uint32_t)Loc_Size;
+                Loc_Result = (pb_encode(&Loc_Out, Msg_Header_fields, &Loc_Header) &&
+                              pb_encode(&Loc_Out, Ptr_Case->Fields, Ptr_Case->Sample)) ? (uint32_t)Loc_Out.bytes_written : 0;
+            }
+        }
+        break;
+    default:
+        Loc_Result = (pb_encode_tag(&Loc_Out, PB_WT_STRING, BENCH_MSG_ID + 1) &&
+                      pb_encode_submessage(&Loc_Out, Ptr_Case->Fields, Ptr_Case->Sample)) ? (uint32_t)Loc_Out.bytes_written : 0;
+        break;
+    }
+
+    return Loc_Result;
+}
+
+/* Times Count runs of Op, returns the seconds taken */
+static double Bench_Run(Bench_Op_t Op, const Bench_Case_t *Ptr_Case, unsigned long Count)
+{
+    struct timespec Start;
+    unsigned long Loc_Done;
+
+    BenchTimer_Start(&Start);
+    for (Loc_Done = 0; Loc_Done < Count; Loc_Done++)
+    {
+        BenchTimer_Sink += Bench_Once(Op, Ptr_Case);
+    }
+
+    return BenchTimer_Elapsed(&Start);
+}
+
+/* Best ns/message of BENCH_RUNS runs, each one long enough for the clock */
+static double Bench_Ns(Bench_Op_t Op, const Bench_Case_t *Ptr_Case)
+{
+    unsigned long Loc_Count = 1000;
+    double Loc_Best;
+    uint32_t Loc_Run;
+
+    while (Bench_Run(Op, Ptr_Case, Loc_Count) < BENCH_MIN_RUN_SECONDS)
+    {
+        Loc_Count *= 2;
+    }
+    Loc_Best = Bench_Run(Op, Ptr_Case, Loc_Count);
+    for (Loc_Run = 1; Loc_Run < BENCH_RUNS; Loc_Run++)
+    {
+        double Loc_Seconds = Bench_Run(Op, Ptr_Case, Loc_Count);
+
+        Loc_Best = (Loc_Seconds < Loc_Best) ? Loc_Seconds : Loc_Best;
+    }
+
+    return (Loc_Best * 1e9) / (double)Loc_Count;
+}
+
+/* Name of the build variant, the nanopb options joined by '+' */
+static const char *Bench_Variant(void)
+{
+    static char Name[64];
+
+    snprintf(Name, sizeof(Name), "%s%s%s",
+           BENCH_PB_BUFFER_ONLY ? "+buffer_only" : "",
+           BENCH_PB_NO_ERRMSG ? "+no_errmsg" : "",
+           BENCH_PB_WITHOUT_64BIT ? "+without_64bit" : "");
+
+    return (Name[0] != '\0') ? &Name[1] : "default";
+}
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_EveryMessage_EncodesDecodesAndFrames(void)
+{
+    uint32_t Loc_idx;
+
+    for (Loc_idx = 0; Loc_idx < BENCH_CASE_NUM; Loc_idx++)
+    {
+        Bench_Case_t *Ptr_Case = &Cases[Loc_idx];
+        pb_ostream_t Loc_Out = pb_ostream_from_buffer(Ptr_Case->Encoded, sizeof(Ptr_Case->Encoded));
+        size_t Loc_Size = 0;
+
+        TEST_ASSERT_TRUE_MESSAGE(pb_encode(&Loc_Out, Ptr_Case->Fields, Ptr_Case->Sample), Ptr_Case->Name);
+        Ptr_Case->EncodedLen = Loc_Out.bytes_written;
+        TEST_ASSERT_TRUE_MESSAGE((Ptr_Case->MaxSize == 0) || (Ptr_Case->EncodedLen <= Ptr_Case->MaxSize), Ptr_Case->Name);
+        TEST_ASSERT_TRUE(pb_get_encoded_size(&Loc_Size, Ptr_Case->Fields, Ptr_Case->Sample));
+        TEST_ASSERT_EQUAL_UINT32(Ptr_Case->EncodedLen, Loc_Size);
+
+        Batch_OpsDecoded = 0;
+        TEST_ASSERT_NOT_EQUAL_MESSAGE(0, Bench_Once(BENCH_DECODE, Ptr_Case), Ptr_Case->Name);
+        TEST_ASSERT_EQUAL_UINT32(Msg_Header_size + Ptr_Case->EncodedLen, Bench_Once(BENCH_FRAME_LEGACY, Ptr_Case));
+        TEST_ASSERT_NOT_EQUAL(0, Bench_Once(BENCH_FRAME_COMPACT, Ptr_Case));
+    }
+    TEST_ASSERT_EQUAL_UINT32(BENCH_BATCH_OPS, Batch_OpsDecoded);
+}
+
+void test_Benchmark_WritesJson(void)
+{
+    const char *Ptr_Path = getenv("NANOPB_BENCH_JSON");
+    char Default_Path[96];
+    char Report[256];
+    FILE *Ptr_File;
+    uint32_t Loc_idx;
+    uint32_t Loc_Op;
+
+    if (Ptr_Path == NULL)
+    {
+        snprintf(Default_Path, sizeof(Default_Path), "nanopb_bench_%s.json", Bench_Variant());
+        Ptr_Path = Default_Path;
+    }
+    Ptr_File = fopen(Ptr_Path, "w");
+    TEST_ASSERT_NOT_NULL_MESSAGE(Ptr_File, Ptr_Path);
+
+    fprintf(Ptr_File, "{\n  \"benchmark\": \"nanopb\",\n  \"variant\": \"%s\",\n", Bench_Variant());
+    fprintf(Ptr_File, "  \"options\": {\"PB_BUFFER_ONLY\": %s, \"PB_NO_ERRMSG\": %s, \"PB_WITHOUT_64BIT\": %s},\n",
+                    BENCH_PB_BUFFER_ONLY ? "true" : "false", BENCH_PB_NO_ERRMSG ? "true" : "false",
+                    BENCH_PB_WITHOUT_64BIT ? "true" : "false");
+    fprintf(Ptr_File, "  \"compiler\": \"%s\",\n  \"messages\": [\n", __VERSION__);
+    for (Loc_idx = 0; Loc_idx < BENCH_CASE_NUM; Loc_idx++)
+    {
+        const Bench_Case_t *Ptr_Case = &Cases[Loc_idx];
+        double Loc_Ns[BENCH_OP_NUM];
+
+        for (Loc_Op = 0; Loc_Op < BENCH_OP_NUM; Loc_Op++)
+        {
+            Loc_Ns[Loc_Op] = Bench_Ns((Bench_Op_t)Loc_Op, Ptr_Case);
+        }
+        fprintf(Ptr_File, "    {\"name\": \"%s\", \"encoded_len\": %u", Ptr_Case->Name, (unsigned)Ptr_Case->EncodedLen);
+        for (Loc_Op = 0; Loc_Op < BENCH_OP_NUM; Loc_Op++)
+        {
+            fprintf(Ptr_File, ", \"%s\": %.1f", Bench_Op_Names[Loc_Op], Loc_Ns[Loc_Op]);
+        }
+        fprintf(Ptr_File, "}%s\n", (Loc_idx + 1 < BENCH_CASE_NUM) ? "," : "");
+
+        snprintf(Report, sizeof(Report), "%-18s %4u B  encode %7.1f  decode %7.1f  size %7.1f  frame %7.1f / %7.1f ns",
+             Ptr_Case->Name, (unsigned)Ptr_Case->EncodedLen, Loc_Ns[BENCH_ENCODE], Loc_Ns[BENCH_DECODE],
+             Loc_Ns[BENCH_ENCODED_SIZE], Loc_Ns[BENCH_FRAME_LEGACY], Loc_Ns[BENCH_FRAME_COMPACT]);
+        TEST_MESSAGE(Report);
+    }
+    fprintf(Ptr_File, "  ]\n}\n");
+    TEST_ASSERT_EQUAL(0, fclose(Ptr_File));
+
+    snprintf(Report, sizeof(Report), "Results of variant %s written to %s", Bench_Variant(), Ptr_Path);
+    TEST_MESSAGE(Report);
+}
+
+int main(int argc, char **argv)
+{
+    Samples_Init();
+    UNITY_BEGIN();
+    RUN_TEST(test_EveryMessage_EncodesDecodesAndFrames);
+    RUN_TEST(test_Benchmark_WritesJson);
+    return UNITY_END();
+}
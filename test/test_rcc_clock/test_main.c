@@ -0,0 +1,106 @@
+/*
+ ============================================================================
+ Name        : test_main.c
+ Description : Native tests for the RCC bus frequency queries and the USART
+               baud rate divisors derived from them
+ ============================================================================
+ */
+#include <unity.h>
+#include <string.h>
+#include "LIB/Stm32F401cc.h"
+#include "MCAL/RCC/RCC.h"
+#include "MCAL/UART/USART.h"
+
+#define REG(Address) (*(volatile uint32_t *)PERIPHERAL_ADDRESS(Address))
+
+#define RCC_PLLCFGR 0x40023804UL
+#define RCC_CFGR    0x40023808UL
+#define USART1_BRR  0x40011008UL
+#define USART2_BRR  0x40004408UL
+
+/* SW and SWS of CFGR for a source, hardware copies SW into SWS once the switch is done */
+#define CFGR_RUNNING(SysClk) ((SysClk) | ((SysClk) << 2))
+
+/* Boot clock: PLL from HSI, M16 N336 P4 Q7, APB1 / 2 */
+static void Run_From_PLL_84MHz(void)
+{
+    TEST_ASSERT_EQUAL(Status_enumOk, RCC_Config_PLLParamters(16, 336, 4, 7));
+    REG(RCC_CFGR) = CFGR_RUNNING(SysClk_PLL_MASK) | AHB_1 | APB_L_2 | APB_H_1;
+}
+
+void setUp(void)
+{
+    memset(Sim_PeripheralMemory, 0, sizeof(Sim_PeripheralMemory));
+}
+
+void tearDown(void)
+{
+}
+
+void test_Reset_RunsFromHSI(void)
+{
+    TEST_ASSERT_EQUAL_UINT32(16000000UL, RCC_Get_SysclkFrequency());
+    TEST_ASSERT_EQUAL_UINT32(16000000UL, RCC_Get_AHB_Frequency());
+    TEST_ASSERT_EQUAL_UINT32(16000000UL, RCC_Get_APB1_Frequency());
+    TEST_ASSERT_EQUAL_UINT32(16000000UL, RCC_Get_APB2_Frequency());
+}
+
+void test_PLL_BootClockIs84MHz(void)
+{
+    Run_From_PLL_84MHz();
+
+    TEST_ASSERT_EQUAL_UINT32(84000000UL, RCC_Get_SysclkFrequency());
+    TEST_ASSERT_EQUAL_UINT32(84000000UL, RCC_Get_AHB_Frequency());
+    TEST_ASSERT_EQUAL_UINT32(42000000UL, RCC_Get_APB1_Frequency());
+    TEST_ASSERT_EQUAL_UINT32(84000000UL, RCC_Get_APB2_Frequency());
+}
+
+void test_Prescalers_DivideTheBuses(void)
+{
+    REG(RCC_CFGR) = CFGR_RUNNING(SysClk_HSE_MASK) | AHB_64 | APB_L_16 | APB_H_4;
+
+    TEST_ASSERT_EQUAL_UINT32(25000000UL, RCC_Get_SysclkFrequency());
+    TEST_ASSERT_EQUAL_UINT32(25000000UL / 64, RCC_Get_AHB_Frequency());
+    TEST_ASSERT_EQUAL_UINT32(25000000UL / 64 / 16, RCC_Get_APB1_Frequency());
+    TEST_ASSERT_EQUAL_UINT32(25000000UL / 64 / 4, RCC_Get_APB2_Frequency());
+}
+
+void test_PLLParameters_KeepTheSource(void)
+{
+    TEST_ASSERT_EQUAL(Status_enumOk, RCC_Config_PLLSrc(PLL_SRC_HSE));
+    TEST_ASSERT_EQUAL(Status_enumOk, RCC_Config_PLLParamters(25, 336, 4, 7));
+    REG(RCC_CFGR) = CFGR_RUNNING(SysClk_PLL_MASK);
+
+    TEST_ASSERT_BITS_HIGH(PLL_SRC_HSE, REG(RCC_PLLCFGR));
+    TEST_ASSERT_EQUAL_UINT32(84000000UL, RCC_Get_SysclkFrequency());
+}
+
+void test_SelectSysclk_FailsWhenTheSwitchIsNotReported(void)
+{
+    /* Nothing copies SW into SWS in the register block */
+    TEST_ASSERT_EQUAL(Status_enumNotOk, RCC_Select_Sysclk(SysClk_PLL_MASK));
+    TEST_ASSERT_EQUAL_UINT32(16000000UL, RCC_Get_SysclkFrequency());
+}
+
+void test_USARTInit_DerivesBRRFromTheBusClock(void)
+{
+    Run_From_PLL_84MHz();
+
+    TEST_ASSERT_EQUAL(Status_enumOk, USART_Init());
+
+    /* 9600 baud: USARTDIV = 84 MHz / (16 * 9600) = 546.875, 42 MHz / (16 * 9600) = 273.4375 */
+    TEST_ASSERT_EQUAL_HEX32((546 << 4) | 14, REG(USART1_BRR));
+    TEST_ASSERT_EQUAL_HEX32((273 << 4) | 7, REG(USART2_BRR));
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_Reset_RunsFromHSI);
+    RUN_TEST(test_PLL_BootClockIs84MHz);
+    RUN_TEST(test_Prescalers_DivideTheBuses);
+    RUN_TEST(test_PLLParameters_KeepTheSource);
+    RUN_TEST(test_SelectSysclk_FailsWhenTheSwitchIsNotReported);
+    RUN_TEST(test_USARTInit_DerivesBRRFromTheBusClock);
+    return UNITY_END();
+}
@@ -0,0 +1,170 @@
+/*
+ ============================================================================
+ Name        : test_main.c
+ Description : Native tests for the SPSC byte ring, including a two thread
+               stress run that checks ordering and reports throughput
+ ============================================================================
+ */
+#include <unity.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <time.h>
+#include "LIB/RingBuffer.h"
+
+#define STRESS_RING_SIZE  1024
+#define STRESS_TOTAL      (16UL * 1024UL * 1024UL)
+#define STRESS_MAX_BLOCK  37
+
+static RingBuffer_t Ring;
+static uint8_t Storage[STRESS_RING_SIZE];
+static uint32_t ConsumerErrors;
+
+void setUp(void)
+{
+    TEST_ASSERT_EQUAL(Status_enumOk, RingBuffer_Init(&Ring, Storage, sizeof(Storage)));
+}
+
+void tearDown(void)
+{
+}
+
+void test_Init_RejectsSizeThatIsNotPowerOfTwo(void)
+{
+    TEST_ASSERT_EQUAL(Status_enumWrongInput, RingBuffer_Init(&Ring, Storage, 1000));
+    TEST_ASSERT_EQUAL(Status_enumNULLPointer, RingBuffer_Init(&Ring, NULL, 1024));
+}
+
+void test_Write_IsAllOrNothing(void)
+{
+    static uint8_t Block[STRESS_RING_SIZE];
+
+    TEST_ASSERT_EQUAL(Status_enumOk, RingBuffer_Write(&Ring, Block, STRESS_RING_SIZE - 4));
+    TEST_ASSERT_EQUAL(Status_enumBusyState, RingBuffer_Write(&Ring, Block, 5));
+    TEST_ASSERT_EQUAL_UINT32(STRESS_RING_SIZE - 4, RingBuffer_GetUsed(&Ring));
+    TEST_ASSERT_EQUAL(Status_enumOk, RingBuffer_Write(&Ring, Block, 4));
+    TEST_ASSERT_EQUAL_UINT32(0, RingBuffer_GetFree(&Ring));
+}
+
+void test_ReadAndPeek_FollowTheWrapAround(void)
+{
+    uint8_t In[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+    uint8_t Out[8] = {0};
+    static uint8_t Fill[STRESS_RING_SIZE];
+    uint8_t *Ptr_Data = NULL;
+
+    /* Move the indices close to the end of the storage */
+    RingBuffer_Write(&Ring, Fill, STRESS_RING_SIZE - 3);
+    RingBuffer_Read(&Ring, Fill, STRESS_RING_SIZE);
+
+    TEST_ASSERT_EQUAL(Status_enumOk, RingBuffer_Write(&Ring, In, sizeof(In)));
+    /* Only the part before the end of the storage is contiguous */
+    TEST_ASSERT_EQUAL_UINT32(3, RingBuffer_Peek(&Ring, &Ptr_Data));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(In, Ptr_Data, 3);
+    RingBuffer_Consume(&Ring, 3);
+    TEST_ASSERT_EQUAL_UINT32(5, RingBuffer_Peek(&Ring, &Ptr_Data));
+    TEST_ASSERT_EQUAL_PTR(Storage, Ptr_Data);
+
+    TEST_ASSERT_EQUAL_UINT32(5, RingBuffer_Read(&Ring, Out, sizeof(Out)));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(&In[3], Out, 5);
+}
+
+static void *Producer(void *Arg)
+{
+    uint8_t Block[STRESS_MAX_BLOCK];
+    uint8_t Next = 0;
+    uint32_t Sent = 0;
+    uint32_t Len = 1;
+
+    (void)Arg;
+    while (Sent < STRESS_TOTAL)
+    {
+        if (Len > (STRESS_TOTAL - Sent))
+        {
+            Len = STRESS_TOTAL - Sent;
+        }
+        for (uint32_t i = 0; i < Len; i++)
+        {
+            Block[i] = (uint8_t)(Next + i);
+        }
+        /* Never blocks, a full ring is simply retried */
+        if (RingBuffer_Write(&Ring, Block, Len) == Status_enumOk)
+        {
+            Next = (uint8_t)(Next + Len);
+            Sent += Len;
+            Len = (Len % STRESS_MAX_BLOCK) + 1;
+        }
+        else
+        {
+            /* Let the consumer run when both share a core */
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+static void *Consumer(void *Arg)
+{
+    uint8_t Chunk[STRESS_MAX_BLOCK + 16];
+    uint8_t Expected = 0;
+    uint32_t Received = 0;
+    uint32_t MaxLen = 1;
+
+    (void)Arg;
+    while (Received < STRESS_TOTAL)
+    {
+        uint32_t Len = RingBuffer_Read(&Ring, Chunk, MaxLen);
+
+        for (uint32_t i = 0; i < Len; i++)
+        {
+            if (Chunk[i] != Expected)
+            {
+                ConsumerErrors++;
+            }
+            Expected++;
+        }
+        Received += Len;
+        MaxLen = (MaxLen % sizeof(Chunk)) + 1;
+        if (Len == 0)
+        {
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+void test_Stress_ProducerAndConsumerThreads(void)
+{
+    pthread_t ProducerThread;
+    pthread_t ConsumerThread;
+    struct timespec Start;
+    struct timespec End;
+    double Seconds;
+    char Report[96];
+
+    ConsumerErrors = 0;
+    clock_gettime(CLOCK_MONOTONIC, &Start);
+    pthread_create(&ConsumerThread, NULL, Consumer, NULL);
+    pthread_create(&ProducerThread, NULL, Producer, NULL);
+    pthread_join(ProducerThread, NULL);
+    pthread_join(ConsumerThread, NULL);
+    clock_gettime(CLOCK_MONOTONIC, &End);
+
+    Seconds = (double)(End.tv_sec - Start.tv_sec) + ((double)(End.tv_nsec - Start.tv_nsec) / 1e9);
+    snprintf(Report, sizeof(Report), "SPSC ring: %lu bytes in %.3f s, %.1f MB/s",
+             STRESS_TOTAL, Seconds, ((double)STRESS_TOTAL / 1e6) / Seconds);
+    TEST_MESSAGE(Report);
+
+    TEST_ASSERT_EQUAL_UINT32(0, ConsumerErrors);
+    TEST_ASSERT_EQUAL_UINT32(0, RingBuffer_GetUsed(&Ring));
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_Init_RejectsSizeThatIsNotPowerOfTwo);
+    RUN_TEST(test_Write_IsAllOrNothing);
+    RUN_TEST(test_ReadAndPeek_FollowTheWrapAround);
+    RUN_TEST(test_Stress_ProducerAndConsumerThreads);
+    return UNITY_END();
+}
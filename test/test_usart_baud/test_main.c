@@ -0,0 +1,230 @@
+/*
+ ============================================================================
+ Name        : test_main.c
+ Description : Native tests for the USART baud rate solver, sweeping the
+               standard rates at the clocks the USARTs run from
+ ============================================================================
+ */
+#include <unity.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include "LIB/Stm32F401cc.h"
+#include "MCAL/RCC/RCC.h"
+#include "MCAL/UART/USART.h"
+#include "MCAL/UART/USART_Cfg.h"
+
+#define REG(Address) (*(volatile uint32_t *)PERIPHERAL_ADDRESS(Address))
+
+#define RCC_PLLCFGR 0x40023804UL
+#define RCC_CFGR    0x40023808UL
+#define USART1_SR   0x40011000UL
+#define USART1_BRR  0x40011008UL
+#define USART1_CR1  0x4001100CUL
+#define USART2_BRR  0x40004408UL
+
+#define CR1_UE      0x2000UL
+#define CR1_OVER8   0x8000UL
+#define SR_TC       0x40UL
+
+#define CFGR_RUNNING(SysClk) ((SysClk) | ((SysClk) << 2))
+
+static const uint32_t Clocks[] = {16000000UL, 42000000UL, 84000000UL};
+static const uint32_t BaudRates[] = {9600, 14400, 19200, 38400, 57600, 115200, 230400, 460800, 921600,
+                                     1000000, 1500000, 2000000, 3000000, 4000000, 5250000, 10500000};
+
+/* Clock periods per bit encoded in a BRR value, decoded the way the reference manual does */
+static uint32_t Decode_Divider(uint32_t BRR, uint32_t OverSampling)
+{
+    return (OverSampling == USART_OVS_8) ? (((BRR >> 4) << 3) | (BRR & 0x7)) : BRR;
+}
+
+static int32_t Error_PPM(uint32_t Clock, uint32_t BaudRate, uint32_t Divider)
+{
+    double Actual = (double)Clock / Divider;
+    double Error = (Actual - BaudRate) * 1e6 / BaudRate;
+
+    return (int32_t)(Error < 0 ? Error - 0.5 : Error + 0.5);
+}
+
+/* Smallest error any divider of the oversampling mode reaches, by trying them all */
+static int32_t Best_Error_PPM(uint32_t Clock, uint32_t BaudRate, uint32_t OverSampling)
+{
+    uint32_t Min = (OverSampling == USART_OVS_8) ? 8 : 16;
+    uint32_t Max = (OverSampling == USART_OVS_8) ? 0x7FFF : 0xFFFF;
+    int32_t Best = INT32_MAX;
+    uint32_t Divider;
+
+    for (Divider = Min; Divider <= Max; Divider++)
+    {
+        int32_t Error = Error_PPM(Clock, BaudRate, Divider);
+        if (abs(Error) < abs(Best))
+        {
+            Best = Error;
+        }
+    }
+    return Best;
+}
+
+void setUp(void)
+{
+    memset(Sim_PeripheralMemory, 0, sizeof(Sim_PeripheralMemory));
+}
+
+void tearDown(void)
+{
+}
+
+void test_Sweep_ReportsTheErrorOfTheProgrammedDivider(void)
+{
+    USART_BaudInfo_t Info;
+    uint8_t Clock;
+    uint8_t Baud;
+
+    for (Clock = 0; Clock < sizeof(Clocks) / sizeof(Clocks[0]); Clock++)
+    {
+        for (Baud = 0; Baud < sizeof(BaudRates) / sizeof(BaudRates[0]); Baud++)
+        {
+            Error_enumStatus_t Status = USART_CalcBaudRate(Clocks[Clock], BaudRates[Baud], USART_OVS_AUTO, &Info);
+            uint32_t Divider = Decode_Divider(Info.BRR, Info.OverSampling);
+            int32_t Best = Best_Error_PPM(Clocks[Clock], BaudRates[Baud], USART_OVS_16);
+            int32_t Best8 = Best_Error_PPM(Clocks[Clock], BaudRates[Baud], USART_OVS_8);
+            char Message[48];
+
+            snprintf(Message, sizeof(Message), "%lu Hz %lu baud", (unsigned long)Clocks[Clock], (unsigned long)BaudRates[Baud]);
+            if (abs(Best8) < abs(Best))
+            {
+                Best = Best8;
+            }
+            /* The reported error matches the register value and no divider does better */
+            TEST_ASSERT_INT32_WITHIN_MESSAGE(1, Error_PPM(Clocks[Clock], BaudRates[Baud], Divider), Info.ErrorPPM, Message);
+            TEST_ASSERT_INT32_WITHIN_MESSAGE(1, abs(Best), abs(Info.ErrorPPM), Message);
+            TEST_ASSERT_UINT32_WITHIN_MESSAGE(1, Clocks[Clock] / Divider, Info.ActualBaudRate, Message);
+            /* OVER8 only when OVER16 can't reach the same error */
+            if (Info.OverSampling == USART_OVS_8)
+            {
+                TEST_ASSERT_TRUE_MESSAGE(0 == (Info.BRR & 0x8), Message);
+                TEST_ASSERT_TRUE_MESSAGE(abs(Best_Error_PPM(Clocks[Clock], BaudRates[Baud], USART_OVS_16)) > abs(Info.ErrorPPM), Message);
+            }
+            /* Rejected exactly when no divider is within the threshold */
+            TEST_ASSERT_EQUAL_MESSAGE((abs(Best) > USART_BAUD_MAX_ERROR_PPM) ? Status_enumWrongInput : Status_enumOk, Status, Message);
+        }
+    }
+}
+
+void test_StandardRates_AtTheBootClock(void)
+{
+    USART_BaudInfo_t Info;
+
+    TEST_ASSERT_EQUAL(Status_enumOk, USART_CalcBaudRate(84000000UL, 9600, USART_OVS_AUTO, &Info));
+    TEST_ASSERT_EQUAL_HEX32(0x222E, Info.BRR);
+    TEST_ASSERT_EQUAL_HEX32(USART_OVS_16, Info.OverSampling);
+    TEST_ASSERT_EQUAL_INT32(0, Info.ErrorPPM);
+
+    TEST_ASSERT_EQUAL(Status_enumOk, USART_CalcBaudRate(84000000UL, 115200, USART_OVS_AUTO, &Info));
+    /* 84 MHz / 115200 = 729.17 */
+    TEST_ASSERT_EQUAL_HEX32(729, Info.BRR);
+    TEST_ASSERT_EQUAL_INT32(229, Info.ErrorPPM);
+    TEST_ASSERT_EQUAL_UINT32(115226, Info.ActualBaudRate);
+
+    /* 84 MHz / 10.5 Mbaud = 8 clock periods per bit, only OVER8 gets there */
+    TEST_ASSERT_EQUAL(Status_enumOk, USART_CalcBaudRate(84000000UL, 10500000UL, USART_OVS_AUTO, &Info));
+    TEST_ASSERT_EQUAL_HEX32(USART_OVS_8, Info.OverSampling);
+    TEST_ASSERT_EQUAL_HEX32(0x10, Info.BRR);
+    TEST_ASSERT_EQUAL_INT32(0, Info.ErrorPPM);
+}
+
+void test_ForcedOverSampling_RejectsUnreachableRates(void)
+{
+    USART_BaudInfo_t Info;
+
+    /* OVER16 tops out at 84 MHz / 16 = 5.25 Mbaud */
+    TEST_ASSERT_EQUAL(Status_enumOk, USART_CalcBaudRate(84000000UL, 5250000UL, USART_OVS_16, &Info));
+    TEST_ASSERT_EQUAL_HEX32(16, Info.BRR);
+    TEST_ASSERT_EQUAL(Status_enumWrongInput, USART_CalcBaudRate(84000000UL, 10500000UL, USART_OVS_16, &Info));
+    TEST_ASSERT_EQUAL_HEX32(16, Info.BRR);
+    TEST_ASSERT_EQUAL_INT32(-500000, Info.ErrorPPM);
+
+    /* Below 16 MHz / 0xFFFF OVER16 runs out of divider, OVER8 even sooner */
+    TEST_ASSERT_EQUAL(Status_enumOk, USART_CalcBaudRate(16000000UL, 300, USART_OVS_AUTO, &Info));
+    TEST_ASSERT_EQUAL(Status_enumWrongInput, USART_CalcBaudRate(16000000UL, 300, USART_OVS_8, &Info));
+}
+
+void test_InvalidArguments(void)
+{
+    USART_BaudInfo_t Info;
+
+    TEST_ASSERT_EQUAL(Status_enumNULLPointer, USART_CalcBaudRate(84000000UL, 9600, USART_OVS_AUTO, NULL));
+    TEST_ASSERT_EQUAL(Status_enumWrongInput, USART_CalcBaudRate(84000000UL, 0, USART_OVS_AUTO, &Info));
+    TEST_ASSERT_EQUAL(Status_enumWrongInput, USART_CalcBaudRate(0, 9600, USART_OVS_AUTO, &Info));
+    TEST_ASSERT_EQUAL(Status_enumWrongInput, USART_CalcBaudRate(84000000UL, 9600, 0x1234, &Info));
+    TEST_ASSERT_EQUAL(Status_enumNULLPointer, USART_GetBaudInfo(USART1_ID, NULL));
+    TEST_ASSERT_EQUAL(Status_enumWrongInput, USART_GetBaudInfo(USART6_ID + 1, &Info));
+}
+
+void test_USARTInit_RecordsTheProgrammedBaudRate(void)
+{
+    USART_BaudInfo_t Info;
+
+    TEST_ASSERT_EQUAL(Status_enumOk, RCC_Config_PLLParamters(16, 336, 4, 7));
+    REG(RCC_CFGR) = CFGR_RUNNING(SysClk_PLL_MASK) | AHB_1 | APB_L_2 | APB_H_1;
+
+    TEST_ASSERT_EQUAL(Status_enumOk, USART_Init());
+
+    TEST_ASSERT_EQUAL(Status_enumOk, USART_GetBaudInfo(USART1_ID, &Info));
+    TEST_ASSERT_EQUAL_HEX32(REG(USART1_BRR), Info.BRR);
+    TEST_ASSERT_EQUAL_HEX32(0x222E, Info.BRR);
+    TEST_ASSERT_EQUAL_UINT32(9600, Info.ActualBaudRate);
+    TEST_ASSERT_BITS_HIGH(CR1_UE, REG(USART1_CR1));
+    TEST_ASSERT_BITS_LOW(CR1_OVER8, REG(USART1_CR1));
+
+    TEST_ASSERT_EQUAL(Status_enumOk, USART_GetBaudInfo(USART2_ID, &Info));
+    TEST_ASSERT_EQUAL_HEX32(REG(USART2_BRR), Info.BRR);
+    TEST_ASSERT_EQUAL_HEX32(0x1117, Info.BRR);
+}
+
+void test_SetBaudRate_WaitsForTheLastFrameToLeave(void)
+{
+    USART_BaudInfo_t Info;
+
+    TEST_ASSERT_EQUAL(Status_enumOk, RCC_Config_PLLParamters(16, 336, 4, 7));
+    REG(RCC_CFGR) = CFGR_RUNNING(SysClk_PLL_MASK) | AHB_1 | APB_L_2 | APB_H_1;
+    TEST_ASSERT_EQUAL(Status_enumOk, USART_Init());
+
+    /* TC clear, a frame is still being shifted out */
+    TEST_ASSERT_EQUAL(Status_enumBusyState, USART_SetBaudRate(USART1_ID, 921600));
+    TEST_ASSERT_EQUAL_HEX32(0x222E, REG(USART1_BRR));
+
+    REG(USART1_SR) = SR_TC;
+    TEST_ASSERT_EQUAL(Status_enumOk, USART_SetBaudRate(USART1_ID, 921600));
+    TEST_ASSERT_EQUAL_HEX32(91, REG(USART1_BRR));
+    TEST_ASSERT_BITS_HIGH(CR1_UE, REG(USART1_CR1));
+    TEST_ASSERT_EQUAL(Status_enumOk, USART_GetBaudInfo(USART1_ID, &Info));
+    TEST_ASSERT_EQUAL_INT32(1603, Info.ErrorPPM);
+
+    /* Only OVER8 reaches 10.5 Mbaud, and 9600 switches back to OVER16 */
+    TEST_ASSERT_EQUAL(Status_enumOk, USART_SetBaudRate(USART1_ID, 10500000UL));
+    TEST_ASSERT_EQUAL_HEX32(0x10, REG(USART1_BRR));
+    TEST_ASSERT_BITS_HIGH(CR1_OVER8 | CR1_UE, REG(USART1_CR1));
+    TEST_ASSERT_EQUAL(Status_enumOk, USART_SetBaudRate(USART1_ID, 9600));
+    TEST_ASSERT_EQUAL_HEX32(0x222E, REG(USART1_BRR));
+    TEST_ASSERT_BITS_LOW(CR1_OVER8, REG(USART1_CR1));
+
+    /* An unreachable rate leaves the USART as it is */
+    TEST_ASSERT_EQUAL(Status_enumWrongInput, USART_SetBaudRate(USART1_ID, 500));
+    TEST_ASSERT_EQUAL_HEX32(0x222E, REG(USART1_BRR));
+    TEST_ASSERT_EQUAL(Status_enumOk, USART_GetBaudInfo(USART1_ID, &Info));
+    TEST_ASSERT_EQUAL_UINT32(9600, Info.ActualBaudRate);
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_Sweep_ReportsTheErrorOfTheProgrammedDivider);
+    RUN_TEST(test_StandardRates_AtTheBootClock);
+    RUN_TEST(test_ForcedOverSampling_RejectsUnreachableRates);
+    RUN_TEST(test_InvalidArguments);
+    RUN_TEST(test_USARTInit_RecordsTheProgrammedBaudRate);
+    RUN_TEST(test_SetBaudRate_WaitsForTheLastFrameToLeave);
+    return UNITY_END();
+}
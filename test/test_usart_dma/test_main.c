@@ -0,0 +1,132 @@
+/*
+ ============================================================================
+ Name        : test_main.c
+ Description : Native tests for the USART DMA transmit path, checking the
+               DMA register programming against a simulated register block
+ ============================================================================
+ */
+#include <unity.h>
+#include <string.h>
+#include "LIB/Stm32F401cc.h"
+#include "MCAL/UART/USART.h"
+#include "MCAL/DMA/DMA.h"
+
+#define REG(Address) (*(volatile uint32_t *)PERIPHERAL_ADDRESS(Address))
+
+#define USART1_SR   0x40011000UL
+#define USART1_DR   0x40011004UL
+#define USART1_CR1  0x4001100CUL
+#define USART1_CR3  0x40011014UL
+#define USART2_DR   0x40004404UL
+#define USART2_CR1  0x4000440CUL
+#define DMA1_S6CR   (0x40026000UL + 0x10 + (0x18 * 6))
+#define DMA2_HISR   (0x40026400UL + 0x04)
+#define DMA2_HIFCR  (0x40026400UL + 0x0C)
+#define DMA2_S7CR   (0x40026400UL + 0x10 + (0x18 * 7))
+#define DMA2_S7NDTR (DMA2_S7CR + 0x04)
+#define DMA2_S7PAR  (DMA2_S7CR + 0x08)
+#define DMA2_S7M0AR (DMA2_S7CR + 0x0C)
+
+#define DMA_TCIF7   (1UL << 27)
+
+void DMA2_Stream7_IRQHandler(void);
+
+static uint8_t TxBuffer[5] = {1, 2, 3, 4, 5};
+static uint32_t CallBackCount;
+
+static void on_TxDone(void)
+{
+    CallBackCount++;
+}
+
+/* Hardware clears EN and raises TCIF once NDTR reaches zero */
+static void Sim_CompleteStream7(void)
+{
+    REG(DMA2_S7CR) &= ~0x1UL;
+    REG(DMA2_S7NDTR) = 0;
+    REG(DMA2_HISR) |= DMA_TCIF7;
+    DMA2_Stream7_IRQHandler();
+    REG(DMA2_HISR) &= ~DMA_TCIF7;
+}
+
+void setUp(void)
+{
+    memset(Sim_PeripheralMemory, 0, sizeof(Sim_PeripheralMemory));
+    CallBackCount = 0;
+    TEST_ASSERT_EQUAL(Status_enumOk, USART_Init());
+}
+
+void tearDown(void)
+{
+    /* Release a transfer left running by the test */
+    if (REG(DMA2_S7CR) & 0x1UL)
+    {
+        Sim_CompleteStream7();
+    }
+}
+
+void test_Init_ProgramsUSART1TxStream(void)
+{
+    /* CHSEL=4, PL=medium, MINC, DIR=memory-to-peripheral, TCIE, TEIE, stream disabled */
+    TEST_ASSERT_EQUAL_HEX32(0x08010454UL, REG(DMA2_S7CR));
+    TEST_ASSERT_BITS_HIGH(0x80UL, REG(USART1_CR3));
+}
+
+void test_Init_LeavesInterruptModeUSARTWithoutDMA(void)
+{
+    TEST_ASSERT_EQUAL_HEX32(0, REG(DMA1_S6CR));
+}
+
+void test_TxBuffer_StartsStreamOnce(void)
+{
+    USART_UserReq_t Req = {.USART_ID = USART1_ID, .Ptr_buffer = TxBuffer, .Buff_Len = sizeof(TxBuffer), .Buff_cb = on_TxDone};
+
+    TEST_ASSERT_EQUAL(Status_enumOk, USART_TxBufferAsyncZeroCopy(&Req));
+
+    TEST_ASSERT_EQUAL_UINT32(sizeof(TxBuffer), REG(DMA2_S7NDTR));
+    TEST_ASSERT_EQUAL_HEX32((uint32_t)(uintptr_t)PERIPHERAL_ADDRESS(USART1_DR), REG(DMA2_S7PAR));
+    TEST_ASSERT_EQUAL_HEX32((uint32_t)(uintptr_t)TxBuffer, REG(DMA2_S7M0AR));
+    TEST_ASSERT_BITS_HIGH(0x1UL, REG(DMA2_S7CR));
+    TEST_ASSERT_BITS_HIGH(0x8UL, REG(USART1_CR1));
+    /* No TXE interrupt and no byte written by the CPU */
+    TEST_ASSERT_BITS_LOW(0x80UL, REG(USART1_CR1));
+    TEST_ASSERT_EQUAL_HEX32(0, REG(USART1_DR));
+    /* A second request while the stream runs is refused */
+    TEST_ASSERT_EQUAL(Status_enumBusyState, USART_TxBufferAsyncZeroCopy(&Req));
+}
+
+void test_TransferComplete_CallsCallBackOncePerBuffer(void)
+{
+    USART_UserReq_t Req = {.USART_ID = USART1_ID, .Ptr_buffer = TxBuffer, .Buff_Len = sizeof(TxBuffer), .Buff_cb = on_TxDone};
+
+    TEST_ASSERT_EQUAL(Status_enumOk, USART_TxBufferAsyncZeroCopy(&Req));
+    Sim_CompleteStream7();
+
+    TEST_ASSERT_EQUAL_UINT32(1, CallBackCount);
+    TEST_ASSERT_EQUAL_HEX32(DMA_TCIF7, REG(DMA2_HIFCR) & DMA_TCIF7);
+    /* The request is released and the next buffer can go */
+    TEST_ASSERT_EQUAL(Status_enumOk, USART_TxBufferAsyncZeroCopy(&Req));
+    Sim_CompleteStream7();
+    TEST_ASSERT_EQUAL_UINT32(2, CallBackCount);
+}
+
+void test_InterruptMode_StillUsesTXE(void)
+{
+    USART_UserReq_t Req = {.USART_ID = USART2_ID, .Ptr_buffer = TxBuffer, .Buff_Len = sizeof(TxBuffer), .Buff_cb = on_TxDone};
+
+    TEST_ASSERT_EQUAL(Status_enumOk, USART_TxBufferAsyncZeroCopy(&Req));
+
+    TEST_ASSERT_EQUAL_HEX32(TxBuffer[0], REG(USART2_DR));
+    TEST_ASSERT_BITS_HIGH(0x80UL, REG(USART2_CR1));
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_Init_ProgramsUSART1TxStream);
+    RUN_TEST(test_Init_LeavesInterruptModeUSARTWithoutDMA);
+    RUN_TEST(test_TxBuffer_StartsStreamOnce);
+    RUN_TEST(test_TransferComplete_CallsCallBackOncePerBuffer);
+    RUN_TEST(test_InterruptMode_StillUsesTXE);
+    return UNITY_END();
+}
@@ -0,0 +1,199 @@
+/*
+ ============================================================================
+ Name        : test_main.c
+ Description : Native tests for the USART continuous receive path, checking
+               the circular DMA programming and the delivered byte runs
+               against a simulated register block
+ ============================================================================
+ */
+#include <unity.h>
+#include <string.h>
+#include "LIB/Stm32F401cc.h"
+#include "MCAL/UART/USART.h"
+#include "MCAL/DMA/DMA.h"
+
+#define REG(Address) (*(volatile uint32_t *)PERIPHERAL_ADDRESS(Address))
+
+#define USART1_SR   0x40011000UL
+#define USART1_CR1  0x4001100CUL
+#define USART1_CR3  0x40011014UL
+#define USART2_SR   0x40004400UL
+#define USART2_DR   0x40004404UL
+#define USART2_CR1  0x4000440CUL
+#define DMA2_HISR   (0x40026400UL + 0x04)
+#define DMA2_S5CR   (0x40026400UL + 0x10 + (0x18 * 5))
+#define DMA2_S5NDTR (DMA2_S5CR + 0x04)
+#define DMA2_S5M0AR (DMA2_S5CR + 0x0C)
+
+#define USART_SR_RXNE 0x20UL
+#define USART_SR_IDLE 0x10UL
+#define DMA_HTIF5   (1UL << 10)
+#define DMA_TCIF5   (1UL << 11)
+
+#define RING_LEN    16
+
+void USART1_IRQHandler(void);
+void USART2_IRQHandler(void);
+void DMA2_Stream5_IRQHandler(void);
+
+static uint8_t Ring[RING_LEN];
+static uint8_t Delivered[64];
+static uint32_t DeliveredLen;
+static uint32_t RunCount;
+
+static void on_Run(const uint8_t *Ptr_Data, uint32_t Len)
+{
+    memcpy(&Delivered[DeliveredLen], Ptr_Data, Len);
+    DeliveredLen += Len;
+    RunCount++;
+}
+
+/* Write Count bytes the way the circular DMA stream does, starting at *Pos */
+static void Sim_DMAReceive(uint32_t *Pos, const uint8_t *Bytes, uint32_t Count)
+{
+    for (uint32_t i = 0; i < Count; i++)
+    {
+        Ring[*Pos] = Bytes[i];
+        *Pos = (*Pos + 1) % RING_LEN;
+    }
+    REG(DMA2_S5NDTR) = RING_LEN - *Pos;
+}
+
+static void Sim_DMAEvent(uint32_t Flag)
+{
+    REG(DMA2_HISR) |= Flag;
+    DMA2_Stream5_IRQHandler();
+    REG(DMA2_HISR) &= ~Flag;
+}
+
+static void Sim_Idle(uint32_t SR, void (*Handler)(void))
+{
+    REG(SR) |= USART_SR_IDLE;
+    Handler();
+    REG(SR) &= ~USART_SR_IDLE;
+}
+
+void setUp(void)
+{
+    memset(Sim_PeripheralMemory, 0, sizeof(Sim_PeripheralMemory));
+    memset(Ring, 0, sizeof(Ring));
+    DeliveredLen = 0;
+    RunCount = 0;
+    TEST_ASSERT_EQUAL(Status_enumOk, USART_Init());
+}
+
+void tearDown(void)
+{
+    USART_RxStreamStop(USART1_ID);
+    USART_RxStreamStop(USART2_ID);
+}
+
+void test_Start_ProgramsCircularRxStream(void)
+{
+    USART_RxStreamReq_t Req = {.USART_ID = USART1_ID, .Ptr_buffer = Ring, .Buff_Len = RING_LEN, .Run_cb = on_Run};
+
+    TEST_ASSERT_EQUAL(Status_enumOk, USART_RxStreamStart(&Req));
+    /* CHSEL=4, PL=high, MINC, CIRC, DIR=peripheral-to-memory, HTIE, TCIE, TEIE, EN */
+    TEST_ASSERT_EQUAL_HEX32(0x0802051DUL, REG(DMA2_S5CR));
+    TEST_ASSERT_EQUAL_UINT32(RING_LEN, REG(DMA2_S5NDTR));
+    TEST_ASSERT_BITS_HIGH(0x40UL, REG(USART1_CR3));
+    /* IDLEIE and RE set, RXNEIE left off */
+    TEST_ASSERT_BITS_HIGH(0x14UL, REG(USART1_CR1));
+    TEST_ASSERT_BITS_LOW(0x20UL, REG(USART1_CR1));
+    TEST_ASSERT_EQUAL(Status_enumBusyState, USART_RxStreamStart(&Req));
+}
+
+void test_Idle_DeliversShortRunWithoutStopping(void)
+{
+    USART_RxStreamReq_t Req = {.USART_ID = USART1_ID, .Ptr_buffer = Ring, .Buff_Len = RING_LEN, .Run_cb = on_Run};
+    const uint8_t First[] = {1, 2, 3};
+    const uint8_t Second[] = {4, 5};
+    uint32_t Pos = 0;
+
+    USART_RxStreamStart(&Req);
+    Sim_DMAReceive(&Pos, First, sizeof(First));
+    Sim_Idle(USART1_SR, USART1_IRQHandler);
+    Sim_DMAReceive(&Pos, Second, sizeof(Second));
+    Sim_Idle(USART1_SR, USART1_IRQHandler);
+
+    TEST_ASSERT_EQUAL_UINT32(2, RunCount);
+    TEST_ASSERT_EQUAL_UINT32(5, DeliveredLen);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(((const uint8_t[]){1, 2, 3, 4, 5}), Delivered, 5);
+    /* The stream is never stopped between runs */
+    TEST_ASSERT_BITS_HIGH(0x1UL, REG(DMA2_S5CR));
+}
+
+void test_HalfAndFullTransfer_DeliverAcrossWrapAround(void)
+{
+    USART_RxStreamReq_t Req = {.USART_ID = USART1_ID, .Ptr_buffer = Ring, .Buff_Len = RING_LEN, .Run_cb = on_Run};
+    uint8_t Bytes[24];
+    uint32_t Pos = 0;
+
+    for (uint32_t i = 0; i < sizeof(Bytes); i++)
+    {
+        Bytes[i] = (uint8_t)(0x40 + i);
+    }
+    USART_RxStreamStart(&Req);
+    Sim_DMAReceive(&Pos, Bytes, RING_LEN / 2);
+    Sim_DMAEvent(DMA_HTIF5);
+    Sim_DMAReceive(&Pos, &Bytes[RING_LEN / 2], RING_LEN / 2);
+    Sim_DMAEvent(DMA_TCIF5);
+    Sim_DMAReceive(&Pos, &Bytes[RING_LEN], sizeof(Bytes) - RING_LEN);
+    Sim_Idle(USART1_SR, USART1_IRQHandler);
+
+    TEST_ASSERT_EQUAL_UINT32(sizeof(Bytes), DeliveredLen);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(Bytes, Delivered, sizeof(Bytes));
+}
+
+void test_Idle_SplitsRunThatWrapsTheBuffer(void)
+{
+    USART_RxStreamReq_t Req = {.USART_ID = USART1_ID, .Ptr_buffer = Ring, .Buff_Len = RING_LEN, .Run_cb = on_Run};
+    uint8_t Bytes[RING_LEN - 2 + 6];
+    uint32_t Pos = 0;
+
+    for (uint32_t i = 0; i < sizeof(Bytes); i++)
+    {
+        Bytes[i] = (uint8_t)i;
+    }
+    USART_RxStreamStart(&Req);
+    Sim_DMAReceive(&Pos, Bytes, RING_LEN - 2);
+    Sim_Idle(USART1_SR, USART1_IRQHandler);
+    Sim_DMAReceive(&Pos, &Bytes[RING_LEN - 2], 6);
+    Sim_Idle(USART1_SR, USART1_IRQHandler);
+
+    /* One run before the wrap, then the tail and head parts of the second run */
+    TEST_ASSERT_EQUAL_UINT32(3, RunCount);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(Bytes, Delivered, sizeof(Bytes));
+}
+
+void test_InterruptMode_DeliversOnIdle(void)
+{
+    USART_RxStreamReq_t Req = {.USART_ID = USART2_ID, .Ptr_buffer = Ring, .Buff_Len = RING_LEN, .Run_cb = on_Run};
+    const uint8_t Bytes[] = {0xA1, 0xB2, 0xC3};
+
+    TEST_ASSERT_EQUAL(Status_enumOk, USART_RxStreamStart(&Req));
+    TEST_ASSERT_BITS_HIGH(0x34UL, REG(USART2_CR1));
+    for (uint32_t i = 0; i < sizeof(Bytes); i++)
+    {
+        REG(USART2_DR) = Bytes[i];
+        REG(USART2_SR) |= USART_SR_RXNE;
+        USART2_IRQHandler();
+        REG(USART2_SR) &= ~USART_SR_RXNE;
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, RunCount);
+    Sim_Idle(USART2_SR, USART2_IRQHandler);
+
+    TEST_ASSERT_EQUAL_UINT32(1, RunCount);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(Bytes, Delivered, sizeof(Bytes));
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_Start_ProgramsCircularRxStream);
+    RUN_TEST(test_Idle_DeliversShortRunWithoutStopping);
+    RUN_TEST(test_HalfAndFullTransfer_DeliverAcrossWrapAround);
+    RUN_TEST(test_Idle_SplitsRunThatWrapsTheBuffer);
+    RUN_TEST(test_InterruptMode_DeliversOnIdle);
+    return UNITY_END();
+}